@@ -0,0 +1,73 @@
+///plane_accuracy_apfloat: the accuracy of the apfloat Plane.
+///
+///  plane_accuracy_apfloat [--planes N] [--points N] [--bits N] [--seed N]
+///
+///Writes the same table as plane_benchmark --accuracy, on the same sets
+///for the same arguments, for the apfloat Plane with the coordinats at the
+///precision of a double and at 40 digits, and for PlaneInt, which is exact.
+///Plane_apfloat defines the same classes as Plane, so it needs a program
+///of its own. Comparing the two tables shows at which magnitudes the
+///double Plane mismatches where the apfloat Plane does not
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "planeaccuracy.h"
+
+namespace ribi {
+
+static void ShowUsage(std::ostream& os)
+{
+  os << "Usage: plane_accuracy_apfloat [--planes N] [--points N] [--bits N] [--seed N]\n";
+}
+
+static int RunAccuracyApfloat(const std::vector<std::string>& args)
+{
+  int n_planes{100};
+  int n_points{1000};
+  int coordinat_bits{32};
+  std::uint32_t seed{42};
+  for (std::size_t i=0; i!=args.size(); ++i)
+  {
+    if (i + 1 == args.size())
+    {
+      ShowUsage(std::cerr);
+      return 1;
+    }
+    const int value{std::stoi(args[i + 1])};
+    if (value < 0) throw std::invalid_argument("'" + args[i + 1] + "' is a negative number");
+    if (args[i] == "--planes") n_planes = value;
+    else if (args[i] == "--points") n_points = value;
+    else if (args[i] == "--bits") coordinat_bits = value;
+    else if (args[i] == "--seed") seed = static_cast<std::uint32_t>(value);
+    else
+    {
+      ShowUsage(std::cerr);
+      return 1;
+    }
+    ++i;
+  }
+  WritePlaneAccuracy(
+    std::cout,
+    MeasurePlaneAccuracySeries(GetPlaneAccuracyBackends(),n_planes,n_points,coordinat_bits,seed)
+  );
+  return 0;
+}
+
+} //~namespace ribi
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    return ribi::RunAccuracyApfloat(std::vector<std::string>(argv + 1,argv + argc));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "plane_accuracy_apfloat: " << e.what() << '\n';
+    return 1;
+  }
+}
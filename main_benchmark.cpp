@@ -0,0 +1,890 @@
+///plane_benchmark: measure the plane kernels, per processed point.
+///
+///  plane_benchmark [--points N] [--repeats N]
+///
+///For each kernel, writes the wall-clock time, and if the hardware counters
+///are available, the cycles, instructions, instructions per cycle, L1 data
+///and last level cache misses and branch misses, all per point.
+///Counters that are unavailable, for example due to perf_event_paranoid,
+///are written as 'n/a'
+///
+///  plane_benchmark --sweep [--min-points N] [--max-points N] [--max-threads N] [--memory-budget MiB]
+///
+///For the batch kernels and plane construction, writes the throughput and
+///parallel efficiency for each number of points, in powers of ten from
+///min-points (default 1e3) to max-points (default 1e9, and 1e7 for plane
+///construction), and each number of threads, in powers of two up to
+///max-threads (default the number of cores).
+///Parallel efficiency is the throughput divided by that of one thread
+///times the number of threads. Every point is a different point of
+///a point cloud, in a buffer of the thread that processes it, up to
+///the memory budget (default 1024 MiB). Beyond that, each thread streams
+///over its buffer again, so a sweep up to 1e9 points does not need 24 GB
+///of points. Each row writes the size of the working set and if it fits
+///in the last level cache
+///
+///  plane_benchmark --accuracy [--planes N] [--points N] [--bits N] [--seed N]
+///
+///For each magnitude of GetPlaneAccuracySeries, creates randomized and
+///adversarial planes with points (default 100 planes of 1000 points, of
+///about 32 bits), and writes the mismatches of each backend with the exact
+///answer, and its throughput. plane_accuracy_apfloat does the same for the
+///apfloat Plane
+///
+///  plane_benchmark --allocations [--calls N]
+///
+///For each public function of Plane, PlaneX, PlaneY and PlaneZ, writes the
+///allocations and bytes allocated per call
+///
+///  plane_benchmark --construction [--planes N] [--seed N]
+///
+///For each category of three points (random, axis-aligned, nearly
+///degenerate, collinear, and a mix as found in mesh imports), writes the
+///time to construct a Plane, the exceptions thrown and caught per Plane,
+///and the share of Planes that could not be expressed in X, Y or Z,
+///which is when CreatePlaneX, CreatePlaneY or CreatePlaneZ threw
+///
+///  plane_benchmark --memory
+///
+///For each representation of a plane, writes its shallow size (sizeof),
+///its deep size (including the heap memory it owns), the number of heap
+///blocks it owns, which each add the overhead of the allocator, and the
+///deep size of ten million of them
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "plane.h"
+#include "planeaccuracy.h"
+#include "planeallocations.h"
+#include "planecounters.h"
+#include "planefile.h"
+#include "planeint.h"
+#include "planeperf.h"
+#include "planepointcloud.h"
+#include "planez.h"
+
+namespace ribi {
+
+///A kernel: a function processing all points
+struct BenchmarkKernel
+{
+  std::string m_name;
+  std::function<void()> m_function;
+};
+
+///Points near the plane z = (0.2*x) + (0.3*y) + 5, on a raster
+static Plane::Coordinats3D CreateBenchmarkPoints(const int n)
+{
+  Plane::Coordinats3D points;
+  points.reserve(n);
+  for (int i=0; i!=n; ++i)
+  {
+    const double x{static_cast<double>(i % 1000) * 0.01};
+    const double y{static_cast<double>(i / 1000) * 0.01};
+    const double noise{(i % 3 == 0) ? 1.0e-3 : 0.0};
+    points.push_back(Plane::Coordinat3D(x,y,(0.2 * x) + (0.3 * y) + 5.0 + noise));
+  }
+  return points;
+}
+
+static void WritePerPoint(std::ostream& os, const PlanePerfSample& sample, const PlanePerfEvent event, const double n_points)
+{
+  os << std::setw(12);
+  if (sample.IsAvailable(event)) os << (sample.Get(event) / n_points);
+  else os << "n/a";
+}
+
+///A batch kernel of the sweep: processes a chunk of points,
+///returns a value to sum, so the kernel is not optimized away
+struct SweepKernel
+{
+  std::string m_name;
+  std::function<double(const Plane&, const Plane::Coordinats3D&)> m_function;
+
+  ///The largest number of points if none is given
+  std::int64_t m_default_max_points;
+};
+
+///The points of one thread of the sweep. The thread processes all chunks
+///m_n_cycles times, then the first m_n_tail_chunks chunks and the tail
+struct SweepBuffer
+{
+  std::vector<Plane::Coordinats3D> m_chunks;
+  std::int64_t m_n_cycles;
+  std::size_t m_n_tail_chunks;
+  Plane::Coordinats3D m_tail;
+};
+
+///The points processed by the kernels of the sweep
+static PlanePointCloudConfig CreateSweepConfig()
+{
+  PlanePointCloudConfig config;
+  config.m_n_planes = 1;
+  config.m_noise = 1.0e-12;
+  return config;
+}
+
+///The size of the largest cache of the first core in bytes, 0 if unknown
+static std::int64_t GetLastLevelCacheSize()
+{
+  std::int64_t size{0};
+  for (int i=0; ; ++i)
+  {
+    std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(i) + "/size");
+    if (!f) break;
+    std::int64_t value{0};
+    char unit{'\0'};
+    f >> value >> unit;
+    if (unit == 'K') value *= 1024;
+    else if (unit == 'M') value *= 1024 * 1024;
+    size = std::max(size,value);
+  }
+  return size;
+}
+
+///The buffer of thread t, which processes share points, of which the
+///first n_distinct are different points of the point cloud, starting at
+///first_point
+static SweepBuffer CreateSweepBuffer(
+  const PlanePointCloudConfig& config,
+  const std::vector<PlanePointCloudPlane>& planes,
+  const std::int64_t first_point,
+  const std::int64_t n_distinct,
+  const std::int64_t share
+)
+{
+  const std::int64_t chunk_size{1 << 16};
+  SweepBuffer buffer;
+  std::vector<double> x(chunk_size);
+  std::vector<double> y(chunk_size);
+  std::vector<double> z(chunk_size);
+  for (std::int64_t i=0; i < n_distinct; i += chunk_size)
+  {
+    const std::int64_t n{std::min(chunk_size,n_distinct - i)};
+    GeneratePointCloud(config,planes,first_point + i,n,x.data(),y.data(),z.data(),nullptr,1);
+    Plane::Coordinats3D chunk;
+    chunk.reserve(n);
+    for (std::int64_t j=0; j!=n; ++j) chunk.push_back(Plane::Coordinat3D(x[j],y[j],z[j]));
+    buffer.m_chunks.push_back(chunk);
+  }
+  buffer.m_n_cycles = n_distinct == 0 ? 0 : share / n_distinct;
+  buffer.m_n_tail_chunks = 0;
+  std::int64_t n_left{n_distinct == 0 ? 0 : share % n_distinct};
+  while (n_left != 0 && n_left >= static_cast<std::int64_t>(buffer.m_chunks[buffer.m_n_tail_chunks].size()))
+  {
+    n_left -= buffer.m_chunks[buffer.m_n_tail_chunks].size();
+    ++buffer.m_n_tail_chunks;
+  }
+  if (n_left != 0)
+  {
+    const auto& chunk = buffer.m_chunks[buffer.m_n_tail_chunks];
+    buffer.m_tail.assign(chunk.begin(),chunk.begin() + n_left);
+  }
+  return buffer;
+}
+
+///The seconds to process the number of points with the number of threads,
+///each processing an equal share of the points, of which at most
+///max_distinct are different. The calling thread is one of the threads.
+///Excludes starting and joining the threads
+static double MeasureSweep(
+  const SweepKernel& kernel,
+  const Plane& plane,
+  const PlanePointCloudConfig& config,
+  const std::vector<PlanePointCloudPlane>& planes,
+  const std::int64_t n_points,
+  const std::int64_t max_distinct,
+  const int n_threads
+)
+{
+  //Each thread first creates its buffer, so that the memory is close to
+  //the core that uses it, then waits to be released. Only the work is
+  //timed, not starting and joining the threads
+  std::vector<SweepBuffer> buffers(n_threads);
+  std::vector<double> sums(n_threads,0.0);
+  const std::int64_t n_distinct{std::min(n_points,max_distinct)};
+  std::atomic<int> n_ready{0};
+  std::atomic<bool> is_released{false};
+  std::atomic<int> n_done{0};
+  const auto create = [&](const int t)
+  {
+    const std::int64_t first{t * n_distinct / n_threads};
+    buffers[t] = CreateSweepBuffer(
+      config,
+      planes,
+      first,
+      ((t + 1) * n_distinct / n_threads) - first,
+      ((t + 1) * n_points / n_threads) - (t * n_points / n_threads)
+    );
+  };
+  const auto run = [&](const int t)
+  {
+    const SweepBuffer& buffer = buffers[t];
+    double sum{0.0};
+    for (std::int64_t i=0; i!=buffer.m_n_cycles; ++i)
+    {
+      for (const auto& chunk: buffer.m_chunks) sum += kernel.m_function(plane,chunk);
+    }
+    for (std::size_t i=0; i!=buffer.m_n_tail_chunks; ++i) sum += kernel.m_function(plane,buffer.m_chunks[i]);
+    if (!buffer.m_tail.empty()) sum += kernel.m_function(plane,buffer.m_tail);
+    sums[t] = sum;
+  };
+  const auto work = [&](const int t)
+  {
+    create(t);
+    ++n_ready;
+    while (!is_released.load(std::memory_order_acquire)) std::this_thread::yield();
+    run(t);
+    n_done.fetch_add(1,std::memory_order_release);
+  };
+  std::vector<std::thread> threads;
+  for (int t=1; t<n_threads; ++t) threads.emplace_back(work,t);
+  create(0);
+  while (n_ready.load() != n_threads - 1) std::this_thread::yield();
+  const auto start = std::chrono::steady_clock::now();
+  is_released.store(true,std::memory_order_release);
+  run(0);
+  while (n_done.load(std::memory_order_acquire) != n_threads - 1) std::this_thread::yield();
+  const auto stop = std::chrono::steady_clock::now();
+  for (auto& thread: threads) thread.join();
+  volatile double sink{0.0};
+  for (const double sum: sums) sink = sink + sum;
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+///Sweep up to max_points points, or to the default of each kernel if max_points is zero
+static int RunSweep(
+  const std::int64_t min_points,
+  const std::int64_t max_points,
+  const int max_threads,
+  const std::int64_t memory_budget_mib
+)
+{
+  const PlanePointCloudConfig config{CreateSweepConfig()};
+  const std::vector<PlanePointCloudPlane> planes{CreatePointCloudPlanes(config)};
+  const std::array<Plane::Coordinat3D,3> plane_points{planes[0].GetPoints()};
+  const Plane plane(plane_points[0],plane_points[1],plane_points[2]);
+  const std::int64_t bytes_per_point{static_cast<std::int64_t>(sizeof(Plane::Coordinat3D))};
+  const std::int64_t max_distinct{
+    std::max(std::int64_t(1),memory_budget_mib * 1024 * 1024 / bytes_per_point)
+  };
+  const std::int64_t cache_size{GetLastLevelCacheSize()};
+  const std::vector<SweepKernel> kernels{
+    { "IsInPlane", [](const Plane& p, const Plane::Coordinats3D& v)
+      {
+        return static_cast<double>(p.IsInPlane(v).size());
+      },
+      1000000000
+    },
+    { "CalcError", [](const Plane& p, const Plane::Coordinats3D& v)
+      {
+        return p.CalcError(v).back();
+      },
+      1000000000
+    },
+    { "CalcProjection", [](const Plane& p, const Plane::Coordinats3D& v)
+      {
+        return boost::geometry::get<0>(p.CalcProjection(v).back());
+      },
+      1000000000
+    },
+    //One plane per point, from that point and the two after it.
+    //This takes microseconds per point, so 1e9 points would take hours
+    { "Plane construction", [](const Plane&, const Plane::Coordinats3D& v)
+      {
+        double sum{0.0};
+        const std::size_t n{v.size()};
+        for (std::size_t i=0; i!=n; ++i)
+        {
+          const Plane p(v[i],v[(i + 1) % n],v[(i + 2) % n]);
+          sum += p.CanCalcZ();
+        }
+        return sum;
+      },
+      10000000
+    }
+  };
+  std::vector<int> thread_counts;
+  for (int t=1; t < max_threads; t *= 2) thread_counts.push_back(t);
+  thread_counts.push_back(max_threads);
+
+  if (cache_size > 0)
+  {
+    std::cout << "Last level cache: " << (cache_size / 1024) << " KiB\n";
+  }
+  else
+  {
+    std::cout << "Last level cache: unknown\n";
+  }
+  std::cout
+    << std::left << std::setw(20) << "kernel" << std::right
+    << std::setw(14) << "points"
+    << std::setw(9) << "threads"
+    << std::setw(12) << "set (MiB)"
+    << std::setw(9) << "in LLC"
+    << std::setw(12) << "seconds"
+    << std::setw(14) << "Mpoints/s"
+    << std::setw(12) << "efficiency"
+    << '\n'
+  ;
+  for (const auto& kernel: kernels)
+  {
+    const std::int64_t kernel_max_points{max_points == 0 ? kernel.m_default_max_points : max_points};
+    for (std::int64_t n_points=min_points; n_points<=kernel_max_points; n_points *= 10)
+    {
+      //The bytes of different points all threads together process
+      const std::int64_t working_set{std::min(n_points,max_distinct) * bytes_per_point};
+      double throughput_one_thread{0.0};
+      for (const int n_threads: thread_counts)
+      {
+        const double seconds{MeasureSweep(kernel,plane,config,planes,n_points,max_distinct,n_threads)};
+        const double throughput{seconds > 0.0 ? static_cast<double>(n_points) / seconds : 0.0};
+        if (n_threads == 1) throughput_one_thread = throughput;
+        std::cout
+          << std::left << std::setw(20) << kernel.m_name << std::right
+          << std::setw(14) << n_points
+          << std::setw(9) << n_threads
+          << std::setprecision(4)
+          << std::setw(12) << (static_cast<double>(working_set) / (1024.0 * 1024.0))
+          << std::setw(9) << (cache_size == 0 ? "?" : working_set <= cache_size ? "yes" : "no")
+          << std::setw(12) << seconds
+          << std::setw(14) << (throughput * 1.0e-6)
+          << std::setw(12)
+          << (throughput_one_thread > 0.0 ? throughput / (throughput_one_thread * n_threads) : 0.0)
+          << std::endl
+        ;
+      }
+      if (n_points > kernel_max_points / 10) break;
+    }
+  }
+  return 0;
+}
+
+static int RunAccuracy(
+  const int n_planes,
+  const int n_points,
+  const int coordinat_bits,
+  const std::uint32_t seed
+)
+{
+  WritePlaneAccuracy(
+    std::cout,
+    MeasurePlaneAccuracySeries(GetPlaneAccuracyBackends(),n_planes,n_points,coordinat_bits,seed)
+  );
+  return 0;
+}
+
+///Three points to construct a Plane from, of one category
+struct ConstructionFixture
+{
+  std::string m_name;
+  std::vector<std::array<Plane::Coordinat3D,3>> m_triplets;
+};
+
+///n triplets of each category, and a mix of these
+static std::vector<ConstructionFixture> CreateConstructionFixtures(
+  const int n,
+  const std::uint32_t seed
+)
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> d(-100.0,100.0);
+  const auto random_point = [&]()
+  {
+    const double x{d(engine)};
+    const double y{d(engine)};
+    const double z{d(engine)};
+    return Coordinat3D(x,y,z);
+  };
+  std::vector<ConstructionFixture> v(4);
+  v[0].m_name = "random";
+  v[1].m_name = "axis-aligned";
+  v[2].m_name = "nearly degenerate";
+  v[3].m_name = "collinear";
+  for (int i=0; i!=n; ++i)
+  {
+    v[0].m_triplets.push_back({random_point(),random_point(),random_point()});
+
+    //Planes x = c, y = c and z = c in turn
+    {
+      std::array<Coordinat3D,3> t{random_point(),random_point(),random_point()};
+      const double c{d(engine)};
+      for (auto& p: t)
+      {
+        switch (i % 3)
+        {
+          case 0: boost::geometry::set<0>(p,c); break;
+          case 1: boost::geometry::set<1>(p,c); break;
+          default: boost::geometry::set<2>(p,c); break;
+        }
+      }
+      v[1].m_triplets.push_back(t);
+    }
+
+    //The third point one part in a billion away from the line of the other two
+    {
+      const Coordinat3D p1{random_point()};
+      const Coordinat3D p2{random_point()};
+      const Coordinat3D p3(
+        (boost::geometry::get<0>(p1) + boost::geometry::get<0>(p2)) * 0.5,
+        (boost::geometry::get<1>(p1) + boost::geometry::get<1>(p2)) * 0.5,
+        ((boost::geometry::get<2>(p1) + boost::geometry::get<2>(p2)) * 0.5) + 1.0e-7
+      );
+      v[2].m_triplets.push_back({p1,p2,p3});
+    }
+
+    //The third point at twice the distance of the second, which is exact
+    {
+      const Coordinat3D p1{random_point()};
+      const Coordinat3D p2(
+        boost::geometry::get<0>(p1) + 1.0,
+        boost::geometry::get<1>(p1) + 2.0,
+        boost::geometry::get<2>(p1) + 4.0
+      );
+      const Coordinat3D p3(
+        boost::geometry::get<0>(p1) + 2.0,
+        boost::geometry::get<1>(p1) + 4.0,
+        boost::geometry::get<2>(p1) + 8.0
+      );
+      v[3].m_triplets.push_back({p1,p2,p3});
+    }
+  }
+
+  //A mesh import: mostly random faces, many axis-aligned walls and floors,
+  //some slivers and a few collapsed faces
+  ConstructionFixture mix;
+  mix.m_name = "mix 70/20/8/2";
+  std::uniform_int_distribution<int> percentage(0,99);
+  for (int i=0; i!=n; ++i)
+  {
+    const int r{percentage(engine)};
+    const std::size_t category{r < 70 ? 0u : r < 90 ? 1u : r < 98 ? 2u : 3u};
+    mix.m_triplets.push_back(v[category].m_triplets[i]);
+  }
+  v.push_back(mix);
+  return v;
+}
+
+static int RunConstruction(const int n_planes, const std::uint32_t seed)
+{
+  const std::vector<ConstructionFixture> fixtures{CreateConstructionFixtures(n_planes,seed)};
+  //Results are summed into this, so the constructions are not optimized away
+  volatile int sink{0};
+  std::cout
+    << std::left << std::setw(20) << "fixture" << std::right
+    << std::setw(10) << "planes"
+    << std::setw(12) << "ns/plane"
+    << std::setw(14) << "exceptions"
+    << std::setw(20) << "planes with throw"
+    << '\n'
+  ;
+  for (const auto& fixture: fixtures)
+  {
+    //Once to warm up, once to measure
+    int n_with_throw{0};
+    PlaneCounterSnapshot before;
+    std::chrono::steady_clock::time_point start;
+    for (int i=0; i!=2; ++i)
+    {
+      n_with_throw = 0;
+      before = GetPlaneCounters();
+      start = std::chrono::steady_clock::now();
+      for (const auto& t: fixture.m_triplets)
+      {
+        const Plane plane(t[0],t[1],t[2]);
+        n_with_throw += !plane.CanCalcX() || !plane.CanCalcY() || !plane.CanCalcZ();
+      }
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const PlaneCounterSnapshot after{GetPlaneCounters()};
+    sink = sink + n_with_throw;
+    const double n{static_cast<double>(fixture.m_triplets.size())};
+    const double seconds{std::chrono::duration<double>(stop - start).count()};
+    std::cout
+      << std::left << std::setw(20) << fixture.m_name << std::right
+      << std::setw(10) << fixture.m_triplets.size()
+      << std::setprecision(4)
+      << std::setw(12) << (seconds * 1.0e9 / n)
+      << std::setw(14);
+    #ifdef RIBI_PLANE_NO_COUNTERS
+    std::cout << "n/a";
+    static_cast<void>(before);
+    static_cast<void>(after);
+    #else
+    std::cout << (static_cast<double>(
+        after.Get(PlaneCounter::exceptions_caught) - before.Get(PlaneCounter::exceptions_caught)
+      ) / n);
+    #endif
+    std::cout
+      << std::setw(19) << (100.0 * static_cast<double>(n_with_throw) / n) << '%'
+      << std::endl
+    ;
+  }
+  return 0;
+}
+
+///The memory use of one plane representation
+struct MemoryUse
+{
+  std::string m_name;
+  std::size_t m_shallow;
+  std::size_t m_deep;
+
+  ///Heap blocks owned, -1 if allocations are not counted
+  std::int64_t m_n_blocks;
+};
+
+///The memory use of a representation created on the heap by create,
+///of which deep returns the deep size
+template <class T>
+static MemoryUse MeasureMemoryUse(
+  const std::string& name,
+  const std::function<std::unique_ptr<T>()>& create,
+  const std::function<std::size_t(const T&)>& deep
+)
+{
+  //Once first, so that one-time allocations, such as those of the
+  //counters of the thread, are not counted
+  std::unique_ptr<T> p{create()};
+  p.reset();
+  const PlaneAllocations a{CountPlaneAllocations([&]() { p = create(); })};
+  return MemoryUse{
+    name,
+    sizeof(T),
+    deep(*p),
+    //Excluding the block of the representation itself, which is owned by p
+    IsCountingPlaneAllocations() ? a.m_n_allocations - a.m_n_deallocations - 1 : -1
+  };
+}
+
+static int RunMemory()
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  const Coordinat3D p1(1.0,2.0,3.0);
+  const Coordinat3D p2(4.0,6.0,9.0);
+  const Coordinat3D p3(2.0,9.0,7.0);
+  const std::vector<MemoryUse> v{
+    MeasureMemoryUse<Plane>("Plane, tilted",
+      [&]() { return std::make_unique<Plane>(p1,p2,p3); },
+      [](const Plane& p) { return p.CalcMemoryUse(); }
+    ),
+    MeasureMemoryUse<Plane>("Plane, horizontal",
+      [&]() { return std::make_unique<Plane>(Coordinat3D(0,0,1),Coordinat3D(1,0,1),Coordinat3D(0,1,1)); },
+      [](const Plane& p) { return p.CalcMemoryUse(); }
+    ),
+    MeasureMemoryUse<Plane>("Plane, vertical",
+      [&]() { return std::make_unique<Plane>(Coordinat3D(0,0,0),Coordinat3D(1,1,0),Coordinat3D(0,0,1)); },
+      [](const Plane& p) { return p.CalcMemoryUse(); }
+    ),
+    MeasureMemoryUse<PlaneX>("PlaneX",
+      [&]() { return std::make_unique<PlaneX>(p1,p2,p3); },
+      [](const PlaneX& p) { return p.CalcMemoryUse(); }
+    ),
+    MeasureMemoryUse<PlaneY>("PlaneY",
+      [&]() { return std::make_unique<PlaneY>(p1,p2,p3); },
+      [](const PlaneY& p) { return p.CalcMemoryUse(); }
+    ),
+    MeasureMemoryUse<PlaneZ>("PlaneZ",
+      [&]() { return std::make_unique<PlaneZ>(p1,p2,p3); },
+      [](const PlaneZ& p) { return p.CalcMemoryUse(); }
+    ),
+    MeasureMemoryUse<PlaneInt>("PlaneInt",
+      []()
+      {
+        return std::make_unique<PlaneInt>(
+          PlaneInt::Coordinat3D(1,2,3),PlaneInt::Coordinat3D(4,6,9),PlaneInt::Coordinat3D(2,9,7)
+        );
+      },
+      [](const PlaneInt& p) { return sizeof(PlaneInt) + (p.GetPoints().capacity() * sizeof(PlaneInt::Coordinat3D)); }
+    ),
+    MeasureMemoryUse<PlaneRecord>("PlaneRecord",
+      []() { return std::make_unique<PlaneRecord>(); },
+      [](const PlaneRecord&) { return sizeof(PlaneRecord); }
+    )
+  };
+  std::cout
+    << std::left << std::setw(20) << "representation" << std::right
+    << std::setw(10) << "shallow"
+    << std::setw(10) << "deep"
+    << std::setw(14) << "heap blocks"
+    << std::setw(20) << "10M planes (MiB)"
+    << '\n'
+  ;
+  for (const auto& m: v)
+  {
+    std::cout
+      << std::left << std::setw(20) << m.m_name << std::right
+      << std::setw(10) << m.m_shallow
+      << std::setw(10) << m.m_deep
+      << std::setw(14);
+    if (m.m_n_blocks < 0) std::cout << "n/a";
+    else std::cout << m.m_n_blocks;
+    std::cout
+      << std::fixed << std::setprecision(1)
+      << std::setw(20) << (static_cast<double>(m.m_deep) * 1.0e7 / (1024.0 * 1024.0))
+      << std::defaultfloat
+      << '\n'
+    ;
+  }
+  return 0;
+}
+
+static void ShowBenchmarkUsage(std::ostream& os)
+{
+  os
+    << "Usage: plane_benchmark [--points N] [--repeats N]\n"
+    << "       plane_benchmark --sweep [--min-points N] [--max-points N] [--max-threads N] [--memory-budget MiB]\n"
+    << "       plane_benchmark --accuracy [--planes N] [--points N] [--bits N] [--seed N]\n"
+    << "       plane_benchmark --allocations [--calls N]\n"
+    << "       plane_benchmark --construction [--planes N] [--seed N]\n"
+    << "       plane_benchmark --memory\n"
+  ;
+}
+
+static int RunBenchmark(const std::vector<std::string>& args)
+{
+  if (!args.empty() && args[0] == "--sweep")
+  {
+    std::int64_t min_points{1000};
+    //Zero for the default of each kernel
+    std::int64_t max_points{0};
+    int max_threads{static_cast<int>(std::max(1u,std::thread::hardware_concurrency()))};
+    std::int64_t memory_budget_mib{1024};
+    for (std::size_t i=1; i!=args.size(); ++i)
+    {
+      if (i + 1 == args.size())
+      {
+        ShowBenchmarkUsage(std::cerr);
+        return 1;
+      }
+      const std::int64_t value{std::stoll(args[i + 1])};
+      if (value < 1) throw std::invalid_argument("'" + args[i + 1] + "' is not a positive number");
+      if (args[i] == "--min-points") min_points = value;
+      else if (args[i] == "--max-points") max_points = value;
+      else if (args[i] == "--max-threads") max_threads = static_cast<int>(value);
+      else if (args[i] == "--memory-budget") memory_budget_mib = value;
+      else
+      {
+        ShowBenchmarkUsage(std::cerr);
+        return 1;
+      }
+      ++i;
+    }
+    return RunSweep(min_points,max_points,max_threads,memory_budget_mib);
+  }
+  if (!args.empty() && args[0] == "--accuracy")
+  {
+    int n_planes{100};
+    int n_points{1000};
+    int coordinat_bits{32};
+    std::uint32_t seed{42};
+    for (std::size_t i=1; i!=args.size(); ++i)
+    {
+      if (i + 1 == args.size())
+      {
+        ShowBenchmarkUsage(std::cerr);
+        return 1;
+      }
+      const int value{std::stoi(args[i + 1])};
+      if (value < 0) throw std::invalid_argument("'" + args[i + 1] + "' is a negative number");
+      if (args[i] == "--planes") n_planes = value;
+      else if (args[i] == "--points") n_points = value;
+      else if (args[i] == "--bits") coordinat_bits = value;
+      else if (args[i] == "--seed") seed = static_cast<std::uint32_t>(value);
+      else
+      {
+        ShowBenchmarkUsage(std::cerr);
+        return 1;
+      }
+      ++i;
+    }
+    return RunAccuracy(n_planes,n_points,coordinat_bits,seed);
+  }
+  if (!args.empty() && args[0] == "--construction")
+  {
+    int n_planes{100000};
+    std::uint32_t seed{42};
+    for (std::size_t i=1; i!=args.size(); ++i)
+    {
+      if (i + 1 == args.size())
+      {
+        ShowBenchmarkUsage(std::cerr);
+        return 1;
+      }
+      const int value{std::stoi(args[i + 1])};
+      if (value < 0) throw std::invalid_argument("'" + args[i + 1] + "' is a negative number");
+      if (args[i] == "--planes") n_planes = value;
+      else if (args[i] == "--seed") seed = static_cast<std::uint32_t>(value);
+      else
+      {
+        ShowBenchmarkUsage(std::cerr);
+        return 1;
+      }
+      ++i;
+    }
+    return RunConstruction(n_planes,seed);
+  }
+  if (args.size() == 1 && args[0] == "--memory")
+  {
+    return RunMemory();
+  }
+  if (!args.empty() && args[0] == "--allocations")
+  {
+    int n_calls{100};
+    if (args.size() == 3 && args[1] == "--calls")
+    {
+      n_calls = std::stoi(args[2]);
+      if (n_calls < 1) throw std::invalid_argument("'" + args[2] + "' is not a positive number");
+    }
+    else if (args.size() != 1)
+    {
+      ShowBenchmarkUsage(std::cerr);
+      return 1;
+    }
+    if (!IsCountingPlaneAllocations())
+    {
+      throw std::runtime_error("allocations are not counted, link in planeallocations_new.cpp");
+    }
+    WritePlaneAllocations(std::cout,MeasurePlaneAllocations(n_calls));
+    return 0;
+  }
+  int n_points{1 << 20};
+  int n_repeats{10};
+  for (std::size_t i=0; i!=args.size(); ++i)
+  {
+    if ((args[i] == "--points" || args[i] == "--repeats") && i + 1 != args.size())
+    {
+      const int value{std::stoi(args[i + 1])};
+      if (value < 1) throw std::invalid_argument("'" + args[i + 1] + "' is not a positive number");
+      (args[i] == "--points" ? n_points : n_repeats) = value;
+      ++i;
+    }
+    else
+    {
+      ShowBenchmarkUsage(std::cerr);
+      return 1;
+    }
+  }
+
+  const Plane::Coordinats3D points{CreateBenchmarkPoints(n_points)};
+  const Plane plane(
+    Plane::Coordinat3D(0.0,0.0,5.0),
+    Plane::Coordinat3D(1.0,0.0,5.2),
+    Plane::Coordinat3D(0.0,1.0,5.3)
+  );
+  const PlaneZ plane_z(
+    Plane::Coordinat3D(0.0,0.0,5.0),
+    Plane::Coordinat3D(1.0,0.0,5.2),
+    Plane::Coordinat3D(0.0,1.0,5.3)
+  );
+  //Results are summed into this, so the kernels are not optimized away
+  volatile double sink{0.0};
+
+  const std::vector<BenchmarkKernel> kernels{
+    { "PlaneZ::CalcZ", [&]()
+      {
+        double sum{0.0};
+        for (const auto& p: points) sum += plane_z.CalcZ(boost::geometry::get<0>(p),boost::geometry::get<1>(p));
+        sink = sink + sum;
+      }
+    },
+    { "PlaneZ::IsInPlane", [&]()
+      {
+        int n{0};
+        for (const auto& p: points) n += plane_z.IsInPlane(p);
+        sink = sink + n;
+      }
+    },
+    { "Plane::IsInPlane", [&]()
+      {
+        int n{0};
+        for (const auto& p: points) n += plane.IsInPlane(p);
+        sink = sink + n;
+      }
+    },
+    { "Plane::IsInPlane batch", [&]()
+      {
+        const std::vector<bool> v{plane.IsInPlane(points)};
+        sink = sink + v.size();
+      }
+    },
+    { "Plane::CalcError batch", [&]()
+      {
+        const Plane::Doubles v{plane.CalcError(points)};
+        sink = sink + v.back();
+      }
+    },
+    { "Plane::CalcProjection batch", [&]()
+      {
+        const Plane::Coordinats2D v{plane.CalcProjection(points)};
+        sink = sink + boost::geometry::get<0>(v.back());
+      }
+    }
+  };
+
+  if (!PlanePerfCounters().IsAnyAvailable())
+  {
+    std::cout << "Hardware counters unavailable, only measuring wall-clock time\n";
+  }
+  std::cout
+    << std::left << std::setw(28) << "kernel" << std::right
+    << std::setw(12) << "ns"
+    << std::setw(12) << "cycles"
+    << std::setw(12) << "instr"
+    << std::setw(12) << "IPC"
+    << std::setw(12) << "L1D miss"
+    << std::setw(12) << "LLC miss"
+    << std::setw(12) << "br miss"
+    << "  (per point)\n"
+  ;
+  const double n_processed{static_cast<double>(n_points) * n_repeats};
+  for (const auto& kernel: kernels)
+  {
+    const PlanePerfSample sample{MeasurePerf(kernel.m_function,n_repeats)};
+    std::cout
+      << std::left << std::setw(28) << kernel.m_name << std::right
+      << std::setprecision(3)
+      << std::setw(12) << (sample.m_seconds * 1.0e9 / n_processed)
+    ;
+    WritePerPoint(std::cout,sample,PlanePerfEvent::cycles,n_processed);
+    WritePerPoint(std::cout,sample,PlanePerfEvent::instructions,n_processed);
+    std::cout << std::setw(12);
+    if (sample.GetInstructionsPerCycle() > 0.0) std::cout << sample.GetInstructionsPerCycle();
+    else std::cout << "n/a";
+    WritePerPoint(std::cout,sample,PlanePerfEvent::l1d_misses,n_processed);
+    WritePerPoint(std::cout,sample,PlanePerfEvent::llc_misses,n_processed);
+    WritePerPoint(std::cout,sample,PlanePerfEvent::branch_misses,n_processed);
+    std::cout << '\n';
+  }
+  return 0;
+}
+
+} //~namespace ribi
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    return ribi::RunBenchmark(std::vector<std::string>(argv + 1,argv + argc));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "plane_benchmark: " << e.what() << '\n';
+    return 1;
+  }
+}
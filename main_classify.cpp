@@ -0,0 +1,155 @@
+///plane_classify: classify the points of a point file against planes,
+///or calculate their distances or projections, in batch.
+///
+///  plane_classify [options] points_file planes_file output_file
+///
+///The points file is an ASCII XYZ or binary PLY file, see PlanePointReader.
+///The planes file is either a plane file, as saved by SavePlaneFile,
+///or a text file with one function per line, as written by ToFunction.
+///
+///The output file is binary, little endian, with per point one value per
+///plane, in the order of the planes, see PlaneClassifyMode:
+/// - classify: std::uint8_t, 1 if the point is in the plane, 0 otherwise
+/// - distance: double, the error between plane and point, as CalcError
+/// - projection: two doubles, the 2D projection, as CalcProjection
+///
+///The timing and throughput is written to standard output.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "plane.h"
+#include "planeclassify.h"
+#include "planepipeline.h"
+#include "planepointreader.h"
+
+namespace ribi {
+
+static void ShowUsage(std::ostream& os)
+{
+  os
+    << "Usage: plane_classify [options] points_file planes_file output_file\n"
+    << "\n"
+    << "Options:\n"
+    << "  --mode classify|distance|projection  what to calculate, default classify\n"
+    << "  --threads N                          number of worker threads, default all cores\n"
+    << "  --chunk N                            number of points per chunk, default 65536\n"
+    << "  --help                               show this help\n"
+  ;
+}
+
+static int ToPositiveInt(const std::string& s)
+{
+  std::size_t n_used{0};
+  const int i{std::stoi(s,&n_used)};
+  if (n_used != s.size() || i < 1)
+  {
+    throw std::invalid_argument("'" + s + "' is not a positive number");
+  }
+  return i;
+}
+
+static int RunClassify(const std::vector<std::string>& args)
+{
+  PlaneClassifyMode mode{PlaneClassifyMode::classify};
+  int n_threads{static_cast<int>(std::max(1u,std::thread::hardware_concurrency()))};
+  int n_points_per_chunk{1 << 16};
+  std::vector<std::string> filenames;
+  for (std::size_t i=0; i!=args.size(); ++i)
+  {
+    const std::string& arg{args[i]};
+    if (arg == "--help" || arg == "-h")
+    {
+      ShowUsage(std::cout);
+      return 0;
+    }
+    if (arg == "--mode" || arg == "--threads" || arg == "--chunk")
+    {
+      if (i + 1 == args.size())
+      {
+        throw std::invalid_argument("option '" + arg + "' needs a value");
+      }
+      const std::string& value{args[++i]};
+      if (arg == "--mode") mode = ToPlaneClassifyMode(value);
+      else if (arg == "--threads") n_threads = ToPositiveInt(value);
+      else n_points_per_chunk = ToPositiveInt(value);
+    }
+    else if (arg.size() > 2 && arg.substr(0,2) == "--")
+    {
+      throw std::invalid_argument("unknown option '" + arg + "'");
+    }
+    else
+    {
+      filenames.push_back(arg);
+    }
+  }
+  if (filenames.size() != 3)
+  {
+    ShowUsage(std::cerr);
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<std::unique_ptr<Plane>> planes{ReadPlanes(filenames[1],n_threads)};
+  PlanePointReader reader(filenames[0]);
+  std::ofstream out(filenames[2].c_str(),std::ios::binary);
+  if (!out.is_open())
+  {
+    throw std::runtime_error("cannot create file '" + filenames[2] + "'");
+  }
+  std::uint64_t n_bytes_written{0};
+  CalcPointFilePipeline(
+    reader,
+    [&planes,mode](const Plane::Coordinats3D& points) { return CalcPlaneClassifyOutput(planes,mode,points); },
+    [&out,&n_bytes_written](const Plane::Coordinats3D&, const std::vector<char>& bytes)
+    {
+      out.write(bytes.data(),static_cast<std::streamsize>(bytes.size()));
+      n_bytes_written += bytes.size();
+    },
+    n_threads,
+    static_cast<std::size_t>(n_points_per_chunk)
+  );
+  out.close();
+  if (!out)
+  {
+    throw std::runtime_error("cannot write file '" + filenames[2] + "'");
+  }
+  const double seconds{
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+  };
+  const std::uint64_t n_points{reader.GetNumberOfPointsRead()};
+  std::cout
+    << "points: " << n_points << '\n'
+    << "planes: " << planes.size() << '\n'
+    << "threads: " << n_threads << '\n'
+    << "bytes written: " << n_bytes_written << '\n'
+    << "seconds: " << seconds << '\n'
+    << "points per second: " << (seconds > 0.0 ? n_points / seconds : 0.0) << '\n'
+    << "point-plane pairs per second: "
+    << (seconds > 0.0 ? (n_points * planes.size()) / seconds : 0.0) << '\n'
+  ;
+  return 0;
+}
+
+} //~namespace ribi
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    return ribi::RunClassify(std::vector<std::string>(argv + 1,argv + argc));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "plane_classify: " << e.what() << '\n';
+    return 1;
+  }
+}
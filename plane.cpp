@@ -7,6 +7,10 @@
 #include <cassert>
 
 #include "geometry.h"
+#include "planecounters.h"
+#include "planeformat.h"
+#include "planemarginhistogram.h"
+#include "planetrace.h"
 #include "planex.h"
 #include "planey.h"
 #include "planez.h"
@@ -39,6 +43,20 @@ ribi::Plane::Plane(
 
 }
 
+ribi::Plane::Plane(
+  const Doubles& coefficients_x,
+  const Doubles& coefficients_y,
+  const Doubles& coefficients_z,
+  const Coordinats3D& points
+) noexcept
+: m_plane_x(CreatePlaneX(coefficients_x)),
+  m_plane_y(CreatePlaneY(coefficients_y)),
+  m_plane_z(CreatePlaneZ(coefficients_z)),
+  m_points(points)
+{
+
+}
+
 ribi::Plane::Double ribi::Plane::CalcError(const Coordinat3D& coordinat) const noexcept
 {
   // const bool verbose{false};
@@ -74,6 +92,30 @@ ribi::Plane::Double ribi::Plane::CalcError(const Coordinat3D& coordinat) const n
   return min_error;
 }
 
+ribi::Plane::Doubles ribi::Plane::CalcError(const Coordinats3D& coordinats) const
+{
+  Doubles v;
+  v.reserve(coordinats.size());
+  for (const auto& coordinat: coordinats)
+  {
+    v.push_back(CalcError(coordinat));
+  }
+  return v;
+}
+
+std::size_t ribi::Plane::CalcMemoryUse() const noexcept
+{
+  std::size_t n{sizeof(*this)};
+  n += m_plane_x.capacity() * sizeof(PlaneX);
+  for (const auto& p: m_plane_x) n += p.CalcMemoryUse() - sizeof(PlaneX);
+  n += m_plane_y.capacity() * sizeof(PlaneY);
+  for (const auto& p: m_plane_y) n += p.CalcMemoryUse() - sizeof(PlaneY);
+  n += m_plane_z.capacity() * sizeof(PlaneZ);
+  for (const auto& p: m_plane_z) n += p.CalcMemoryUse() - sizeof(PlaneZ);
+  n += m_points.capacity() * sizeof(Coordinat3D);
+  return n;
+}
+
 ribi::Plane::Double ribi::Plane::CalcMaxError(const Coordinat3D& coordinat) const noexcept
 {
   double max_error{std::numeric_limits<double>::denorm_min()};
@@ -97,22 +139,45 @@ ribi::Plane::Coordinats2D ribi::Plane::CalcProjection(
   const Coordinats3D& points
 ) const
 {
+  RIBI_PLANE_TRACE_SCOPE("Plane::CalcProjection");
   if (!CanCalcX() && !CanCalcY() && !CanCalcZ())
   {
     throw std::logic_error("Plane::CalcProjection: cannot express any plane");
   }
-  try { if (CanCalcX()) { return m_plane_x.front().CalcProjection(points); }}
-  catch (std::logic_error&) { /* OK, try next plane */ }
-
-  try { if (CanCalcY()) { return m_plane_y.front().CalcProjection(points); }}
-  catch (std::logic_error&) { /* OK, try next plane */ }
-
-  try { if (CanCalcZ()) { return m_plane_z.front().CalcProjection(points); }}
-  catch (std::logic_error&) { /* OK, try next plane */ }
-
+  return CalcWithPlaneFallback(
+    { CanCalcX(), CanCalcY(), CanCalcZ() },
+    [this,&points](const int orientation)
+    {
+      switch (orientation)
+      {
+        case 0: return m_plane_x.front().CalcProjection(points);
+        case 1: return m_plane_y.front().CalcProjection(points);
+        default: return m_plane_z.front().CalcProjection(points);
+      }
+    }
+  );
+}
 
-  assert(!"Should not get here");
-  throw std::logic_error("Plane::CalcProjection: unexpected behavior");
+ribi::Plane::Coordinat2D ribi::Plane::CalcProjection(
+  const Coordinat3D& point
+) const
+{
+  if (!CanCalcX() && !CanCalcY() && !CanCalcZ())
+  {
+    throw std::logic_error("Plane::CalcProjection: cannot express any plane");
+  }
+  return CalcWithPlaneFallback(
+    { CanCalcX(), CanCalcY(), CanCalcZ() },
+    [this,&point](const int orientation)
+    {
+      switch (orientation)
+      {
+        case 0: return m_plane_x.front().CalcProjection(point);
+        case 1: return m_plane_y.front().CalcProjection(point);
+        default: return m_plane_z.front().CalcProjection(point);
+      }
+    }
+  );
 }
 
 ribi::Plane::Double ribi::Plane::CalcX(const Double& y, const Double& z) const
@@ -156,18 +221,62 @@ bool ribi::Plane::CanCalcZ() const noexcept
   return !m_plane_z.empty();
 }
 
+std::vector<ribi::PlaneX> ribi::CreatePlaneX(
+  const std::vector<double>& coefficients_x
+) noexcept
+{
+  std::vector<PlaneX> p;
+  if (coefficients_x.size() != 4) return p;
+  try
+  {
+    p.push_back(PlaneX(coefficients_x));
+    RIBI_PLANE_COUNT(plane_x_created);
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_x_failed);
+  }
+  return p;
+}
+
 std::vector<ribi::PlaneX> ribi::CreatePlaneX(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p1,
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p2,
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p3
 ) noexcept
 {
+  RIBI_PLANE_TRACE_SCOPE("CreatePlaneX");
   std::vector<PlaneX> p;
   try
   {
     p.push_back(PlaneX(p1,p2,p3));
+    RIBI_PLANE_COUNT(plane_x_created);
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_x_failed);
+  }
+  return p;
+}
+
+std::vector<ribi::PlaneY> ribi::CreatePlaneY(
+  const std::vector<double>& coefficients_y
+) noexcept
+{
+  std::vector<PlaneY> p;
+  if (coefficients_y.size() != 4) return p;
+  try
+  {
+    p.push_back(PlaneY(coefficients_y));
+    RIBI_PLANE_COUNT(plane_y_created);
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_y_failed);
   }
-  catch (std::exception&) {} //!OCLINT this is ok
   return p;
 }
 
@@ -177,12 +286,37 @@ std::vector<ribi::PlaneY> ribi::CreatePlaneY(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p3
 ) noexcept
 {
+  RIBI_PLANE_TRACE_SCOPE("CreatePlaneY");
   std::vector<PlaneY> p;
   try
   {
     p.push_back(PlaneY(p1,p2,p3));
+    RIBI_PLANE_COUNT(plane_y_created);
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_y_failed);
+  }
+  return p;
+}
+
+std::vector<ribi::PlaneZ> ribi::CreatePlaneZ(
+  const std::vector<double>& coefficients_z
+) noexcept
+{
+  std::vector<PlaneZ> p;
+  if (coefficients_z.size() != 4) return p;
+  try
+  {
+    p.push_back(PlaneZ(coefficients_z));
+    RIBI_PLANE_COUNT(plane_z_created);
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_z_failed);
   }
-  catch (std::exception&) {} //!OCLINT this is ok
   return p;
 }
 
@@ -192,12 +326,18 @@ std::vector<ribi::PlaneZ> ribi::CreatePlaneZ(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p3
 ) noexcept
 {
+  RIBI_PLANE_TRACE_SCOPE("CreatePlaneZ");
   std::vector<PlaneZ> p;
   try
   {
     p.push_back(PlaneZ(p1,p2,p3));
+    RIBI_PLANE_COUNT(plane_z_created);
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_z_failed);
   }
-  catch (std::exception&) {} //!OCLINT this is ok
   return p;
 }
 
@@ -241,9 +381,67 @@ bool ribi::Plane::IsInPlane(const Coordinat3D& coordinat) const noexcept
   const bool has_error_below_max = CalcError(coordinat) <= CalcMaxError(coordinat);
   assert(is_in_plane == has_error_below_max);
   #endif
+  RIBI_PLANE_RECORD_MARGIN(CalcError(coordinat),CalcMaxError(coordinat));
   return is_in_plane;
 }
 
+std::vector<bool> ribi::Plane::IsInPlane(const Coordinats3D& coordinats) const
+{
+  return IsInPlane(coordinats,UlpTolerance());
+}
+
+void ribi::Plane::RecordMargin(const Coordinat3D& coordinat) const noexcept
+{
+  RIBI_PLANE_RECORD_MARGIN(CalcError(coordinat),CalcMaxError(coordinat));
+  static_cast<void>(coordinat);
+}
+
+namespace ribi {
+
+///Write the function of a PlaneX, PlaneY or PlaneZ, as operator<< of Plane does
+template <class T>
+static char * WritePlaneFunction(char * const first, char * const last, const std::vector<T>& planes) noexcept
+{
+  if (!first) return nullptr;
+  if (planes.empty()) return WriteChars(first,last,"null");
+  try
+  {
+    const std::to_chars_result result{planes.front().ToFunction(first,last)};
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+  catch (std::exception&)
+  {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    return WriteChars(first,last,"divnull");
+  }
+}
+
+} //~namespace ribi
+
+std::to_chars_result ribi::Plane::ToStr(char * const first, char * const last) const noexcept
+{
+  char * p{WriteChars(first,last,"(")};
+  const auto n_points = static_cast<int>(m_points.size());
+  for (/* const */ auto i=0; i!=n_points; ++i)
+  {
+    p = WriteChars(p,last,"(");
+    p = WriteChars(p,last,boost::geometry::get<0>(m_points[i]));
+    p = WriteChars(p,last,",");
+    p = WriteChars(p,last,boost::geometry::get<1>(m_points[i]));
+    p = WriteChars(p,last,",");
+    p = WriteChars(p,last,boost::geometry::get<2>(m_points[i]));
+    p = WriteChars(p,last,")");
+    p = WriteChars(p,last,i != n_points - 1 ? "," : ")");
+  }
+  p = WriteChars(p,last,",");
+  p = WritePlaneFunction(p,last,m_plane_x);
+  p = WriteChars(p,last,",");
+  p = WritePlaneFunction(p,last,m_plane_y);
+  p = WriteChars(p,last,",");
+  p = WritePlaneFunction(p,last,m_plane_z);
+  return ToCharsResult(p,last);
+}
+
 std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
 {
   os << '(';
@@ -257,7 +455,7 @@ std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
   if (!plane.m_plane_x.empty())
   {
     try { os << plane.m_plane_x.front(); }
-    catch (std::exception&) { os << "divnull"; }
+    catch (std::exception&) { RIBI_PLANE_COUNT(exceptions_caught); os << "divnull"; }
   }
   else
   {
@@ -267,7 +465,7 @@ std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
   if (!plane.m_plane_y.empty())
   {
     try { os << plane.m_plane_y.front(); }
-    catch (std::exception&) { os << "divnull"; }
+    catch (std::exception&) { RIBI_PLANE_COUNT(exceptions_caught); os << "divnull"; }
   }
   else
   {
@@ -277,7 +475,7 @@ std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
   if (!plane.m_plane_z.empty())
   {
     try { os << plane.m_plane_z.front(); }
-    catch (std::exception&) { os << "divnull"; }
+    catch (std::exception&) { RIBI_PLANE_COUNT(exceptions_caught); os << "divnull"; }
   }
   else
   {
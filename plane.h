@@ -1,6 +1,10 @@
 #ifndef RIBI_PLANE_H
 #define RIBI_PLANE_H
 
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <stdexcept>
 #include <vector>
 
 
@@ -13,6 +17,7 @@
 #endif
 
 
+#include "planecounters.h"
 #include "planex.h"
 #include "planey.h"
 #include "planez.h"
@@ -54,6 +59,18 @@ struct Plane
     const Coordinat3D& p3
   ) noexcept;
 
+  ///Construct a Plane from its coefficients, as obtained by
+  ///GetCoefficientsX, GetCoefficientsY and GetCoefficientsZ, and
+  ///the points it was constructed from. Use empty coefficients if
+  ///the Plane cannot be expressed in that form. Does not recalculate
+  ///the coefficients from the points
+  explicit Plane(
+    const Doubles& coefficients_x,
+    const Doubles& coefficients_y,
+    const Doubles& coefficients_z,
+    const Coordinats3D& points
+  ) noexcept;
+
   ///Get the 2D projection of these 3D points,
   ///Assumes these are in a Plane
   /*
@@ -72,6 +89,10 @@ struct Plane
   */
   Coordinats2D CalcProjection(const Coordinats3D& points) const;
 
+  ///Get the 2D projection of a single 3D point, as done by
+  ///CalcProjection for each of a collection of points
+  Coordinat2D CalcProjection(const Coordinat3D& point) const;
+
   ///If the Plane can be expressed as X = A*Y + B*Z + C, return the X
   Double CalcX(const Double& y, const Double& z) const;
 
@@ -93,9 +114,16 @@ struct Plane
   ///Calculates the error between plane and coordinat
   Double CalcError(const Coordinat3D& coordinat) const noexcept;
 
+  ///Calculates the error between plane and each coordinat
+  Doubles CalcError(const Coordinats3D& coordinats) const;
+
   ///Calculates the maximum allowed error for that coordinat for it to be in the plane
   Double CalcMaxError(const Coordinat3D& coordinat) const noexcept;
 
+  ///The bytes used by the Plane: sizeof(Plane), which is its shallow size,
+  ///plus the heap memory of its PlaneX, PlaneY, PlaneZ and points
+  std::size_t CalcMemoryUse() const noexcept;
+
   ///If the Plane can be expressed as X = A*Y + B*Z + C, return the coefficients
   Doubles GetCoefficientsX() const;
 
@@ -105,9 +133,63 @@ struct Plane
   ///If the Plane can be expressed as Z = A*X + B*Y + C, return the coefficients
   Doubles GetCoefficientsZ() const;
 
+  ///The points the Plane is constructed from
+  const Coordinats3D& GetPoints() const noexcept { return m_points; }
+
   ///Checks if the coordinat is in the plane
   bool IsInPlane(const Coordinat3D& coordinat) const noexcept;
 
+  ///Checks if the coordinat is in the plane, using a tolerance policy
+  ///from planetolerance.h that is chosen at compile time, for example
+  ///  plane.IsInPlane(coordinat,AbsoluteTolerance(1.0e-6))
+  template <class Tolerance>
+  bool IsInPlane(const Coordinat3D& coordinat, const Tolerance& tolerance) const noexcept
+  {
+    assert(CanCalcX() || CanCalcY() || CanCalcZ());
+    #ifdef RIBI_PLANE_MARGIN_HISTOGRAM
+    RecordMargin(coordinat);
+    #endif
+    return
+         (CanCalcX() && m_plane_x.front().IsInPlane(coordinat,tolerance))
+      || (CanCalcY() && m_plane_y.front().IsInPlane(coordinat,tolerance))
+      || (CanCalcZ() && m_plane_z.front().IsInPlane(coordinat,tolerance))
+    ;
+  }
+
+  ///Checks for each coordinat if it is in the plane
+  std::vector<bool> IsInPlane(const Coordinats3D& coordinats) const;
+
+  ///Checks for each coordinat if it is in the plane, using a tolerance
+  ///policy from planetolerance.h that is chosen at compile time
+  template <class Tolerance>
+  std::vector<bool> IsInPlane(const Coordinats3D& coordinats, const Tolerance& tolerance) const
+  {
+    assert(CanCalcX() || CanCalcY() || CanCalcZ());
+    const PlaneX * const plane_x{CanCalcX() ? &m_plane_x.front() : nullptr};
+    const PlaneY * const plane_y{CanCalcY() ? &m_plane_y.front() : nullptr};
+    const PlaneZ * const plane_z{CanCalcZ() ? &m_plane_z.front() : nullptr};
+    std::vector<bool> v;
+    v.reserve(coordinats.size());
+    for (const auto& coordinat: coordinats)
+    {
+      #ifdef RIBI_PLANE_MARGIN_HISTOGRAM
+      RecordMargin(coordinat);
+      #endif
+      v.push_back(
+           (plane_x && plane_x->IsInPlane(coordinat,tolerance))
+        || (plane_y && plane_y->IsInPlane(coordinat,tolerance))
+        || (plane_z && plane_z->IsInPlane(coordinat,tolerance))
+      );
+    }
+    return v;
+  }
+
+  ///Write the Plane as operator<< does, without allocating, with each
+  ///number in its shortest notation that reads back to the same value,
+  ///and each point as '(x,y,z)'.
+  ///Writes to [first,last) and returns as std::to_chars does: the end of the
+  ///text, or last and std::errc::value_too_large if it does not fit
+  std::to_chars_result ToStr(char * const first, char * const last) const noexcept;
 
   private:
 
@@ -122,6 +204,11 @@ struct Plane
 
   const Coordinats3D m_points;
 
+  ///Record the margin of the coordinat in the global histogram of the
+  ///thread, see planemarginhistogram.h. Only called by IsInPlane if
+  ///RIBI_PLANE_MARGIN_HISTOGRAM is defined
+  void RecordMargin(const Coordinat3D& coordinat) const noexcept;
+
   friend std::ostream& operator<<(std::ostream& os, const Plane& plane) noexcept;
 };
 
@@ -157,6 +244,30 @@ std::vector<PlaneZ> CreatePlaneZ(
 
 std::ostream& operator<<(std::ostream& os, const Plane& plane) noexcept;
 
+///Calculate with the first orientation, in the order X, Y and Z, that
+///can_calc allows and for which f(orientation) does not throw
+///std::logic_error. If f throws while a next orientation is left, this
+///is counted as a projection fallback and the next orientation is tried.
+///The exception of the last orientation is not caught.
+///Throws std::logic_error if can_calc allows no orientation
+template <class Function>
+auto CalcWithPlaneFallback(const std::array<bool,3>& can_calc, const Function& f) -> decltype(f(0))
+{
+  for (int i=0; i!=3; ++i)
+  {
+    if (!can_calc[i]) continue;
+    const bool has_next{(i < 1 && can_calc[1]) || (i < 2 && can_calc[2])};
+    if (!has_next) return f(i);
+    try { return f(i); }
+    catch (std::logic_error&)
+    {
+      //OK, try next orientation
+      RIBI_PLANE_COUNT(exceptions_caught);
+      RIBI_PLANE_COUNT(projection_fallbacks);
+    }
+  }
+  throw std::logic_error("CalcWithPlaneFallback: cannot express any plane");
+}
 
 } //~namespace ribi
 
@@ -4,10 +4,52 @@ SOURCES += \
     $$PWD/plane.cpp \
     $$PWD/planez.cpp \
     $$PWD/planex.cpp \
-    $$PWD/planey.cpp
+    $$PWD/planey.cpp \
+    $$PWD/planeint.cpp \
+    $$PWD/planemappedfile.cpp \
+    $$PWD/planefile.cpp \
+    $$PWD/planepointreader.cpp \
+    $$PWD/planeprojectionfile.cpp \
+    $$PWD/planeformat.cpp \
+    $$PWD/planeparse.cpp \
+    $$PWD/planeresultfile.cpp \
+    $$PWD/planecompressedpoints.cpp \
+    $$PWD/planepipeline.cpp \
+    $$PWD/planeindex.cpp \
+    $$PWD/planecounters.cpp \
+    $$PWD/planemarginhistogram.cpp \
+    $$PWD/planetrace.cpp \
+    $$PWD/planeperf.cpp \
+    $$PWD/planeaccuracy.cpp \
+    $$PWD/planeaccuracybackends.cpp \
+    $$PWD/planeallocations.cpp \
+    $$PWD/planepointcloud.cpp \
+    $$PWD/planeclassify.cpp
 
 HEADERS  += \
     $$PWD/plane.h \
     $$PWD/planez.h \
     $$PWD/planex.h \
-    $$PWD/planey.h
+    $$PWD/planey.h \
+    $$PWD/planetolerance.h \
+    $$PWD/planeint.h \
+    $$PWD/planemappedfile.h \
+    $$PWD/planefile.h \
+    $$PWD/planepointreader.h \
+    $$PWD/planeprojectionfile.h \
+    $$PWD/planeformat.h \
+    $$PWD/planeparse.h \
+    $$PWD/planeresultfile.h \
+    $$PWD/planecompressedpoints.h \
+    $$PWD/planequeue.h \
+    $$PWD/planepipeline.h \
+    $$PWD/planeindex.h \
+    $$PWD/planecounters.h \
+    $$PWD/planemarginhistogram.h \
+    $$PWD/planetrace.h \
+    $$PWD/planeperf.h \
+    $$PWD/planeaccuracy.h \
+    $$PWD/planeallocations.h \
+    $$PWD/planepointcloud.h \
+    $$PWD/planeclassify.h \
+    $$PWD/planethreadregistry.h
@@ -0,0 +1,55 @@
+include(../RibiLibraries/Apfloat.pri)
+include(../RibiClasses/CppContainer/CppContainer.pri)
+include(../RibiClasses/CppGeometry/CppGeometry.pri)
+include(../RibiClasses/CppGeometry/CppGeometryApfloat.pri)
+include(../RibiClasses/CppRibiRegex/CppRibiRegex.pri)
+
+# The apfloat Plane, instead of plane.pri
+include(plane_apfloat.pri)
+
+# The parts of plane.pri that do not depend on which Plane is used
+SOURCES += \
+    planeaccuracy.cpp \
+    planecounters.cpp \
+    planeint.cpp
+
+HEADERS += \
+    planeaccuracy.h \
+    planecounters.h \
+    planeint.h \
+    planethreadregistry.h
+
+SOURCES += \
+    main_accuracy_apfloat.cpp \
+    planeaccuracybackends_apfloat.cpp
+
+TARGET = plane_accuracy_apfloat
+CONFIG += console
+CONFIG -= app_bundle qt
+
+CONFIG += c++17
+QMAKE_CXXFLAGS += -std=c++17
+
+# High warning levels
+# -Wshadow does not go with apfloat
+QMAKE_CXXFLAGS += -Wall -Wextra -Wnon-virtual-dtor -pedantic -Werror
+
+# Throughput is only meaningful when optimized
+CONFIG += release
+DEFINES += NDEBUG
+QMAKE_CXXFLAGS += -O3
+
+# std::thread
+LIBS += -lpthread
+
+# Boost.Graph
+LIBS += \
+  -lboost_date_time \
+  -lboost_graph \
+  -lboost_regex
+
+# Fixes
+#/usr/include/boost/math/constants/constants.hpp:277: error: unable to find numeric literal operator 'operator""Q'
+#   BOOST_DEFINE_MATH_CONSTANT(half, 5.000000000000000000000000000000000000e-01, "5.00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-01")
+#   ^
+QMAKE_CXXFLAGS += -fext-numeric-literals
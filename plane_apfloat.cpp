@@ -4,15 +4,164 @@
 
 #include "plane.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 #include "container.h"
 #include "geometry_apfloat.h"
+#include "planecounters.h"
+#include "planeprecision_apfloat.h"
 #include "planex.h"
 #include "planey.h"
 #include "planez.h"
 // 
 
+namespace ribi {
+
+///The smallest error between the plane and the coordinat (x,y,z),
+///of calculating X, Y and Z
+static apfloat CalcPlaneError(
+  const Plane& plane,
+  const apfloat& x,
+  const apfloat& y,
+  const apfloat& z
+) noexcept
+{
+  //Constructing an apfloat allocates, so do this once per thread
+  static thread_local const apfloat max_double(std::numeric_limits<double>::max());
+  static thread_local const apfloat zero(0.0);
+  apfloat min_error = max_double;
+
+  //Absolute method
+  if (plane.CanCalcX())
+  {
+    const apfloat error = abs(plane.CalcX(y,z) - x);
+    min_error = std::min(error,min_error);
+  }
+  if (plane.CanCalcY())
+  {
+    const apfloat error = abs(plane.CalcY(x,z) - y);
+    min_error = std::min(error,min_error);
+  }
+  if (plane.CanCalcZ())
+  {
+    const apfloat error = abs(plane.CalcZ(x,y) - z);
+    min_error = std::min(error,min_error);
+  }
+  assert(min_error >= zero);
+  return min_error;
+}
+
+///A copy of an apfloat that shares no digits with it: apfloat copies share
+///their digits, with reference counts that are not atomic. It is read back
+///from its decimal notation, with the same precision
+static apfloat CopyPlaneDigits(const apfloat& x)
+{
+  std::stringstream s;
+  s << x;
+  return apfloat(s.str().c_str(),x.prec());
+}
+
+static Plane::Coordinat3D CopyPlaneDigits(const Plane::Coordinat3D& c)
+{
+  return Plane::Coordinat3D(
+    CopyPlaneDigits(boost::geometry::get<0>(c)),
+    CopyPlaneDigits(boost::geometry::get<1>(c)),
+    CopyPlaneDigits(boost::geometry::get<2>(c))
+  );
+}
+
+///Calls f(plane,coordinat) for all coordinats and returns the results in
+///the order of the coordinats, dividing the coordinats over n_threads
+///threads, of which the calling thread is one. plane_points are the points
+///the plane is constructed from. Every other thread gets its
+///own Plane and coordinats, copied by the calling thread with CopyPlaneDigits
+///before any thread starts, and returns its own results, so no apfloat
+///digits are shared between threads. See the notes on thread safety in the header
+template <class Result, class Function>
+std::vector<Result> CalcPlaneBatch(
+  const Plane& plane,
+  const Plane::Coordinats3D& plane_points,
+  const Plane::Coordinats3D& coordinats,
+  const int n_threads,
+  Function f
+)
+{
+  if (n_threads < 1)
+  {
+    throw std::logic_error("Plane batch: the number of threads must be at least one");
+  }
+  const std::size_t n{coordinats.size()};
+  //At least some coordinats per thread, as copying the Plane is costly
+  const std::size_t min_per_thread{16};
+  const std::size_t n_ranges{
+    std::max(std::size_t(1),std::min(static_cast<std::size_t>(n_threads),n / min_per_thread))
+  };
+  const auto first = [n,n_ranges](const std::size_t i) { return n * i / n_ranges; };
+
+  //The Plane points and coordinats of each other thread
+  std::vector<std::array<Plane::Coordinat3D,3>> points(n_ranges);
+  std::vector<Plane::Coordinats3D> ranges(n_ranges);
+  for (std::size_t i=1; i<n_ranges; ++i)
+  {
+    points[i] = {
+      CopyPlaneDigits(plane_points[0]),
+      CopyPlaneDigits(plane_points[1]),
+      CopyPlaneDigits(plane_points[2])
+    };
+    ranges[i].reserve(first(i + 1) - first(i));
+    for (std::size_t j=first(i); j!=first(i + 1); ++j) ranges[i].push_back(CopyPlaneDigits(coordinats[j]));
+  }
+
+  std::vector<std::vector<Result>> results(n_ranges);
+  std::vector<std::exception_ptr> errors(n_ranges);
+  const auto run = [&](const std::size_t i)
+  {
+    try
+    {
+      results[i].reserve(ranges[i].size());
+      const Plane own_plane(points[i][0],points[i][1],points[i][2]);
+      for (const auto& coordinat: ranges[i]) results[i].push_back(f(own_plane,coordinat));
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  try
+  {
+    for (std::size_t i=1; i<n_ranges; ++i) threads.emplace_back(run,i);
+  }
+  catch (...)
+  {
+    for (auto& thread: threads) thread.join();
+    throw;
+  }
+  //The calling thread uses the Plane and coordinats themselves
+  results[0].reserve(first(1));
+  for (std::size_t j=0; j!=first(1); ++j) results[0].push_back(f(plane,coordinats[j]));
+  for (auto& thread: threads) thread.join();
+  for (const auto& error: errors)
+  {
+    if (error) std::rethrow_exception(error);
+  }
+
+  std::vector<Result> v;
+  v.reserve(n);
+  for (const auto& result: results)
+  {
+    v.insert(v.end(),result.begin(),result.end());
+  }
+  return v;
+}
+
+} //~namespace ribi
 
 ribi::Plane::Plane(
   const Coordinat3D& p1,
@@ -43,52 +192,41 @@ ribi::Plane::Plane(
 
 apfloat ribi::Plane::CalcError(const Coordinat3D& coordinat) const noexcept
 {
-  // const bool verbose{false};
-  const apfloat x = boost::geometry::get<0>(coordinat);
-  const apfloat y = boost::geometry::get<1>(coordinat);
-  const apfloat z = boost::geometry::get<2>(coordinat);
-
-  apfloat min_error = std::numeric_limits<double>::max();
-
-  /* if (verbose)
-  {
-    std::stringstream s;
-    s << std::setprecision(99) << (*this);
-    // TRACE(s.str());
-    // if (CanCalcX()) { TRACE(Container().ToStr(GetCoefficientsX())); }
-    // if (CanCalcY()) { TRACE(Container().ToStr(GetCoefficientsY())); }
-    // if (CanCalcZ()) { TRACE(Container().ToStr(GetCoefficientsZ())); }
-  } */
-
-  //Absolute method
-  if (CanCalcX())
+  if (PlanePrecision::Get() == 0)
   {
-    const auto expected = x;
-    const apfloat calculated = CalcX(y,z);
-    const apfloat error = abs(calculated - expected);
-    min_error = std::min(error,min_error);
+    //Nothing to round, so read the coordinat by reference instead of copying its apfloats
+    return CalcPlaneError(*this,coordinat.get<0>(),coordinat.get<1>(),coordinat.get<2>());
   }
-  if (CanCalcY())
-  {
-    const auto expected = y;
-    const auto calculated = CalcY(x,z);
-    const auto error = abs(calculated - expected);
-    min_error = std::min(error,min_error);
-  }
-  if (CanCalcZ())
-  {
-    const auto expected = z;
-    const auto calculated = CalcZ(x,y);
-    const auto error = abs(calculated - expected);
-    min_error = std::min(error,min_error);
-  }
-  assert(min_error >= 0.0);
-  return min_error;
+  return CalcPlaneError(
+    *this,
+    ToPlanePrecision(coordinat.get<0>()),
+    ToPlanePrecision(coordinat.get<1>()),
+    ToPlanePrecision(coordinat.get<2>())
+  );
+}
+
+ribi::Plane::Doubles ribi::Plane::CalcError(
+  const Coordinats3D& coordinats,
+  const int n_threads
+) const
+{
+  return CalcPlaneBatch<Double>(
+    *this,
+    m_points,
+    coordinats,
+    n_threads,
+    [](const Plane& plane, const Coordinat3D& coordinat)
+    {
+      return plane.CalcError(coordinat);
+    }
+  );
 }
 
 apfloat ribi::Plane::CalcMaxError(const Coordinat3D& coordinat) const noexcept
 {
-  apfloat max_error{std::numeric_limits<double>::denorm_min()};
+  //Constructing an apfloat allocates, so do this once per thread
+  static thread_local const apfloat denorm_min(std::numeric_limits<double>::denorm_min());
+  apfloat max_error = denorm_min;
   if (CanCalcX())
   {
     max_error = std::max(max_error,m_plane_x->CalcMaxError(coordinat));
@@ -114,13 +252,28 @@ ribi::Plane::Coordinats2D ribi::Plane::CalcProjection(
     throw std::logic_error("Plane::CalcProjection: cannot express any plane");
   }
   try { if (m_plane_x) { return m_plane_x->CalcProjection(points); }}
-  catch (std::logic_error&) { /* OK, try next plane */ }
+  catch (std::logic_error&)
+  {
+    //OK, try next plane
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(projection_fallbacks);
+  }
 
   try { if (m_plane_y) { return m_plane_y->CalcProjection(points); }}
-  catch (std::logic_error&) { /* OK, try next plane */ }
+  catch (std::logic_error&)
+  {
+    //OK, try next plane
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(projection_fallbacks);
+  }
 
   try { if (m_plane_z) { return m_plane_z->CalcProjection(points); }}
-  catch (std::logic_error&) { /* OK, try next plane */ }
+  catch (std::logic_error&)
+  {
+    //OK, try next plane
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(projection_fallbacks);
+  }
 
   // TRACE("ERROR");
   // TRACE("INITIAL POINTS");
@@ -226,14 +379,23 @@ boost::shared_ptr<ribi::PlaneX> ribi::Plane::CreatePlaneX(
   try
   {
     const boost::shared_ptr<PlaneX> p(
-      boost::make_shared<PlaneX>(p1,p2,p3)
+      PlanePrecision::Get() == 0
+        ? boost::make_shared<PlaneX>(p1,p2,p3)
+        : boost::make_shared<PlaneX>(
+          ToPlanePrecision(p1),
+          ToPlanePrecision(p2),
+          ToPlanePrecision(p3)
+        )
     );
     assert(p);
+    RIBI_PLANE_COUNT(plane_x_created);
     return p;
   }
   catch (std::exception& e)
   {
     // if (verbose) { /* TRACE(e.what()); */ }
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_x_failed);
     return boost::shared_ptr<PlaneX>();
   }
 }
@@ -247,12 +409,21 @@ boost::shared_ptr<ribi::PlaneY> ribi::Plane::CreatePlaneY(
   try
   {
     const boost::shared_ptr<PlaneY> p
-      = boost::make_shared<PlaneY>(p1,p2,p3);
+      = PlanePrecision::Get() == 0
+        ? boost::make_shared<PlaneY>(p1,p2,p3)
+        : boost::make_shared<PlaneY>(
+          ToPlanePrecision(p1),
+          ToPlanePrecision(p2),
+          ToPlanePrecision(p3)
+        );
     assert(p);
+    RIBI_PLANE_COUNT(plane_y_created);
     return p;
   }
   catch (std::exception&)
   {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_y_failed);
     return boost::shared_ptr<PlaneY>();
   }
 }
@@ -266,12 +437,21 @@ boost::shared_ptr<ribi::PlaneZ> ribi::Plane::CreatePlaneZ(
   try
   {
     const boost::shared_ptr<PlaneZ> p
-      = boost::make_shared<PlaneZ>(p1,p2,p3);
+      = PlanePrecision::Get() == 0
+        ? boost::make_shared<PlaneZ>(p1,p2,p3)
+        : boost::make_shared<PlaneZ>(
+          ToPlanePrecision(p1),
+          ToPlanePrecision(p2),
+          ToPlanePrecision(p3)
+        );
     assert(p);
+    RIBI_PLANE_COUNT(plane_z_created);
     return p;
   }
   catch (std::exception&)
   {
+    RIBI_PLANE_COUNT(exceptions_caught);
+    RIBI_PLANE_COUNT(plane_z_failed);
     return boost::shared_ptr<PlaneZ>();
   }
 }
@@ -306,7 +486,7 @@ std::vector<apfloat> ribi::Plane::GetCoefficientsZ() const
 
 std::string ribi::Plane::GetVersion() noexcept
 {
-  return "1.9";
+  return "1.11";
 }
 
 std::vector<std::string> ribi::Plane::GetVersionHistory() noexcept
@@ -321,7 +501,9 @@ std::vector<std::string> ribi::Plane::GetVersionHistory() noexcept
     "2014-07-03: version 1.6: use of apfloat, improved accuracy",
     "2014-07-10: version 1.7: use of apfloat only",
     "2014-07-15: version 1.8: multiple bugfixes",
-    "2014-08-02: version 1.9: use of stubs, to speed up testing"
+    "2014-08-02: version 1.9: use of stubs, to speed up testing",
+    "2026-10-19: version 1.10: scoped precision, fewer apfloat temporaries",
+    "2026-10-19: version 1.11: added batch CalcError and IsInPlane"
   };
 }
 
@@ -350,6 +532,23 @@ bool ribi::Plane::IsInPlane(const Coordinat3D& coordinat) const noexcept
   return is_in_plane;
 }
 
+std::vector<bool> ribi::Plane::IsInPlane(
+  const Coordinats3D& coordinats,
+  const int n_threads
+) const
+{
+  return CalcPlaneBatch<bool>(
+    *this,
+    m_points,
+    coordinats,
+    n_threads,
+    [](const Plane& plane, const Coordinat3D& coordinat)
+    {
+      return plane.IsInPlane(coordinat);
+    }
+  );
+}
+
 std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
 {
   os << '(';
@@ -363,7 +562,7 @@ std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
   if (plane.m_plane_x)
   {
     try { os << (*plane.m_plane_x); }
-    catch (std::exception&) { os << "divnull"; }
+    catch (std::exception&) { RIBI_PLANE_COUNT(exceptions_caught); os << "divnull"; }
   }
   else
   {
@@ -373,7 +572,7 @@ std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
   if (plane.m_plane_y)
   {
     try { os << (*plane.m_plane_y); }
-    catch (std::exception&) { os << "divnull"; }
+    catch (std::exception&) { RIBI_PLANE_COUNT(exceptions_caught); os << "divnull"; }
   }
   else
   {
@@ -383,7 +582,7 @@ std::ostream& ribi::operator<<(std::ostream& os, const Plane& plane) noexcept
   if (plane.m_plane_z)
   {
     try { os << (*plane.m_plane_z); }
-    catch (std::exception&) { os << "divnull"; }
+    catch (std::exception&) { RIBI_PLANE_COUNT(exceptions_caught); os << "divnull"; }
   }
   else
   {
@@ -30,6 +30,14 @@ struct PlaneZ;
 //Converting this to z being a function of x and y:
 // -C.z =  A  .x + B  .y - D
 //    z = -A/C.x - B/C.y + D/C
+//
+//Thread safety of the batch CalcError and IsInPlane:
+// - apfloat copies share their digits, with reference counts that are not
+//   atomic. So each thread but the calling one works on its own Plane and
+//   coordinats, which the calling thread reads back from their decimal
+//   notation before starting the threads, and no digits are shared
+// - The calling thread works on the Plane and the coordinats themselves
+// - apfloat's global settings must not be changed while a batch runs
 struct Plane
 {
   typedef apfloat Double;
@@ -115,6 +123,10 @@ struct Plane
   ///Calculates the error between plane and coordinat
   Double CalcError(const Coordinat3D& coordinat) const noexcept;
 
+  ///Calculates the error between plane and each coordinat,
+  ///using at most n_threads threads. See the notes on thread safety above
+  Doubles CalcError(const Coordinats3D& coordinats, const int n_threads) const;
+
   ///Calculates the maximum allowed error for that coordinat for it to be in the plane
   Double CalcMaxError(const Coordinat3D& coordinat) const noexcept;
 
@@ -133,6 +145,10 @@ struct Plane
   ///Checks if the coordinat is in the plane
   bool IsInPlane(const Coordinat3D& coordinat) const noexcept;
 
+  ///Checks for each coordinat if it is in the plane,
+  ///using at most n_threads threads. See the notes on thread safety above
+  std::vector<bool> IsInPlane(const Coordinats3D& coordinats, const int n_threads) const;
+
 
   private:
 
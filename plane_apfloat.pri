@@ -3,9 +3,10 @@ INCLUDEPATH += \
 
 SOURCES += \
     $$PWD/plane_apfloat.cpp \
-    $$PWD/planex_apfloat.cpp
+    $$PWD/planex_apfloat.cpp \
+    $$PWD/planeprecision_apfloat.cpp
 
 HEADERS  += \
     $$PWD/plane_apfloat.h \
-    $$PWD/planex_apfloat.h
-
+    $$PWD/planex_apfloat.h \
+    $$PWD/planeprecision_apfloat.h
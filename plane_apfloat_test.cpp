@@ -0,0 +1,65 @@
+#include "plane.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include "planecounters.h"
+
+using namespace ribi;
+
+BOOST_AUTO_TEST_CASE(ribi_plane_apfloat_batch_is_independent_of_threads)
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  const Plane plane(
+    Coordinat3D(1.0,2.0,3.0),
+    Coordinat3D(4.0,6.0,9.0),
+    Coordinat3D(2.0,9.0,7.0)
+  );
+  Plane::Coordinats3D coordinats;
+  //Enough coordinats to divide over several threads
+  for (int i=0; i!=200; ++i)
+  {
+    const double x{static_cast<double>(i % 5)};
+    const double y{static_cast<double>(i / 5)};
+    //Every other coordinat is in the plane
+    const apfloat z{plane.CalcZ(x,y) + apfloat(i % 2 == 0 ? 0.0 : 0.5)};
+    coordinats.push_back(Coordinat3D(x,y,z));
+  }
+  const Plane::Doubles errors{plane.CalcError(coordinats,1)};
+  const std::vector<bool> is_in_plane{plane.IsInPlane(coordinats,1)};
+  BOOST_REQUIRE_EQUAL(errors.size(),coordinats.size());
+  BOOST_REQUIRE_EQUAL(is_in_plane.size(),coordinats.size());
+  for (std::size_t i=0; i!=coordinats.size(); ++i)
+  {
+    BOOST_CHECK(errors[i] == plane.CalcError(coordinats[i]));
+    BOOST_CHECK(is_in_plane[i] == plane.IsInPlane(coordinats[i]));
+    BOOST_CHECK(is_in_plane[i] == (i % 2 == 0));
+  }
+  for (const int n_threads: { 2, 3, 8, 400 })
+  {
+    BOOST_CHECK(plane.CalcError(coordinats,n_threads) == errors);
+    BOOST_CHECK(plane.IsInPlane(coordinats,n_threads) == is_in_plane);
+  }
+  BOOST_CHECK(plane.CalcError(Plane::Coordinats3D(),4).empty());
+  BOOST_CHECK_THROW(plane.CalcError(coordinats,0),std::logic_error);
+  BOOST_CHECK_THROW(plane.IsInPlane(coordinats,0),std::logic_error);
+}
+
+#ifndef RIBI_PLANE_NO_COUNTERS
+BOOST_AUTO_TEST_CASE(ribi_plane_apfloat_counters)
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  const PlaneCounterSnapshot before{GetPlaneCounters()};
+  //z = 1, cannot be expressed as a PlaneX or a PlaneY
+  const Plane p(Coordinat3D(0.0,0.0,1.0),Coordinat3D(1.0,0.0,1.0),Coordinat3D(0.0,1.0,1.0));
+  const PlaneCounterSnapshot after{GetPlaneCounters()};
+  const auto increase = [&](const PlaneCounter counter) { return after.Get(counter) - before.Get(counter); };
+  BOOST_CHECK_EQUAL(increase(PlaneCounter::plane_x_created),0);
+  BOOST_CHECK_EQUAL(increase(PlaneCounter::plane_x_failed),1);
+  BOOST_CHECK_EQUAL(increase(PlaneCounter::plane_y_failed),1);
+  BOOST_CHECK_EQUAL(increase(PlaneCounter::plane_z_created),1);
+  BOOST_CHECK_EQUAL(increase(PlaneCounter::plane_z_failed),0);
+  BOOST_CHECK_EQUAL(increase(PlaneCounter::exceptions_caught),2);
+}
+#endif // RIBI_PLANE_NO_COUNTERS
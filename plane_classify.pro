@@ -0,0 +1,40 @@
+include(../RibiLibraries/Apfloat.pri)
+include(../RibiClasses/CppContainer/CppContainer.pri)
+include(../RibiClasses/CppFuzzy_equal_to/CppFuzzy_equal_to.pri)
+include(../RibiClasses/CppGeometry/CppGeometry.pri)
+include(../RibiClasses/CppRibiRegex/CppRibiRegex.pri)
+
+include(plane.pri)
+
+SOURCES += main_classify.cpp
+
+TARGET = plane_classify
+CONFIG += console
+CONFIG -= app_bundle qt
+
+CONFIG += c++17
+QMAKE_CXXFLAGS += -std=c++17
+
+# High warning levels
+# -Wshadow goes bad with apfloat
+QMAKE_CXXFLAGS += -Wall -Wextra -Wnon-virtual-dtor -pedantic -Werror
+
+# A production tool, so always optimize
+CONFIG += release
+DEFINES += NDEBUG
+QMAKE_CXXFLAGS += -O3
+
+# std::thread
+LIBS += -lpthread
+
+# Boost.Graph
+LIBS += \
+  -lboost_date_time \
+  -lboost_graph \
+  -lboost_regex
+
+# Fixes
+#/usr/include/boost/math/constants/constants.hpp:277: error: unable to find numeric literal operator 'operator""Q'
+#   BOOST_DEFINE_MATH_CONSTANT(half, 5.000000000000000000000000000000000000e-01, "5.00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000e-01")
+#   ^
+QMAKE_CXXFLAGS += -fext-numeric-literals
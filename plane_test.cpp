@@ -734,3 +734,36 @@ BOOST_AUTO_TEST_CASE(ribi_plane_15)
   BOOST_CHECK(p.IsInPlane(p4));
 }
 
+
+BOOST_AUTO_TEST_CASE(ribi_plane_memory_use)
+{
+  const Coordinat3D p1(1.0,2.0,3.0);
+  const Coordinat3D p2(4.0,6.0,9.0);
+  const Coordinat3D p3(2.0,9.0,7.0);
+  //Each PlaneX and PlaneY owns a PlaneZ, each PlaneZ owns four coefficients
+  const PlaneZ plane_z(p1,p2,p3);
+  BOOST_CHECK_EQUAL(plane_z.CalcMemoryUse(),sizeof(PlaneZ) + plane_z.GetCoefficients().capacity() * sizeof(double));
+  BOOST_CHECK(plane_z.CalcMemoryUse() >= sizeof(PlaneZ) + (4 * sizeof(double)));
+  const PlaneX plane_x(p1,p2,p3);
+  BOOST_CHECK(plane_x.CalcMemoryUse() >= sizeof(PlaneX) + sizeof(PlaneZ) + (4 * sizeof(double)));
+  const PlaneY plane_y(p1,p2,p3);
+  BOOST_CHECK(plane_y.CalcMemoryUse() >= sizeof(PlaneY) + sizeof(PlaneZ) + (4 * sizeof(double)));
+
+  const Plane tilted(p1,p2,p3);
+  BOOST_CHECK(tilted.CanCalcX() && tilted.CanCalcY() && tilted.CanCalcZ());
+  BOOST_CHECK(
+    tilted.CalcMemoryUse()
+    >= sizeof(Plane)
+      + plane_x.CalcMemoryUse() + plane_y.CalcMemoryUse() + plane_z.CalcMemoryUse()
+      + (3 * sizeof(Coordinat3D))
+  );
+
+  //A horizontal plane only has a PlaneZ, so uses less
+  const Plane horizontal(Coordinat3D(0.0,0.0,1.0),Coordinat3D(1.0,0.0,1.0),Coordinat3D(0.0,1.0,1.0));
+  BOOST_CHECK(!horizontal.CanCalcX() && !horizontal.CanCalcY());
+  BOOST_CHECK(horizontal.CalcMemoryUse() < tilted.CalcMemoryUse());
+  BOOST_CHECK(
+    horizontal.CalcMemoryUse()
+    >= sizeof(Plane) + plane_z.CalcMemoryUse() + (3 * sizeof(Coordinat3D))
+  );
+}
@@ -2,4 +2,26 @@ SOURCES += \
     $$PWD/plane_test.cpp \
     $$PWD/planez_test.cpp \
     $$PWD/planey_test.cpp \
-    $$PWD/planex_test.cpp
+    $$PWD/planex_test.cpp \
+    $$PWD/planetolerance_test.cpp \
+    $$PWD/planeint_test.cpp \
+    $$PWD/planefile_test.cpp \
+    $$PWD/planepointreader_test.cpp \
+    $$PWD/planeprojectionfile_test.cpp \
+    $$PWD/planeformat_test.cpp \
+    $$PWD/planeparse_test.cpp \
+    $$PWD/planeresultfile_test.cpp \
+    $$PWD/planecompressedpoints_test.cpp \
+    $$PWD/planequeue_test.cpp \
+    $$PWD/planepipeline_test.cpp \
+    $$PWD/planeindex_test.cpp \
+    $$PWD/planecounters_test.cpp \
+    $$PWD/planemarginhistogram_test.cpp \
+    $$PWD/planetrace_test.cpp \
+    $$PWD/planeperf_test.cpp \
+    $$PWD/planeaccuracy_test.cpp \
+    $$PWD/planeallocations_test.cpp \
+    $$PWD/planeallocations_new.cpp \
+    $$PWD/planepointcloud_test.cpp \
+    $$PWD/planeclassify_test.cpp \
+    $$PWD/planethreadregistry_test.cpp
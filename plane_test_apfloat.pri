@@ -0,0 +1,3 @@
+SOURCES += \
+    $$PWD/plane_apfloat_test.cpp \
+    $$PWD/planeprecision_apfloat_test.cpp
@@ -3,6 +3,7 @@ include(../RibiLibraries/BoostAll.pri)
 
 include(plane.pri)
 include(plane_apfloat.pri)
+include(plane_test_apfloat.pri)
 include(../RibiClasses/CppContainer/CppContainer.pri)
 include(../RibiClasses/CppGeometry/CppGeometry.pri)
 include(../RibiClasses/CppGeometry/CppGeometryApfloat.pri)
@@ -44,6 +45,9 @@ CONFIG(debug, debug|release) {
 # Boost.Test
 LIBS += -lboost_unit_test_framework
 
+# std::thread
+LIBS += -lpthread
+
 # Boost.Graph
 LIBS += \
   -lboost_date_time \
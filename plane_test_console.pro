@@ -42,6 +42,9 @@ CONFIG(debug, debug|release) {
 # Boost.Test
 LIBS += -lboost_unit_test_framework
 
+# std::async
+LIBS += -lpthread
+
 # Boost.Graph
 LIBS += \
   -lboost_date_time \
@@ -0,0 +1,325 @@
+#include "planeaccuracy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace ribi {
+
+typedef PlaneInt::Int Int;
+
+///A random integer coordinat with all elements in [-max,max]
+static PlaneInt::Coordinat3D CreateRandomIntCoordinat(std::mt19937& engine, const Int max)
+{
+  std::uniform_int_distribution<Int> d(-max,max);
+  const Int x{d(engine)};
+  const Int y{d(engine)};
+  const Int z{d(engine)};
+  return PlaneInt::Coordinat3D(x,y,z);
+}
+
+///p + (i * u) + (j * v)
+static PlaneInt::Coordinat3D CalcIntCoordinat(
+  const PlaneInt::Coordinat3D& p,
+  const Int i,
+  const PlaneInt::Coordinat3D& u,
+  const Int j,
+  const PlaneInt::Coordinat3D& v
+) noexcept
+{
+  using boost::geometry::get;
+  return PlaneInt::Coordinat3D(
+    get<0>(p) + (i * get<0>(u)) + (j * get<0>(v)),
+    get<1>(p) + (i * get<1>(u)) + (j * get<1>(v)),
+    get<2>(p) + (i * get<2>(u)) + (j * get<2>(v))
+  );
+}
+
+static PlaneAccuracyCase::Coordinat3D ToCoordinat3D(const PlaneInt::Coordinat3D& c, const double scale) noexcept
+{
+  using boost::geometry::get;
+  return PlaneAccuracyCase::Coordinat3D(
+    static_cast<double>(get<0>(c)) * scale,
+    static_cast<double>(get<1>(c)) * scale,
+    static_cast<double>(get<2>(c)) * scale
+  );
+}
+
+///Create a case, see CreatePlaneAccuracySet
+static PlaneAccuracyCase CreatePlaneAccuracyCase(
+  std::mt19937& engine,
+  const bool is_adversarial,
+  const int n_points,
+  const int coordinat_bits,
+  const double scale
+)
+{
+  const Int max_coordinat{Int(1) << coordinat_bits};
+  //The plane is p + (i * u) + (j * v), with i and j in [-64,64],
+  //so its points stay within 2.25 * max_coordinat
+  const Int max_step{Int(1) << (coordinat_bits - 8)};
+  const Int max_index{64};
+  PlaneInt::Coordinat3D p;
+  PlaneInt::Coordinat3D u;
+  PlaneInt::Coordinat3D v;
+  std::unique_ptr<PlaneInt> plane;
+  while (!plane)
+  {
+    p = CreateRandomIntCoordinat(engine,max_coordinat);
+    u = CreateRandomIntCoordinat(engine,max_step);
+    if (is_adversarial)
+    {
+      //Nearly parallel to u
+      const Int k{std::uniform_int_distribution<Int>(1,4)(engine)};
+      v = CalcIntCoordinat(CreateRandomIntCoordinat(engine,1),k,u,0,u);
+    }
+    else
+    {
+      v = CreateRandomIntCoordinat(engine,max_step);
+    }
+    try
+    {
+      plane.reset(new PlaneInt(p,CalcIntCoordinat(p,1,u,0,v),CalcIntCoordinat(p,0,u,1,v)));
+    }
+    catch (const std::logic_error&)
+    {
+      //Collinear, try again
+    }
+  }
+
+  PlaneAccuracyCase c;
+  c.m_int_plane_points = { plane->GetPoints()[0], plane->GetPoints()[1], plane->GetPoints()[2] };
+  c.m_int_points.reserve(n_points);
+  std::uniform_int_distribution<Int> index(-max_index,max_index);
+  std::uniform_int_distribution<int> axis(0,2);
+  std::uniform_int_distribution<int> sign(0,1);
+  for (int i=0; i!=n_points; ++i)
+  {
+    PlaneInt::Coordinat3D q{CalcIntCoordinat(p,index(engine),u,index(engine),v)};
+    if (i % 2 == 1)
+    {
+      if (is_adversarial)
+      {
+        const Int step{sign(engine) == 0 ? -1 : 1};
+        switch (axis(engine))
+        {
+          case 0: boost::geometry::set<0>(q,boost::geometry::get<0>(q) + step); break;
+          case 1: boost::geometry::set<1>(q,boost::geometry::get<1>(q) + step); break;
+          default: boost::geometry::set<2>(q,boost::geometry::get<2>(q) + step); break;
+        }
+      }
+      else
+      {
+        q = CreateRandomIntCoordinat(engine,max_coordinat);
+      }
+    }
+    c.m_int_points.push_back(q);
+  }
+  c.m_is_in_plane = plane->IsInPlane(c.m_int_points);
+
+  for (std::size_t i=0; i!=c.m_plane_points.size(); ++i)
+  {
+    c.m_plane_points[i] = ToCoordinat3D(c.m_int_plane_points[i],scale);
+  }
+  c.m_points.reserve(n_points);
+  for (const auto& q: c.m_int_points) c.m_points.push_back(ToCoordinat3D(q,scale));
+  return c;
+}
+
+} //~namespace ribi
+
+std::vector<double> ribi::CreatePlaneAccuracySeries(const std::vector<double>& test_series) noexcept
+{
+  std::vector<double> v;
+  for (const double x: test_series)
+  {
+    if (x != 0.0) v.push_back(std::abs(x));
+  }
+  //The values GetTestSeries has commented out
+  v.push_back(std::numeric_limits<double>::denorm_min());
+  v.push_back(std::numeric_limits<double>::min());
+  v.push_back(1.e64);
+  v.push_back(std::numeric_limits<double>::max());
+  std::sort(v.begin(),v.end());
+  v.erase(std::unique(v.begin(),v.end()),v.end());
+  return v;
+}
+
+ribi::PlaneAccuracySet ribi::CreatePlaneAccuracySet(
+  const double magnitude,
+  const bool is_adversarial,
+  const int n_planes,
+  const int n_points,
+  const int coordinat_bits,
+  const std::uint32_t seed
+)
+{
+  if (!(magnitude > 0.0) || std::isinf(magnitude))
+  {
+    throw std::invalid_argument("CreatePlaneAccuracySet: magnitude must be positive and finite");
+  }
+  if (n_planes < 0 || n_points < 0)
+  {
+    throw std::invalid_argument("CreatePlaneAccuracySet: number of planes and points cannot be negative");
+  }
+  if (coordinat_bits < 10 || coordinat_bits > 38)
+  {
+    throw std::invalid_argument("CreatePlaneAccuracySet: coordinat_bits must be in [10,38]");
+  }
+  PlaneAccuracySet set;
+  //The integer coordinats are less than 2^(coordinat_bits + 2),
+  //so the coordinats are less than the magnitude. The scale cannot be
+  //below denorm_min, so for the smallest magnitudes the coordinats
+  //are less than a larger magnitude, which the set is labelled with
+  const int scale_exponent{std::ilogb(magnitude) - coordinat_bits - 2};
+  set.m_scale = std::ldexp(1.0,std::max(scale_exponent,-1074));
+  set.m_magnitude = scale_exponent < -1074 ? std::ldexp(1.0,-1074 + coordinat_bits + 2) : magnitude;
+  {
+    std::stringstream s;
+    s << std::setprecision(3) << set.m_magnitude << (is_adversarial ? " adversarial" : " randomized");
+    set.m_name = s.str();
+  }
+  std::mt19937 engine(seed);
+  set.m_cases.reserve(n_planes);
+  for (int i=0; i!=n_planes; ++i)
+  {
+    set.m_cases.push_back(
+      CreatePlaneAccuracyCase(engine,is_adversarial,n_points,coordinat_bits,set.m_scale)
+    );
+  }
+  return set;
+}
+
+ribi::PlaneAccuracyBackend ribi::CreatePlaneIntAccuracyBackend()
+{
+  return PlaneAccuracyBackend{
+    "PlaneInt",
+    [](const PlaneAccuracyCase& c)
+    {
+      const PlaneInt plane(c.m_int_plane_points[0],c.m_int_plane_points[1],c.m_int_plane_points[2]);
+      return plane.IsInPlane(c.m_int_points);
+    }
+  };
+}
+
+double ribi::PlaneAccuracyResult::GetMismatchRate() const noexcept
+{
+  if (m_n_points == 0) return 0.0;
+  return static_cast<double>(m_n_false_positives + m_n_false_negatives + m_n_unclassified)
+    / static_cast<double>(m_n_points)
+  ;
+}
+
+double ribi::PlaneAccuracyResult::GetThroughput() const noexcept
+{
+  if (!(m_seconds > 0.0)) return 0.0;
+  return static_cast<double>(m_n_points) / m_seconds;
+}
+
+ribi::PlaneAccuracyResult ribi::MeasurePlaneAccuracy(
+  const PlaneAccuracyBackend& backend,
+  const PlaneAccuracySet& set
+)
+{
+  //An empty answer for a plane that could not be constructed
+  std::vector<std::vector<bool>> answers;
+  answers.reserve(set.m_cases.size());
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& c: set.m_cases)
+  {
+    try
+    {
+      answers.push_back(backend.m_is_in_plane(c));
+    }
+    catch (const std::runtime_error&)
+    {
+      answers.push_back(std::vector<bool>());
+    }
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  PlaneAccuracyResult result;
+  result.m_backend = backend.m_name;
+  result.m_set = set.m_name;
+  result.m_n_points = 0;
+  result.m_n_false_positives = 0;
+  result.m_n_false_negatives = 0;
+  result.m_n_unclassified = 0;
+  result.m_seconds = std::chrono::duration<double>(stop - start).count();
+  for (std::size_t i=0; i!=set.m_cases.size(); ++i)
+  {
+    const std::vector<bool>& expected = set.m_cases[i].m_is_in_plane;
+    const std::vector<bool>& answer = answers[i];
+    result.m_n_points += static_cast<std::int64_t>(expected.size());
+    if (answer.empty())
+    {
+      result.m_n_unclassified += static_cast<std::int64_t>(expected.size());
+      continue;
+    }
+    assert(answer.size() == expected.size());
+    for (std::size_t j=0; j!=expected.size(); ++j)
+    {
+      if (answer[j] && !expected[j]) ++result.m_n_false_positives;
+      if (!answer[j] && expected[j]) ++result.m_n_false_negatives;
+    }
+  }
+  return result;
+}
+
+std::vector<ribi::PlaneAccuracyResult> ribi::MeasurePlaneAccuracySeries(
+  const std::vector<PlaneAccuracyBackend>& backends,
+  const int n_planes,
+  const int n_points,
+  const int coordinat_bits,
+  const std::uint32_t seed
+)
+{
+  std::vector<PlaneAccuracyResult> results;
+  for (const double magnitude: GetPlaneAccuracySeries())
+  {
+    for (const bool is_adversarial: { false, true })
+    {
+      const PlaneAccuracySet set{
+        CreatePlaneAccuracySet(magnitude,is_adversarial,n_planes,n_points,coordinat_bits,seed)
+      };
+      for (const auto& backend: backends) results.push_back(MeasurePlaneAccuracy(backend,set));
+    }
+  }
+  return results;
+}
+
+void ribi::WritePlaneAccuracy(std::ostream& os, const std::vector<PlaneAccuracyResult>& results)
+{
+  os
+    << std::left << std::setw(24) << "set" << std::setw(26) << "backend" << std::right
+    << std::setw(10) << "points"
+    << std::setw(10) << "false+"
+    << std::setw(10) << "false-"
+    << std::setw(10) << "failed"
+    << std::setw(12) << "mismatch"
+    << std::setw(12) << "Mpoints/s"
+    << '\n'
+  ;
+  for (const auto& r: results)
+  {
+    os
+      << std::left << std::setw(24) << r.m_set << std::setw(26) << r.m_backend << std::right
+      << std::setw(10) << r.m_n_points
+      << std::setw(10) << r.m_n_false_positives
+      << std::setw(10) << r.m_n_false_negatives
+      << std::setw(10) << r.m_n_unclassified
+      << std::setprecision(4)
+      << std::setw(12) << r.GetMismatchRate()
+      << std::setw(12) << (r.GetThroughput() * 1.0e-6)
+      << '\n'
+    ;
+  }
+}
@@ -0,0 +1,153 @@
+#ifndef RIBI_PLANEACCURACY_H
+#define RIBI_PLANEACCURACY_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <boost/geometry.hpp>
+
+#include "planeint.h"
+
+namespace ribi {
+
+///A plane and points to check against it, with the exact answer.
+///All coordinats are integers multiplied by the same power of two, so the
+///doubles are exact and PlaneInt on the integers gives the exact answer.
+///The coordinats are doubles in every build, so that the same cases can
+///be checked by the double and the apfloat Plane
+struct PlaneAccuracyCase
+{
+  typedef boost::geometry::model::point<double,3,boost::geometry::cs::cartesian> Coordinat3D;
+  typedef std::vector<Coordinat3D> Coordinats3D;
+
+  std::array<Coordinat3D,3> m_plane_points;
+  Coordinats3D m_points;
+
+  ///The integer coordinats of m_plane_points and m_points
+  std::array<PlaneInt::Coordinat3D,3> m_int_plane_points;
+  PlaneInt::Coordinats3D m_int_points;
+
+  ///Is each point exactly in the plane?
+  std::vector<bool> m_is_in_plane;
+};
+
+///Cases of which the coordinats have about the same magnitude
+struct PlaneAccuracySet
+{
+  ///The magnitude and kind, for example '1e+08 adversarial'
+  std::string m_name;
+
+  ///The largest absolute value of a coordinat. This is the magnitude
+  ///the set is created with, unless that is too small, see CreatePlaneAccuracySet
+  double m_magnitude;
+
+  ///The power of two the integer coordinats are multiplied by
+  double m_scale;
+
+  std::vector<PlaneAccuracyCase> m_cases;
+};
+
+///The magnitudes of the coordinats to test: those of GetTestSeries, and the
+///denormalized, smallest, huge and largest values it does not (yet) test.
+///In increasing order.
+///Defined by planeaccuracybackends.cpp and planeaccuracybackends_apfloat.cpp,
+///as each build has its own GetTestSeries
+std::vector<double> GetPlaneAccuracySeries() noexcept;
+
+///The magnitudes of a test series, as used by GetPlaneAccuracySeries
+std::vector<double> CreatePlaneAccuracySeries(const std::vector<double>& test_series) noexcept;
+
+///Create a set of n_planes planes with n_points points each, of which the
+///coordinats are at most the magnitude, which must be positive.
+///Half of the points are exactly in the plane, the others are:
+/// - randomized: random points
+/// - adversarial: one integer step away from the plane, of a plane that is
+///   nearly degenerate, because its points are nearly collinear
+///The integer coordinats use about coordinat_bits bits, which must be in
+///[10,38]. As coordinats are multiples of denorm_min, a magnitude below
+///2^(coordinat_bits + 2) times denorm_min is raised to that, and the set
+///is named after and has the raised magnitude. The same seed gives the same set.
+///Throws std::invalid_argument if an argument is out of range
+PlaneAccuracySet CreatePlaneAccuracySet(
+  const double magnitude,
+  const bool is_adversarial,
+  const int n_planes,
+  const int n_points,
+  const int coordinat_bits,
+  const std::uint32_t seed
+);
+
+///A way to check if points are in a plane
+struct PlaneAccuracyBackend
+{
+  std::string m_name;
+
+  ///Is each point of the case in the plane?
+  ///Throws std::runtime_error if the backend cannot construct the plane
+  std::function<std::vector<bool>(const PlaneAccuracyCase&)> m_is_in_plane;
+};
+
+///The backends of this build, each followed by PlaneInt, which is exact:
+/// - planeaccuracybackends.cpp: Plane with each tolerance policy of planetolerance.h
+/// - planeaccuracybackends_apfloat.cpp: the apfloat Plane
+///Plane_apfloat defines the same classes as Plane, so they are compared in
+///two programs, plane_benchmark --accuracy and plane_accuracy_apfloat,
+///on the same sets and with PlaneInt as the reference in both
+std::vector<PlaneAccuracyBackend> GetPlaneAccuracyBackends();
+
+///The PlaneInt backend, which is exact
+PlaneAccuracyBackend CreatePlaneIntAccuracyBackend();
+
+///The mismatches of a backend with the exact answer
+struct PlaneAccuracyResult
+{
+  std::string m_backend;
+  std::string m_set;
+  std::int64_t m_n_points;
+
+  ///Points that are in the plane according to the backend only
+  std::int64_t m_n_false_positives;
+
+  ///Points that are in the plane exactly, but not according to the backend
+  std::int64_t m_n_false_negatives;
+
+  ///Points of planes the backend could not construct, for example
+  ///because the coefficients of a Plane underflow or overflow
+  std::int64_t m_n_unclassified;
+
+  ///The time to construct the planes and check the points
+  double m_seconds;
+
+  ///The fraction of points the backend is wrong about or cannot classify
+  double GetMismatchRate() const noexcept;
+
+  ///Points per second
+  double GetThroughput() const noexcept;
+};
+
+///Check all points of the set with the backend and compare with the exact answer
+PlaneAccuracyResult MeasurePlaneAccuracy(
+  const PlaneAccuracyBackend& backend,
+  const PlaneAccuracySet& set
+);
+
+///Check the randomized and adversarial sets of each magnitude of
+///GetPlaneAccuracySeries with each backend, see CreatePlaneAccuracySet
+std::vector<PlaneAccuracyResult> MeasurePlaneAccuracySeries(
+  const std::vector<PlaneAccuracyBackend>& backends,
+  const int n_planes,
+  const int n_points,
+  const int coordinat_bits,
+  const std::uint32_t seed
+);
+
+///Writes a table with a row per result
+void WritePlaneAccuracy(std::ostream& os, const std::vector<PlaneAccuracyResult>& results);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEACCURACY_H
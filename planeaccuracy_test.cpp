@@ -0,0 +1,138 @@
+#include "planeaccuracy.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace ribi;
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_series_extends_test_series)
+{
+  const std::vector<double> v{GetPlaneAccuracySeries()};
+  BOOST_CHECK(std::is_sorted(v.begin(),v.end()));
+  BOOST_CHECK(std::find(v.begin(),v.end(),1.e8) != v.end());
+  BOOST_CHECK(std::find(v.begin(),v.end(),std::numeric_limits<double>::epsilon()) != v.end());
+  BOOST_CHECK_EQUAL(v.front(),std::numeric_limits<double>::denorm_min());
+  BOOST_CHECK_EQUAL(v.back(),std::numeric_limits<double>::max());
+  BOOST_CHECK(std::find(v.begin(),v.end(),0.0) == v.end());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_set_is_exact_and_reproducible)
+{
+  for (const bool is_adversarial: { false, true })
+  {
+    const PlaneAccuracySet a{CreatePlaneAccuracySet(1.e8,is_adversarial,10,100,30,42)};
+    const PlaneAccuracySet b{CreatePlaneAccuracySet(1.e8,is_adversarial,10,100,30,42)};
+    BOOST_REQUIRE_EQUAL(a.m_cases.size(),10);
+    BOOST_CHECK_EQUAL(std::ilogb(a.m_scale),std::ilogb(1.e8) - 32);
+    for (std::size_t i=0; i!=a.m_cases.size(); ++i)
+    {
+      const PlaneAccuracyCase& c = a.m_cases[i];
+      BOOST_REQUIRE_EQUAL(c.m_points.size(),100);
+      BOOST_CHECK(c.m_is_in_plane == b.m_cases[i].m_is_in_plane);
+      for (std::size_t j=0; j!=c.m_points.size(); ++j)
+      {
+        //Even points are in the plane by construction
+        if (j % 2 == 0) BOOST_CHECK(c.m_is_in_plane[j]);
+        //Doubles are exact multiples of the scale
+        const double x{boost::geometry::get<0>(c.m_points[j])};
+        BOOST_CHECK(std::abs(x) < 1.e8);
+        BOOST_CHECK_EQUAL(x / a.m_scale,static_cast<double>(boost::geometry::get<0>(c.m_int_points[j])));
+        BOOST_CHECK(boost::geometry::get<2>(c.m_points[j]) == boost::geometry::get<2>(b.m_cases[i].m_points[j]));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_adversarial_points_are_off_plane)
+{
+  const PlaneAccuracySet s{CreatePlaneAccuracySet(1.0,true,5,50,20,1)};
+  for (const auto& c: s.m_cases)
+  {
+    for (std::size_t j=1; j<c.m_points.size(); j+=2) BOOST_CHECK(!c.m_is_in_plane[j]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_denormalized_set_is_exact)
+{
+  const PlaneAccuracySet s{
+    CreatePlaneAccuracySet(std::numeric_limits<double>::denorm_min(),false,2,10,10,1)
+  };
+  BOOST_CHECK_EQUAL(s.m_scale,std::numeric_limits<double>::denorm_min());
+  const PlaneAccuracyCase& c = s.m_cases.front();
+  BOOST_CHECK_EQUAL(
+    boost::geometry::get<1>(c.m_points[3]) / s.m_scale,
+    static_cast<double>(boost::geometry::get<1>(c.m_int_points[3]))
+  );
+  //The coordinats do not fit below denorm_min, so the set has and is
+  //named after the magnitude its coordinats are below
+  BOOST_CHECK_EQUAL(s.m_magnitude,std::ldexp(std::numeric_limits<double>::denorm_min(),12));
+  BOOST_CHECK_EQUAL(s.m_name.substr(0,s.m_name.find(' ')),"2.02e-320");
+  for (const auto& d: s.m_cases)
+  {
+    for (const auto& p: d.m_points)
+    {
+      BOOST_CHECK_LT(std::abs(boost::geometry::get<0>(p)),s.m_magnitude);
+      BOOST_CHECK_LT(std::abs(boost::geometry::get<1>(p)),s.m_magnitude);
+      BOOST_CHECK_LT(std::abs(boost::geometry::get<2>(p)),s.m_magnitude);
+    }
+  }
+  //A magnitude that is large enough is kept
+  BOOST_CHECK_EQUAL(CreatePlaneAccuracySet(1.e8,false,1,10,30,1).m_magnitude,1.e8);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_planeint_has_no_mismatches)
+{
+  const PlaneAccuracySet s{CreatePlaneAccuracySet(1.e64,true,5,100,38,3)};
+  const std::vector<PlaneAccuracyBackend> backends{GetPlaneAccuracyBackends()};
+  const auto planeint = std::find_if(backends.begin(),backends.end(),
+    [](const PlaneAccuracyBackend& b) { return b.m_name == "PlaneInt"; }
+  );
+  BOOST_REQUIRE(planeint != backends.end());
+  const PlaneAccuracyResult r{MeasurePlaneAccuracy(*planeint,s)};
+  BOOST_CHECK_EQUAL(r.m_n_points,500);
+  BOOST_CHECK_EQUAL(r.m_n_false_positives,0);
+  BOOST_CHECK_EQUAL(r.m_n_false_negatives,0);
+  BOOST_CHECK_EQUAL(r.m_n_unclassified,0);
+  BOOST_CHECK_EQUAL(r.GetMismatchRate(),0.0);
+  BOOST_CHECK_EQUAL(r.m_set,"1e+64 adversarial");
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_ulp_tolerance_has_no_false_positives_on_random_points)
+{
+  const PlaneAccuracySet s{CreatePlaneAccuracySet(1.0,false,10,100,20,5)};
+  const PlaneAccuracyBackend ulp{GetPlaneAccuracyBackends().front()};
+  BOOST_CHECK_EQUAL(ulp.m_name,"Plane UlpTolerance");
+  const PlaneAccuracyResult r{MeasurePlaneAccuracy(ulp,s)};
+  BOOST_CHECK_EQUAL(r.m_n_points,1000);
+  BOOST_CHECK_EQUAL(r.m_n_false_positives,0);
+  std::stringstream t;
+  WritePlaneAccuracy(t,{r});
+  BOOST_CHECK(t.str().find("Plane UlpTolerance") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_invalid_arguments_throw)
+{
+  BOOST_CHECK_THROW(CreatePlaneAccuracySet(0.0,false,1,1,20,0),std::invalid_argument);
+  BOOST_CHECK_THROW(CreatePlaneAccuracySet(-1.0,false,1,1,20,0),std::invalid_argument);
+  BOOST_CHECK_THROW(CreatePlaneAccuracySet(1.0,false,-1,1,20,0),std::invalid_argument);
+  BOOST_CHECK_THROW(CreatePlaneAccuracySet(1.0,false,1,1,9,0),std::invalid_argument);
+  BOOST_CHECK_THROW(CreatePlaneAccuracySet(1.0,false,1,1,39,0),std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeaccuracy_failed_planes_are_unclassified)
+{
+  const PlaneAccuracySet s{CreatePlaneAccuracySet(1.0,false,3,10,20,7)};
+  const PlaneAccuracyBackend failing{
+    "failing",
+    [](const PlaneAccuracyCase&) -> std::vector<bool> { throw std::runtime_error("cannot"); }
+  };
+  const PlaneAccuracyResult r{MeasurePlaneAccuracy(failing,s)};
+  BOOST_CHECK_EQUAL(r.m_n_points,30);
+  BOOST_CHECK_EQUAL(r.m_n_unclassified,30);
+  BOOST_CHECK_EQUAL(r.GetMismatchRate(),1.0);
+}
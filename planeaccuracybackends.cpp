@@ -0,0 +1,44 @@
+#include "planeaccuracy.h"
+
+#include <stdexcept>
+
+#include "plane.h"
+#include "planetolerance.h"
+#include "planez.h"
+
+namespace ribi {
+
+template <class Tolerance>
+static PlaneAccuracyBackend CreatePlaneAccuracyBackend(const std::string& name, const Tolerance tolerance)
+{
+  return PlaneAccuracyBackend{
+    name,
+    [tolerance](const PlaneAccuracyCase& c)
+    {
+      const Plane plane(c.m_plane_points[0],c.m_plane_points[1],c.m_plane_points[2]);
+      if (!plane.CanCalcX() && !plane.CanCalcY() && !plane.CanCalcZ())
+      {
+        throw std::runtime_error("Plane can be expressed in neither X, Y nor Z");
+      }
+      return plane.IsInPlane(c.m_points,tolerance);
+    }
+  };
+}
+
+} //~namespace ribi
+
+std::vector<double> ribi::GetPlaneAccuracySeries() noexcept
+{
+  return CreatePlaneAccuracySeries(GetTestSeries());
+}
+
+std::vector<ribi::PlaneAccuracyBackend> ribi::GetPlaneAccuracyBackends()
+{
+  return {
+    CreatePlaneAccuracyBackend("Plane UlpTolerance",UlpTolerance()),
+    CreatePlaneAccuracyBackend("Plane InterceptTolerance",InterceptTolerance()),
+    CreatePlaneAccuracyBackend("Plane AbsoluteTolerance",AbsoluteTolerance()),
+    CreatePlaneAccuracyBackend("Plane ExactTolerance",ExactTolerance()),
+    CreatePlaneIntAccuracyBackend()
+  };
+}
@@ -0,0 +1,71 @@
+#include "planeaccuracy.h"
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "plane.h"
+#include "planez.h"
+
+namespace ribi {
+
+///An apfloat coordinat of a double coordinat, of which the digits have the
+///precision, or the precision of a double if it is zero
+static Plane::Coordinat3D ToApfloatCoordinat(
+  const PlaneAccuracyCase::Coordinat3D& c,
+  const std::size_t n_digits
+)
+{
+  using boost::geometry::get;
+  if (n_digits == 0)
+  {
+    return Plane::Coordinat3D(apfloat(get<0>(c)),apfloat(get<1>(c)),apfloat(get<2>(c)));
+  }
+  return Plane::Coordinat3D(
+    apfloat(get<0>(c),n_digits),
+    apfloat(get<1>(c),n_digits),
+    apfloat(get<2>(c),n_digits)
+  );
+}
+
+///The apfloat Plane, on the coordinats converted with ToApfloatCoordinat
+static PlaneAccuracyBackend CreatePlaneApfloatAccuracyBackend(
+  const std::string& name,
+  const std::size_t n_digits
+)
+{
+  return PlaneAccuracyBackend{
+    name,
+    [n_digits](const PlaneAccuracyCase& c)
+    {
+      const Plane plane(
+        ToApfloatCoordinat(c.m_plane_points[0],n_digits),
+        ToApfloatCoordinat(c.m_plane_points[1],n_digits),
+        ToApfloatCoordinat(c.m_plane_points[2],n_digits)
+      );
+      if (!plane.CanCalcX() && !plane.CanCalcY() && !plane.CanCalcZ())
+      {
+        throw std::runtime_error("Plane can be expressed in neither X, Y nor Z");
+      }
+      Plane::Coordinats3D points;
+      points.reserve(c.m_points.size());
+      for (const auto& point: c.m_points) points.push_back(ToApfloatCoordinat(point,n_digits));
+      return plane.IsInPlane(points,1);
+    }
+  };
+}
+
+} //~namespace ribi
+
+std::vector<double> ribi::GetPlaneAccuracySeries() noexcept
+{
+  return CreatePlaneAccuracySeries(PlaneZ::GetTestSeries());
+}
+
+std::vector<ribi::PlaneAccuracyBackend> ribi::GetPlaneAccuracyBackends()
+{
+  return {
+    CreatePlaneApfloatAccuracyBackend("Plane apfloat",0),
+    CreatePlaneApfloatAccuracyBackend("Plane apfloat 40 digits",40),
+    CreatePlaneIntAccuracyBackend()
+  };
+}
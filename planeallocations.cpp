@@ -0,0 +1,226 @@
+#include "planeallocations.h"
+
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+#include <streambuf>
+
+#include "plane.h"
+
+namespace ribi {
+
+///Constant-initialized, so that operator new can use it in any thread
+///without allocating
+static thread_local PlaneAllocations plane_allocations;
+
+static std::atomic<bool> is_counting_plane_allocations{false};
+
+///A stream buffer that discards all characters, to measure operator<<
+struct PlaneNullBuffer : public std::streambuf
+{
+  int overflow(const int c) override { return c; }
+};
+
+///The allocations per call of f, called n_calls times after calling it once
+static PlaneAllocationsPerCall MeasurePlaneAllocationsPerCall(
+  const std::string& name,
+  const std::function<void()>& f,
+  const int n_calls
+)
+{
+  f();
+  const PlaneAllocations a{
+    CountPlaneAllocations(
+      [&f, n_calls]()
+      {
+        for (int i=0; i!=n_calls; ++i) f();
+      }
+    )
+  };
+  return PlaneAllocationsPerCall{
+    name,
+    static_cast<double>(a.m_n_allocations) / static_cast<double>(n_calls),
+    static_cast<double>(a.m_n_bytes) / static_cast<double>(n_calls)
+  };
+}
+
+} //~namespace ribi
+
+ribi::PlaneAllocations ribi::operator-(const PlaneAllocations& lhs, const PlaneAllocations& rhs) noexcept
+{
+  PlaneAllocations a;
+  a.m_n_allocations = lhs.m_n_allocations - rhs.m_n_allocations;
+  a.m_n_bytes = lhs.m_n_bytes - rhs.m_n_bytes;
+  a.m_n_deallocations = lhs.m_n_deallocations - rhs.m_n_deallocations;
+  return a;
+}
+
+void ribi::AddPlaneAllocation(const std::size_t n_bytes) noexcept
+{
+  ++plane_allocations.m_n_allocations;
+  plane_allocations.m_n_bytes += static_cast<std::int64_t>(n_bytes);
+}
+
+void ribi::AddPlaneDeallocation() noexcept
+{
+  ++plane_allocations.m_n_deallocations;
+}
+
+ribi::PlaneAllocations ribi::CountPlaneAllocations(const std::function<void()>& f)
+{
+  const PlaneAllocations before{GetPlaneAllocations()};
+  f();
+  return GetPlaneAllocations() - before;
+}
+
+ribi::PlaneAllocations ribi::GetPlaneAllocations() noexcept
+{
+  return plane_allocations;
+}
+
+bool ribi::IsCountingPlaneAllocations() noexcept
+{
+  return is_counting_plane_allocations.load(std::memory_order_relaxed);
+}
+
+std::vector<ribi::PlaneAllocationsPerCall> ribi::MeasurePlaneAllocations(const int n_calls)
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  const Coordinat3D p1(1.0,2.0,3.0);
+  const Coordinat3D p2(4.0,6.0,9.0);
+  const Coordinat3D p3(2.0,9.0,7.0);
+  const Coordinat3D p(1.5,2.5,3.5);
+  const Plane plane(p1,p2,p3);
+  const PlaneX plane_x(p1,p2,p3);
+  const PlaneY plane_y(p1,p2,p3);
+  const PlaneZ plane_z(p1,p2,p3);
+  const Plane::Doubles coefficients_x{plane.GetCoefficientsX()};
+  const Plane::Doubles coefficients_y{plane.GetCoefficientsY()};
+  const Plane::Doubles coefficients_z{plane.GetCoefficientsZ()};
+  Plane::Coordinats3D points;
+  for (int i=0; i!=1000; ++i)
+  {
+    points.push_back(Coordinat3D(i % 10,i / 10,plane.CalcZ(i % 10,i / 10)));
+  }
+  char buffer[1024];
+  PlaneNullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  //Results are summed into this, so the calls are not optimized away
+  volatile double sink{0.0};
+
+  const std::vector<std::pair<std::string,std::function<void()>>> calls{
+    { "Plane::Plane(p1,p2,p3)", [&]() { const Plane q(p1,p2,p3); sink = sink + q.CanCalcZ(); } },
+    { "Plane::Plane(coefficients)", [&]()
+      {
+        const Plane q(coefficients_x,coefficients_y,coefficients_z,{p1,p2,p3});
+        sink = sink + q.CanCalcZ();
+      }
+    },
+    { "Plane::CalcError(Coordinat3D)", [&]() { sink = sink + plane.CalcError(p); } },
+    { "Plane::CalcError(Coordinats3D)", [&]() { sink = sink + plane.CalcError(points).size(); } },
+    { "Plane::CalcMaxError", [&]() { sink = sink + plane.CalcMaxError(p); } },
+    { "Plane::CalcProjection(Coordinat3D)", [&]() { sink = sink + plane.CalcProjection(p).x(); } },
+    { "Plane::CalcProjection(Coordinats3D)", [&]() { sink = sink + plane.CalcProjection(points).size(); } },
+    { "Plane::CalcX", [&]() { sink = sink + plane.CalcX(2.0,3.0); } },
+    { "Plane::CalcY", [&]() { sink = sink + plane.CalcY(1.0,3.0); } },
+    { "Plane::CalcZ", [&]() { sink = sink + plane.CalcZ(1.0,2.0); } },
+    { "Plane::GetCoefficientsX", [&]() { sink = sink + plane.GetCoefficientsX().size(); } },
+    { "Plane::GetCoefficientsY", [&]() { sink = sink + plane.GetCoefficientsY().size(); } },
+    { "Plane::GetCoefficientsZ", [&]() { sink = sink + plane.GetCoefficientsZ().size(); } },
+    { "Plane::IsInPlane(Coordinat3D)", [&]() { sink = sink + plane.IsInPlane(p); } },
+    { "Plane::IsInPlane(Coordinat3D,UlpTolerance)", [&]() { sink = sink + plane.IsInPlane(p,UlpTolerance()); } },
+    { "Plane::IsInPlane(Coordinats3D)", [&]() { sink = sink + plane.IsInPlane(points).size(); } },
+    { "Plane::ToStr(char*,char*)", [&]()
+      {
+        sink = sink + (plane.ToStr(buffer,buffer + sizeof(buffer)).ptr - buffer);
+      }
+    },
+    { "operator<<(Plane)", [&]() { null_stream << plane; } },
+    { "PlaneX::PlaneX(p1,p2,p3)", [&]() { const PlaneX q(p1,p2,p3); sink = sink + q.CalcX(1.0,1.0); } },
+    { "PlaneX::PlaneX(coefficients)", [&]() { const PlaneX q(coefficients_x); sink = sink + q.CalcX(1.0,1.0); } },
+    { "PlaneX::CalcError", [&]() { sink = sink + plane_x.CalcError(p); } },
+    { "PlaneX::CalcMaxError", [&]() { sink = sink + plane_x.CalcMaxError(p); } },
+    { "PlaneX::CalcProjection(Coordinat3D)", [&]() { sink = sink + plane_x.CalcProjection(p).x(); } },
+    { "PlaneX::CalcProjection(Coordinats3D)", [&]() { sink = sink + plane_x.CalcProjection(points).size(); } },
+    { "PlaneX::CalcX", [&]() { sink = sink + plane_x.CalcX(2.0,3.0); } },
+    { "PlaneX::GetCoefficients", [&]() { sink = sink + plane_x.GetCoefficients().size(); } },
+    { "PlaneX::GetFunctionA", [&]() { sink = sink + plane_x.GetFunctionA(); } },
+    { "PlaneX::IsInPlane", [&]() { sink = sink + plane_x.IsInPlane(p); } },
+    { "PlaneX::ToFunction()", [&]() { sink = sink + plane_x.ToFunction().size(); } },
+    { "PlaneX::ToFunction(char*,char*)", [&]()
+      {
+        sink = sink + (plane_x.ToFunction(buffer,buffer + sizeof(buffer)).ptr - buffer);
+      }
+    },
+    { "RotateInPlaneX(std::vector)", [&]() { sink = sink + RotateInPlaneX(coefficients_x).size(); } },
+    { "RotateInPlaneX(Coordinat3D)", [&]() { sink = sink + boost::geometry::get<0>(RotateInPlaneX(p)); } },
+    { "PlaneY::PlaneY(p1,p2,p3)", [&]() { const PlaneY q(p1,p2,p3); sink = sink + q.CalcY(1.0,1.0); } },
+    { "PlaneY::PlaneY(coefficients)", [&]() { const PlaneY q(coefficients_y); sink = sink + q.CalcY(1.0,1.0); } },
+    { "PlaneY::CalcError", [&]() { sink = sink + plane_y.CalcError(p); } },
+    { "PlaneY::CalcMaxError", [&]() { sink = sink + plane_y.CalcMaxError(p); } },
+    { "PlaneY::CalcProjection(Coordinat3D)", [&]() { sink = sink + plane_y.CalcProjection(p).x(); } },
+    { "PlaneY::CalcProjection(Coordinats3D)", [&]() { sink = sink + plane_y.CalcProjection(points).size(); } },
+    { "PlaneY::CalcY", [&]() { sink = sink + plane_y.CalcY(1.0,3.0); } },
+    { "PlaneY::GetCoefficients", [&]() { sink = sink + plane_y.GetCoefficients().size(); } },
+    { "PlaneY::GetFunctionA", [&]() { sink = sink + plane_y.GetFunctionA(); } },
+    { "PlaneY::IsInPlane", [&]() { sink = sink + plane_y.IsInPlane(p); } },
+    { "PlaneY::ToFunction()", [&]() { sink = sink + plane_y.ToFunction().size(); } },
+    { "PlaneY::ToFunction(char*,char*)", [&]()
+      {
+        sink = sink + (plane_y.ToFunction(buffer,buffer + sizeof(buffer)).ptr - buffer);
+      }
+    },
+    { "RotateInPlaneY(std::vector)", [&]() { sink = sink + RotateInPlaneY(coefficients_y).size(); } },
+    { "RotateInPlaneY(Coordinat3D)", [&]() { sink = sink + boost::geometry::get<0>(RotateInPlaneY(p)); } },
+    { "PlaneZ::PlaneZ(p1,p2,p3)", [&]() { const PlaneZ q(p1,p2,p3); sink = sink + q.CalcZ(1.0,1.0); } },
+    { "PlaneZ::PlaneZ(coefficients)", [&]() { const PlaneZ q(coefficients_z); sink = sink + q.CalcZ(1.0,1.0); } },
+    { "PlaneZ::CalcError", [&]() { sink = sink + plane_z.CalcError(p); } },
+    { "PlaneZ::CalcMaxError", [&]() { sink = sink + plane_z.CalcMaxError(p); } },
+    { "PlaneZ::CalcProjection(Coordinat3D)", [&]() { sink = sink + plane_z.CalcProjection(p).x(); } },
+    { "PlaneZ::CalcProjection(Coordinats3D)", [&]() { sink = sink + plane_z.CalcProjection(points).size(); } },
+    { "PlaneZ::CalcZ", [&]() { sink = sink + plane_z.CalcZ(1.0,2.0); } },
+    { "PlaneZ::GetCoefficients", [&]() { sink = sink + plane_z.GetCoefficients().size(); } },
+    { "PlaneZ::GetFunctionA", [&]() { sink = sink + plane_z.GetFunctionA(); } },
+    { "PlaneZ::IsInPlane", [&]() { sink = sink + plane_z.IsInPlane(p); } },
+    { "PlaneZ::ToFunction()", [&]() { sink = sink + plane_z.ToFunction().size(); } },
+    { "PlaneZ::ToFunction(char*,char*)", [&]()
+      {
+        sink = sink + (plane_z.ToFunction(buffer,buffer + sizeof(buffer)).ptr - buffer);
+      }
+    },
+    { "CalcPlaneZ", [&]() { sink = sink + CalcPlaneZ(p1,p2,p3).size(); } }
+  };
+
+  std::vector<PlaneAllocationsPerCall> v;
+  v.reserve(calls.size());
+  for (const auto& call: calls)
+  {
+    v.push_back(MeasurePlaneAllocationsPerCall(call.first,call.second,n_calls));
+  }
+  return v;
+}
+
+void ribi::SetCountingPlaneAllocations() noexcept
+{
+  is_counting_plane_allocations.store(true,std::memory_order_relaxed);
+}
+
+void ribi::WritePlaneAllocations(std::ostream& os, const std::vector<PlaneAllocationsPerCall>& v)
+{
+  os
+    << std::left << std::setw(44) << "function" << std::right
+    << std::setw(14) << "allocations"
+    << std::setw(12) << "bytes"
+    << '\n'
+  ;
+  for (const auto& call: v)
+  {
+    os
+      << std::left << std::setw(44) << call.m_name << std::right
+      << std::fixed << std::setprecision(1)
+      << std::setw(14) << call.m_n_allocations
+      << std::setw(12) << call.m_n_bytes
+      << std::defaultfloat << '\n'
+    ;
+  }
+}
@@ -0,0 +1,62 @@
+#ifndef RIBI_PLANEALLOCATIONS_H
+#define RIBI_PLANEALLOCATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ribi {
+
+///The number of allocations by global operator new, the bytes they
+///requested, and the number of deallocations by global operator delete.
+///
+///These are only counted if planeallocations_new.cpp, which replaces the
+///global operator new and delete, is linked into the program, as done by
+///the tests and plane_benchmark. Other programs are not affected
+struct PlaneAllocations
+{
+  std::int64_t m_n_allocations{0};
+  std::int64_t m_n_bytes{0};
+  std::int64_t m_n_deallocations{0};
+};
+
+PlaneAllocations operator-(const PlaneAllocations& lhs, const PlaneAllocations& rhs) noexcept;
+
+///The allocations of the calling thread since it started
+PlaneAllocations GetPlaneAllocations() noexcept;
+
+///Are allocations counted, that is, is planeallocations_new.cpp linked in?
+bool IsCountingPlaneAllocations() noexcept;
+
+///The allocations of the calling thread by calling the function
+PlaneAllocations CountPlaneAllocations(const std::function<void()>& f);
+
+///Called by the operator new and delete of planeallocations_new.cpp only
+void AddPlaneAllocation(const std::size_t n_bytes) noexcept;
+void AddPlaneDeallocation() noexcept;
+void SetCountingPlaneAllocations() noexcept;
+
+///The allocations of a public function of Plane, PlaneX, PlaneY or PlaneZ
+struct PlaneAllocationsPerCall
+{
+  ///The function and its arguments, for example 'Plane::IsInPlane(Coordinat3D)'
+  std::string m_name;
+
+  double m_n_allocations;
+  double m_n_bytes;
+};
+
+///The allocations per call of each public function of Plane, PlaneX,
+///PlaneY and PlaneZ, each called n_calls times after calling it once.
+///Functions on a collection of points are called on 1000 points
+std::vector<PlaneAllocationsPerCall> MeasurePlaneAllocations(const int n_calls = 100);
+
+///Writes a table with a row per function
+void WritePlaneAllocations(std::ostream& os, const std::vector<PlaneAllocationsPerCall>& v);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEALLOCATIONS_H
@@ -0,0 +1,94 @@
+//Replaces the global operator new and delete, to count the allocations
+//of each thread for GetPlaneAllocations. Only link this into programs
+//that measure allocations, such as the tests and plane_benchmark
+
+#include "planeallocations.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace ribi {
+
+static void * AllocatePlaneCounted(const std::size_t n_bytes) noexcept
+{
+  AddPlaneAllocation(n_bytes);
+  return std::malloc(n_bytes == 0 ? 1 : n_bytes);
+}
+
+static void * AllocatePlaneCounted(const std::size_t n_bytes, const std::align_val_t alignment) noexcept
+{
+  AddPlaneAllocation(n_bytes);
+  const std::size_t a{static_cast<std::size_t>(alignment)};
+  //std::aligned_alloc needs a size that is a multiple of the alignment
+  const std::size_t size{n_bytes == 0 ? a : ((n_bytes + a - 1) / a) * a};
+  return std::aligned_alloc(a,size);
+}
+
+static void DeallocatePlaneCounted(void * const p) noexcept
+{
+  if (!p) return;
+  AddPlaneDeallocation();
+  std::free(p);
+}
+
+///Marks counting as on before main
+static const bool is_counting_plane_allocations_set{
+  (SetCountingPlaneAllocations(), true)
+};
+
+} //~namespace ribi
+
+void * operator new(const std::size_t n_bytes)
+{
+  void * const p{ribi::AllocatePlaneCounted(n_bytes)};
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void * operator new[](const std::size_t n_bytes)
+{
+  void * const p{ribi::AllocatePlaneCounted(n_bytes)};
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void * operator new(const std::size_t n_bytes, const std::nothrow_t&) noexcept
+{
+  return ribi::AllocatePlaneCounted(n_bytes);
+}
+
+void * operator new[](const std::size_t n_bytes, const std::nothrow_t&) noexcept
+{
+  return ribi::AllocatePlaneCounted(n_bytes);
+}
+
+void * operator new(const std::size_t n_bytes, const std::align_val_t alignment)
+{
+  void * const p{ribi::AllocatePlaneCounted(n_bytes,alignment)};
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void * operator new[](const std::size_t n_bytes, const std::align_val_t alignment)
+{
+  void * const p{ribi::AllocatePlaneCounted(n_bytes,alignment)};
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void * const p) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete[](void * const p) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete(void * const p, const std::size_t) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete[](void * const p, const std::size_t) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete(void * const p, const std::nothrow_t&) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete[](void * const p, const std::nothrow_t&) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete(void * const p, const std::align_val_t) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete[](void * const p, const std::align_val_t) noexcept { ribi::DeallocatePlaneCounted(p); }
+void operator delete(void * const p, const std::size_t, const std::align_val_t) noexcept
+{
+  ribi::DeallocatePlaneCounted(p);
+}
+void operator delete[](void * const p, const std::size_t, const std::align_val_t) noexcept
+{
+  ribi::DeallocatePlaneCounted(p);
+}
@@ -0,0 +1,120 @@
+#include "planeallocations.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+#include "plane.h"
+
+using namespace ribi;
+
+namespace {
+
+const PlaneAllocationsPerCall& Find(const std::vector<PlaneAllocationsPerCall>& v, const std::string& name)
+{
+  const auto i = std::find_if(v.begin(),v.end(),
+    [name](const PlaneAllocationsPerCall& call) { return call.m_name == name; }
+  );
+  BOOST_REQUIRE_MESSAGE(i != v.end(),name);
+  return *i;
+}
+
+} //~namespace
+
+BOOST_AUTO_TEST_CASE(ribi_planeallocations_are_counted)
+{
+  BOOST_REQUIRE(IsCountingPlaneAllocations());
+  const Plane plane(
+    Plane::Coordinat3D(0.0,0.0,1.0),
+    Plane::Coordinat3D(1.0,0.0,1.0),
+    Plane::Coordinat3D(0.0,1.0,1.0)
+  );
+  const Plane::Coordinats3D points(10,Plane::Coordinat3D(1.0,2.0,3.0));
+  //Only allocates its result
+  std::size_t n_errors{0};
+  const PlaneAllocations a{CountPlaneAllocations([&]() { n_errors = plane.CalcError(points).size(); })};
+  BOOST_CHECK_EQUAL(n_errors,10);
+  BOOST_CHECK_EQUAL(a.m_n_allocations,1);
+  BOOST_CHECK_EQUAL(a.m_n_bytes,static_cast<std::int64_t>(10 * sizeof(double)));
+  BOOST_CHECK_EQUAL(a.m_n_deallocations,1);
+  const PlaneAllocations none{CountPlaneAllocations([]() {})};
+  BOOST_CHECK_EQUAL(none.m_n_allocations,0);
+  BOOST_CHECK_EQUAL(none.m_n_bytes,0);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeallocations_hot_paths_do_not_allocate)
+{
+  const std::vector<PlaneAllocationsPerCall> v{MeasurePlaneAllocations(10)};
+  for (const std::string name:
+    {
+      "Plane::CalcError(Coordinat3D)",
+      "Plane::CalcMaxError",
+      "Plane::CalcProjection(Coordinat3D)",
+      "Plane::CalcX",
+      "Plane::CalcY",
+      "Plane::CalcZ",
+      "Plane::IsInPlane(Coordinat3D)",
+      "Plane::IsInPlane(Coordinat3D,UlpTolerance)",
+      "Plane::ToStr(char*,char*)",
+      "PlaneX::CalcError",
+      "PlaneX::CalcMaxError",
+      "PlaneX::CalcProjection(Coordinat3D)",
+      "PlaneX::CalcX",
+      "PlaneX::IsInPlane",
+      "PlaneX::ToFunction(char*,char*)",
+      "RotateInPlaneX(Coordinat3D)",
+      "PlaneY::CalcError",
+      "PlaneY::CalcMaxError",
+      "PlaneY::CalcProjection(Coordinat3D)",
+      "PlaneY::CalcY",
+      "PlaneY::IsInPlane",
+      "PlaneY::ToFunction(char*,char*)",
+      "RotateInPlaneY(Coordinat3D)",
+      "PlaneZ::CalcError",
+      "PlaneZ::CalcMaxError",
+      "PlaneZ::CalcProjection(Coordinat3D)",
+      "PlaneZ::CalcZ",
+      "PlaneZ::GetCoefficients",
+      "PlaneZ::IsInPlane",
+      "PlaneZ::ToFunction(char*,char*)"
+    }
+  )
+  {
+    const PlaneAllocationsPerCall& call = Find(v,name);
+    BOOST_CHECK_MESSAGE(call.m_n_allocations == 0.0,name << " allocates " << call.m_n_allocations << " times");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeallocations_batches_allocate_their_result_only)
+{
+  //One allocation for the result, independent of the number of points
+  const std::vector<PlaneAllocationsPerCall> v{MeasurePlaneAllocations(10)};
+  for (const std::string name:
+    {
+      "Plane::CalcError(Coordinats3D)",
+      "Plane::CalcProjection(Coordinats3D)",
+      "Plane::IsInPlane(Coordinats3D)",
+      "PlaneX::CalcProjection(Coordinats3D)",
+      "PlaneY::CalcProjection(Coordinats3D)",
+      "PlaneZ::CalcProjection(Coordinats3D)"
+    }
+  )
+  {
+    const PlaneAllocationsPerCall& call = Find(v,name);
+    BOOST_CHECK_MESSAGE(call.m_n_allocations == 1.0,name << " allocates " << call.m_n_allocations << " times");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeallocations_construction_does_not_regress)
+{
+  //The allocations at the time of writing, which should only go down
+  const std::vector<PlaneAllocationsPerCall> v{MeasurePlaneAllocations(10)};
+  BOOST_CHECK_LE(Find(v,"Plane::Plane(p1,p2,p3)").m_n_allocations,12.0);
+  BOOST_CHECK_LE(Find(v,"PlaneX::PlaneX(p1,p2,p3)").m_n_allocations,3.0);
+  BOOST_CHECK_LE(Find(v,"PlaneY::PlaneY(p1,p2,p3)").m_n_allocations,3.0);
+  BOOST_CHECK_LE(Find(v,"PlaneZ::PlaneZ(p1,p2,p3)").m_n_allocations,2.0);
+  std::stringstream s;
+  WritePlaneAllocations(s,v);
+  BOOST_CHECK(s.str().find("RotateInPlaneX(std::vector)") != std::string::npos);
+}
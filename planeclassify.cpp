@@ -0,0 +1,170 @@
+#include "planeclassify.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "planefile.h"
+#include "planemappedfile.h"
+
+namespace ribi {
+
+///Append a double little endian
+static void AppendLittleEndian(std::vector<char>& v, const double x)
+{
+  std::uint64_t bits{0};
+  std::memcpy(&bits,&x,sizeof(x));
+  for (std::size_t i=0; i!=sizeof(bits); ++i)
+  {
+    v.push_back(static_cast<char>(bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+} //~namespace ribi
+
+ribi::PlaneClassifyMode ribi::ToPlaneClassifyMode(const std::string& s)
+{
+  if (s == "classify") return PlaneClassifyMode::classify;
+  if (s == "distance") return PlaneClassifyMode::distance;
+  if (s == "projection") return PlaneClassifyMode::projection;
+  throw std::invalid_argument("unknown mode '" + s + "'");
+}
+
+std::size_t ribi::GetPlaneClassifyValueSize(const PlaneClassifyMode mode) noexcept
+{
+  switch (mode)
+  {
+    case PlaneClassifyMode::classify: return sizeof(std::uint8_t);
+    case PlaneClassifyMode::distance: return sizeof(double);
+    case PlaneClassifyMode::projection: return 2 * sizeof(double);
+  }
+  return 0;
+}
+
+std::unique_ptr<ribi::Plane> ribi::CreatePlane(const PlaneFunction& f)
+{
+  //The coefficients A.x + B.y + C.z = D of the plane. PlaneX and PlaneZ
+  //take these as is, PlaneY takes them with A and C swapped, as its
+  //GetCoefficients returns them. Each is only created if the plane can
+  //be expressed in its form
+  Plane::Doubles coefficients{f.GetCoefficients()};
+  if (f.m_lhs == 'y') std::swap(coefficients[0],coefficients[2]);
+  const Plane::Doubles coefficients_y{
+    coefficients[2],coefficients[1],coefficients[0],coefficients[3]
+  };
+
+  typedef Plane::Coordinat3D Coordinat3D;
+  Plane::Coordinats3D points;
+  switch (f.m_lhs)
+  {
+    case 'x':
+      points = {
+        Coordinat3D(f.m_c,0.0,0.0),
+        Coordinat3D(f.m_a + f.m_c,1.0,0.0),
+        Coordinat3D(f.m_b + f.m_c,0.0,1.0)
+      };
+      break;
+    case 'y':
+      points = {
+        Coordinat3D(0.0,f.m_c,0.0),
+        Coordinat3D(1.0,f.m_a + f.m_c,0.0),
+        Coordinat3D(0.0,f.m_b + f.m_c,1.0)
+      };
+      break;
+    case 'z':
+      points = {
+        Coordinat3D(0.0,0.0,f.m_c),
+        Coordinat3D(1.0,0.0,f.m_a + f.m_c),
+        Coordinat3D(0.0,1.0,f.m_b + f.m_c)
+      };
+      break;
+    default:
+      throw std::logic_error("CreatePlane: unknown function");
+  }
+  return std::unique_ptr<Plane>(new Plane(coefficients,coefficients_y,coefficients,points));
+}
+
+std::vector<std::unique_ptr<ribi::Plane>> ribi::ReadPlanes(
+  const std::string& filename,
+  const int n_threads
+)
+{
+  std::vector<std::unique_ptr<Plane>> planes;
+  bool is_plane_file{false};
+  {
+    const PlaneMappedFile file(filename);
+    is_plane_file = file.GetSize() >= 8 && std::memcmp(file.GetData(),"ribiplns",8) == 0;
+  }
+  if (is_plane_file)
+  {
+    const PlaneFile file(filename);
+    for (std::size_t i=0; i!=file.GetSize(); ++i)
+    {
+      planes.push_back(file.CreatePlane(i));
+    }
+  }
+  else
+  {
+    for (const auto& f: ParsePlaneFunctionFile(filename,n_threads))
+    {
+      planes.push_back(CreatePlane(f));
+    }
+  }
+  if (planes.empty())
+  {
+    throw std::runtime_error("no planes in '" + filename + "'");
+  }
+  return planes;
+}
+
+std::vector<char> ribi::CalcPlaneClassifyOutput(
+  const std::vector<std::unique_ptr<Plane>>& planes,
+  const PlaneClassifyMode mode,
+  const Plane::Coordinats3D& points
+)
+{
+  const std::size_t n_planes{planes.size()};
+  const std::size_t n_points{points.size()};
+  std::vector<char> v;
+  v.reserve(n_points * n_planes * GetPlaneClassifyValueSize(mode));
+  switch (mode)
+  {
+    case PlaneClassifyMode::classify:
+    {
+      std::vector<std::vector<bool>> is_in_plane;
+      for (const auto& plane: planes) is_in_plane.push_back(plane->IsInPlane(points));
+      for (std::size_t i=0; i!=n_points; ++i)
+      {
+        for (std::size_t j=0; j!=n_planes; ++j) v.push_back(is_in_plane[j][i] ? 1 : 0);
+      }
+      break;
+    }
+    case PlaneClassifyMode::distance:
+    {
+      std::vector<Plane::Doubles> errors;
+      for (const auto& plane: planes) errors.push_back(plane->CalcError(points));
+      for (std::size_t i=0; i!=n_points; ++i)
+      {
+        for (std::size_t j=0; j!=n_planes; ++j) AppendLittleEndian(v,errors[j][i]);
+      }
+      break;
+    }
+    case PlaneClassifyMode::projection:
+    {
+      std::vector<Plane::Coordinats2D> projections;
+      for (const auto& plane: planes) projections.push_back(plane->CalcProjection(points));
+      for (std::size_t i=0; i!=n_points; ++i)
+      {
+        for (std::size_t j=0; j!=n_planes; ++j)
+        {
+          AppendLittleEndian(v,boost::geometry::get<0>(projections[j][i]));
+          AppendLittleEndian(v,boost::geometry::get<1>(projections[j][i]));
+        }
+      }
+      break;
+    }
+  }
+  return v;
+}
@@ -0,0 +1,50 @@
+#ifndef RIBI_PLANECLASSIFY_H
+#define RIBI_PLANECLASSIFY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "plane.h"
+#include "planeparse.h"
+
+namespace ribi {
+
+///What plane_classify calculates for each point and plane
+enum class PlaneClassifyMode
+{
+  classify,  ///std::uint8_t, 1 if the point is in the plane, 0 otherwise
+  distance,  ///double, the error between plane and point, as CalcError
+  projection ///two doubles, the 2D projection, as CalcProjection
+};
+
+///The mode with this name: 'classify', 'distance' or 'projection'.
+///Throws std::invalid_argument if there is no mode with this name
+PlaneClassifyMode ToPlaneClassifyMode(const std::string& s);
+
+///The number of bytes written per point and plane
+std::size_t GetPlaneClassifyValueSize(const PlaneClassifyMode mode) noexcept;
+
+///The Plane with the function, constructed from its coefficients, so it
+///is exactly the plane of the function. Only its points, which are used
+///to display it, are calculated from the function and may be rounded
+std::unique_ptr<Plane> CreatePlane(const PlaneFunction& f);
+
+///Read the planes from a plane file, as saved by SavePlaneFile, or from a
+///text file with one function per line, as written by ToFunction.
+///Throws std::runtime_error if the file cannot be read or has no planes.
+///Throws std::invalid_argument if a line is not a function
+std::vector<std::unique_ptr<Plane>> ReadPlanes(const std::string& filename, const int n_threads);
+
+///The output of plane_classify for the points: for each point, for each
+///plane in order, one value as described by PlaneClassifyMode.
+///All values are little endian, whatever the byte order of the machine
+std::vector<char> CalcPlaneClassifyOutput(
+  const std::vector<std::unique_ptr<Plane>>& planes,
+  const PlaneClassifyMode mode,
+  const Plane::Coordinats3D& points
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANECLASSIFY_H
@@ -0,0 +1,131 @@
+#include "planeclassify.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "planepointreader.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+///Read a little endian double
+static double LoadLittleEndianDouble(const char * const p)
+{
+  std::uint64_t bits{0};
+  for (int i=7; i>=0; --i)
+  {
+    bits = (bits << 8) | static_cast<unsigned char>(p[i]);
+  }
+  double x{0.0};
+  std::memcpy(&x,&bits,sizeof(x));
+  return x;
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeclassify_creates_plane_from_coefficients)
+{
+  //Creating this plane from points would lose A, as A + C rounds to C
+  const PlaneFunction f{ParsePlaneFunction("z=(1e-20*x) + (0*y) + 10000000000")};
+  const auto plane = CreatePlane(f);
+  BOOST_REQUIRE(plane->CanCalcZ());
+  BOOST_CHECK_EQUAL(plane->GetCoefficientsZ()[0],1.0e-20);
+  BOOST_CHECK_EQUAL(plane->CalcZ(1.0e30,0.0),2.0e10);
+  BOOST_CHECK(plane->CanCalcX());
+  BOOST_CHECK(!plane->CanCalcY());
+
+  //Each orientation gives the same plane
+  for (const char * const s: { "x=(2*y) + (3*z) + 4", "y=(2*x) + (3*z) + 4", "z=(2*x) + (3*y) + 4" })
+  {
+    const PlaneFunction g{ParsePlaneFunction(s)};
+    const auto p = CreatePlane(g);
+    BOOST_REQUIRE(p->CanCalcX() && p->CanCalcY() && p->CanCalcZ());
+    const Coordinat3D on_plane{
+      g.m_lhs == 'x' ? Coordinat3D(2.0 * 5.0 + 3.0 * 7.0 + 4.0,5.0,7.0)
+      : g.m_lhs == 'y' ? Coordinat3D(5.0,2.0 * 5.0 + 3.0 * 7.0 + 4.0,7.0)
+      : Coordinat3D(5.0,7.0,2.0 * 5.0 + 3.0 * 7.0 + 4.0)
+    };
+    BOOST_CHECK(p->IsInPlane(on_plane));
+    BOOST_CHECK_EQUAL(p->CalcError(on_plane),0.0);
+    const Coordinat3D off_plane(
+      boost::geometry::get<0>(on_plane) + 1.0,
+      boost::geometry::get<1>(on_plane) + 1.0,
+      boost::geometry::get<2>(on_plane) + 1.0
+    );
+    BOOST_CHECK(!p->IsInPlane(off_plane));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeclassify_points_file_and_functions_file)
+{
+  const std::string points_filename{"ribi_planeclassify_points.xyz"};
+  const std::string functions_filename{"ribi_planeclassify_functions.txt"};
+  {
+    std::ofstream f(points_filename.c_str());
+    f << "1 2 6\n"   //On z = x + y + 3
+      << "1 2 7\n"   //On z = 2*x + 2*y + 1
+      << "0 0 3\n";  //On z = x + y + 3
+  }
+  {
+    std::ofstream f(functions_filename.c_str());
+    f << "z=(1*x) + (1*y) + 3\n"
+      << "z=(2*x) + (2*y) + 1\n";
+  }
+  const std::vector<std::unique_ptr<Plane>> planes{ReadPlanes(functions_filename,2)};
+  BOOST_REQUIRE_EQUAL(planes.size(),2);
+  PlanePointReader reader(points_filename);
+  Plane::Coordinats3D points;
+  BOOST_REQUIRE(reader.Read(points,10));
+  BOOST_REQUIRE_EQUAL(points.size(),3);
+
+  //Per point, per plane
+  const std::vector<char> classify{
+    CalcPlaneClassifyOutput(planes,PlaneClassifyMode::classify,points)
+  };
+  BOOST_CHECK(classify == std::vector<char>({ 1, 0, 0, 1, 1, 0 }));
+
+  const std::vector<char> distance{
+    CalcPlaneClassifyOutput(planes,PlaneClassifyMode::distance,points)
+  };
+  BOOST_REQUIRE_EQUAL(distance.size(),3 * 2 * sizeof(double));
+  for (std::size_t i=0; i!=3; ++i)
+  {
+    for (std::size_t j=0; j!=2; ++j)
+    {
+      BOOST_CHECK_EQUAL(
+        LoadLittleEndianDouble(&distance[((i * 2) + j) * sizeof(double)]),
+        planes[j]->CalcError(points[i])
+      );
+    }
+  }
+  //(1,2,6) is 1 off in Z from z = 2*x + 2*y + 1, and 0.5 off in X and Y
+  BOOST_CHECK_EQUAL(LoadLittleEndianDouble(&distance[sizeof(double)]),0.5);
+
+  const std::vector<char> projection{
+    CalcPlaneClassifyOutput(planes,PlaneClassifyMode::projection,points)
+  };
+  BOOST_REQUIRE_EQUAL(projection.size(),3 * 2 * 2 * sizeof(double));
+  const Plane::Coordinats2D expected{planes[1]->CalcProjection(points)};
+  for (std::size_t i=0; i!=3; ++i)
+  {
+    const char * const p{&projection[((i * 2) + 1) * 2 * sizeof(double)]};
+    BOOST_CHECK_EQUAL(LoadLittleEndianDouble(p),boost::geometry::get<0>(expected[i]));
+    BOOST_CHECK_EQUAL(LoadLittleEndianDouble(p + sizeof(double)),boost::geometry::get<1>(expected[i]));
+  }
+
+  std::remove(points_filename.c_str());
+  std::remove(functions_filename.c_str());
+  BOOST_CHECK_THROW(ReadPlanes(functions_filename,2),std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeclassify_modes)
+{
+  BOOST_CHECK(ToPlaneClassifyMode("classify") == PlaneClassifyMode::classify);
+  BOOST_CHECK(ToPlaneClassifyMode("distance") == PlaneClassifyMode::distance);
+  BOOST_CHECK(ToPlaneClassifyMode("projection") == PlaneClassifyMode::projection);
+  BOOST_CHECK_THROW(ToPlaneClassifyMode("nonsense"),std::invalid_argument);
+  BOOST_CHECK_EQUAL(GetPlaneClassifyValueSize(PlaneClassifyMode::projection),16);
+}
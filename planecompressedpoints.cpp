@@ -0,0 +1,182 @@
+#include "planecompressedpoints.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ribi {
+
+///The dependent coordinat of the plane along the axis, from the other two,
+///in the order X,Y,Z
+static double CalcCompressionDependent(
+  const Plane& plane,
+  const int axis,
+  const double a,
+  const double b
+)
+{
+  switch (axis)
+  {
+    case 0: return plane.CalcX(a,b);
+    case 1: return plane.CalcY(a,b);
+    default: assert(axis == 2); return plane.CalcZ(a,b);
+  }
+}
+
+///The largest slope of the dependent coordinat along the axis
+static double CalcCompressionSlope(const Plane& plane, const int axis)
+{
+  const double c{CalcCompressionDependent(plane,axis,0.0,0.0)};
+  return std::max(
+    std::abs(CalcCompressionDependent(plane,axis,1.0,0.0) - c),
+    std::abs(CalcCompressionDependent(plane,axis,0.0,1.0) - c)
+  );
+}
+
+///Quantize a value to a multiple of the quantum
+static std::int64_t Quantize(const double x, const double quantum)
+{
+  const double q{std::round(x / quantum)};
+  //Keep some room for the differences between two quantized values
+  const double max{static_cast<double>(std::numeric_limits<std::int64_t>::max() / 4)};
+  if (!(std::abs(q) <= max))
+  {
+    throw std::out_of_range("PlaneCompressedPoints: coordinat too big for the quantum");
+  }
+  return static_cast<std::int64_t>(q);
+}
+
+///Append a signed integer as a variable length integer: zigzag encoded,
+///then seven bits per byte, least significant first, with the high bit
+///set on all bytes but the last
+static void AppendVarint(std::vector<std::uint8_t>& v, const std::int64_t i)
+{
+  std::uint64_t u{
+    (static_cast<std::uint64_t>(i) << 1) ^ static_cast<std::uint64_t>(i >> 63)
+  };
+  while (u >= 0x80)
+  {
+    v.push_back(static_cast<std::uint8_t>(u | 0x80));
+    u >>= 7;
+  }
+  v.push_back(static_cast<std::uint8_t>(u));
+}
+
+///Read a signed integer written by AppendVarint
+static std::int64_t ReadVarint(const std::uint8_t*& p) noexcept
+{
+  std::uint64_t u{0};
+  int shift{0};
+  while (*p & 0x80)
+  {
+    u |= static_cast<std::uint64_t>(*p++ & 0x7f) << shift;
+    shift += 7;
+  }
+  u |= static_cast<std::uint64_t>(*p++) << shift;
+  return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+}
+
+} //~namespace ribi
+
+int ribi::CalcCompressionAxis(const Plane& plane)
+{
+  int best_axis{-1};
+  double best_slope{0.0};
+  const bool can_calc[3] = { plane.CanCalcX(), plane.CanCalcY(), plane.CanCalcZ() };
+  for (int axis=0; axis!=3; ++axis)
+  {
+    if (!can_calc[axis]) continue;
+    const double slope{CalcCompressionSlope(plane,axis)};
+    if (best_axis == -1 || slope < best_slope)
+    {
+      best_axis = axis;
+      best_slope = slope;
+    }
+  }
+  assert(best_axis != -1);
+  return best_axis;
+}
+
+ribi::PlaneCompressedPoints::PlaneCompressedPoints(
+  const Plane& plane,
+  const Coordinats3D& points,
+  const double quantum
+) : m_axis{CalcCompressionAxis(plane)},
+    m_data{},
+    m_n_points{points.size()},
+    m_quantum{quantum}
+{
+  if (!(quantum > 0.0))
+  {
+    throw std::invalid_argument("PlaneCompressedPoints: quantum must be positive");
+  }
+  //The indices of the two free coordinats
+  const int i_a{m_axis == 0 ? 1 : 0};
+  const int i_b{m_axis == 2 ? 1 : 2};
+  //Most points take three bytes
+  m_data.reserve(points.size() * 3);
+  std::int64_t prev_a{0};
+  std::int64_t prev_b{0};
+  for (const auto& point: points)
+  {
+    const double xyz[3] = {
+      boost::geometry::get<0>(point),
+      boost::geometry::get<1>(point),
+      boost::geometry::get<2>(point)
+    };
+    const std::int64_t a{Quantize(xyz[i_a],quantum)};
+    const std::int64_t b{Quantize(xyz[i_b],quantum)};
+    //The residual is relative to the plane at the quantized coordinats,
+    //as these are the ones available when decompressing
+    const double on_plane{
+      CalcCompressionDependent(
+        plane,m_axis,static_cast<double>(a) * quantum,static_cast<double>(b) * quantum
+      )
+    };
+    AppendVarint(m_data,a - prev_a);
+    AppendVarint(m_data,b - prev_b);
+    AppendVarint(m_data,Quantize(xyz[m_axis] - on_plane,quantum));
+    prev_a = a;
+    prev_b = b;
+  }
+  m_data.shrink_to_fit();
+}
+
+ribi::PlaneCompressedPoints::Coordinats3D ribi::PlaneCompressedPoints::Decompress(
+  const Plane& plane
+) const
+{
+  Coordinats3D points;
+  Decompress(plane,points);
+  return points;
+}
+
+void ribi::PlaneCompressedPoints::Decompress(
+  const Plane& plane,
+  Coordinats3D& points
+) const
+{
+  const int i_a{m_axis == 0 ? 1 : 0};
+  const int i_b{m_axis == 2 ? 1 : 2};
+  points.reserve(points.size() + m_n_points);
+  const std::uint8_t * p{m_data.data()};
+  std::int64_t a{0};
+  std::int64_t b{0};
+  for (std::size_t i=0; i!=m_n_points; ++i)
+  {
+    a += ReadVarint(p);
+    b += ReadVarint(p);
+    const std::int64_t residual{ReadVarint(p)};
+    double xyz[3];
+    xyz[i_a] = static_cast<double>(a) * m_quantum;
+    xyz[i_b] = static_cast<double>(b) * m_quantum;
+    xyz[m_axis]
+      = CalcCompressionDependent(plane,m_axis,xyz[i_a],xyz[i_b])
+      + (static_cast<double>(residual) * m_quantum)
+    ;
+    points.push_back(Coordinat3D(xyz[0],xyz[1],xyz[2]));
+  }
+  assert(p == m_data.data() + m_data.size());
+}
@@ -0,0 +1,76 @@
+#ifndef RIBI_PLANECOMPRESSEDPOINTS_H
+#define RIBI_PLANECOMPRESSEDPOINTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "plane.h"
+
+namespace ribi {
+
+///The points in or near a Plane, for example its inliers, compressed.
+///
+///The plane is expressed as a function of two coordinats, for example as
+///z(x,y) for a non-vertical plane. Per point, only these two coordinats
+///are stored, together with the residual of the third: the difference
+///between the actual z and z(x,y). All three are quantized to an integer
+///multiple of the quantum. The two coordinats are stored as the difference
+///with those of the previous point, as these are small for points in scan
+///order, and the residual is small for points near the plane. These
+///integers are stored as variable length integers, using one byte for
+///values in [-64,63], two bytes for values in [-8192,8191], etcetera.
+///
+///Decompressing gives each coordinat with an error of at most half the
+///quantum, in the original order of the points.
+struct PlaneCompressedPoints
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  typedef Plane::Coordinats3D Coordinats3D;
+
+  ///Compress the points, which should be in or near the plane.
+  ///Throws std::invalid_argument if the quantum is not positive.
+  ///Throws std::out_of_range if a coordinat is too big for the quantum
+  explicit PlaneCompressedPoints(
+    const Plane& plane,
+    const Coordinats3D& points,
+    const double quantum
+  );
+
+  ///Decompress all points, using the same plane as used to compress them
+  Coordinats3D Decompress(const Plane& plane) const;
+
+  ///Decompress all points to the end of the container, using the same
+  ///plane as used to compress them
+  void Decompress(const Plane& plane, Coordinats3D& points) const;
+
+  ///The coordinat that is stored as a residual, 0 for X, 1 for Y, 2 for Z
+  int GetAxis() const noexcept { return m_axis; }
+
+  ///The compressed points
+  const std::vector<std::uint8_t>& GetData() const noexcept { return m_data; }
+
+  ///The number of points
+  std::size_t GetSize() const noexcept { return m_n_points; }
+
+  ///The distance between two quantized values
+  double GetQuantum() const noexcept { return m_quantum; }
+
+  private:
+
+  int m_axis;
+
+  std::vector<std::uint8_t> m_data;
+
+  std::size_t m_n_points;
+
+  double m_quantum;
+};
+
+///The coordinat of the plane that is the function of the other two with the
+///smallest slope, 0 for X, 1 for Y, 2 for Z, as used by PlaneCompressedPoints
+int CalcCompressionAxis(const Plane& plane);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANECOMPRESSEDPOINTS_H
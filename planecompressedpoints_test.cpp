@@ -0,0 +1,78 @@
+#include "planecompressedpoints.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+///The largest difference of a coordinat between two sets of points
+static double CalcMaxDifference(const Plane::Coordinats3D& a, const Plane::Coordinats3D& b)
+{
+  BOOST_REQUIRE_EQUAL(a.size(),b.size());
+  double max{0.0};
+  for (std::size_t i=0; i!=a.size(); ++i)
+  {
+    max = std::max(max,std::abs(boost::geometry::get<0>(a[i]) - boost::geometry::get<0>(b[i])));
+    max = std::max(max,std::abs(boost::geometry::get<1>(a[i]) - boost::geometry::get<1>(b[i])));
+    max = std::max(max,std::abs(boost::geometry::get<2>(a[i]) - boost::geometry::get<2>(b[i])));
+  }
+  return max;
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planecompressedpoints_scan)
+{
+  //z = (0.2*x) + (0.3*y) + 5
+  const Plane p(Coordinat3D(0.0,0.0,5.0),Coordinat3D(1.0,0.0,5.2),Coordinat3D(0.0,1.0,5.3));
+  BOOST_CHECK_EQUAL(CalcCompressionAxis(p),2);
+  //Points in scan order, one centimeter apart, a few millimeters off the plane
+  Plane::Coordinats3D points;
+  for (int i=0; i!=100; ++i)
+  {
+    for (int j=0; j!=100; ++j)
+    {
+      const double x{j * 0.01};
+      const double y{i * 0.01};
+      const double noise{0.001 * ((i * 7 + j * 13) % 5 - 2)};
+      points.push_back(Coordinat3D(x,y,(0.2 * x) + (0.3 * y) + 5.0 + noise));
+    }
+  }
+  const double quantum{0.001};
+  const PlaneCompressedPoints c(p,points,quantum);
+  BOOST_CHECK_EQUAL(c.GetSize(),points.size());
+  //At least five times smaller than the Coordinat3D values
+  BOOST_CHECK_LE(c.GetData().size() * 5,points.size() * sizeof(Coordinat3D));
+  const auto decompressed = c.Decompress(p);
+  BOOST_CHECK_LE(CalcMaxDifference(points,decompressed),quantum * 0.5 * (1.0 + 1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planecompressedpoints_vertical)
+{
+  //x = 1, cannot be expressed as a function of x and y
+  const Plane p(Coordinat3D(1.0,0.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(1.0,0.0,1.0));
+  BOOST_CHECK_EQUAL(CalcCompressionAxis(p),0);
+  const Plane::Coordinats3D points{
+    Coordinat3D(1.0,-3.0,2.5),
+    Coordinat3D(1.01,1e6,-2.5),
+    Coordinat3D(0.99,-1e6,0.0)
+  };
+  const PlaneCompressedPoints c(p,points,0.01);
+  Plane::Coordinats3D decompressed{ Coordinat3D(9.0,9.0,9.0) };
+  c.Decompress(p,decompressed);
+  BOOST_REQUIRE_EQUAL(decompressed.size(),4);
+  decompressed.erase(decompressed.begin());
+  BOOST_CHECK_LE(CalcMaxDifference(points,decompressed),0.005 + 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planecompressedpoints_invalid)
+{
+  const Plane p(Coordinat3D(0.0,0.0,5.0),Coordinat3D(1.0,0.0,5.2),Coordinat3D(0.0,1.0,5.3));
+  const Plane::Coordinats3D points{ Coordinat3D(1e300,0.0,5.0) };
+  BOOST_CHECK_THROW(PlaneCompressedPoints(p,points,0.0),std::invalid_argument);
+  BOOST_CHECK_THROW(PlaneCompressedPoints(p,points,0.001),std::out_of_range);
+  BOOST_CHECK(PlaneCompressedPoints(p,{},0.001).Decompress(p).empty());
+}
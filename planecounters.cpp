@@ -0,0 +1,79 @@
+#include "planecounters.h"
+
+#include <cassert>
+#include <ostream>
+#include <vector>
+
+#include "planethreadregistry.h"
+
+namespace ribi {
+
+typedef PlaneThreadRegistry<PlaneThreadCounters,PlaneCounterSnapshot> PlaneCounterRegistry;
+
+} //~namespace ribi
+
+ribi::PlaneThreadCounters::PlaneThreadCounters()
+  : m_values{}
+{
+  for (auto& value: m_values) value.store(0,std::memory_order_relaxed);
+  PlaneCounterRegistry::Get().Add(*this);
+}
+
+ribi::PlaneThreadCounters::~PlaneThreadCounters()
+{
+  PlaneCounterRegistry::Get().Remove(
+    *this,
+    [this](PlaneCounterSnapshot& exited)
+    {
+      for (std::size_t i=0; i!=m_values.size(); ++i)
+      {
+        exited.m_values[i] += m_values[i].load(std::memory_order_relaxed);
+      }
+    }
+  );
+}
+
+ribi::PlaneCounterSnapshot ribi::GetPlaneCounters()
+{
+  return PlaneCounterRegistry::Get().Read(
+    [](const PlaneCounterSnapshot& exited, const std::vector<const PlaneThreadCounters *>& threads)
+    {
+      PlaneCounterSnapshot snapshot = exited;
+      for (const PlaneThreadCounters * const thread: threads)
+      {
+        for (std::size_t i=0; i!=snapshot.m_values.size(); ++i)
+        {
+          snapshot.m_values[i] += thread->m_values[i].load(std::memory_order_relaxed);
+        }
+      }
+      return snapshot;
+    }
+  );
+}
+
+const char * ribi::ToStr(const PlaneCounter counter) noexcept
+{
+  switch (counter)
+  {
+    case PlaneCounter::plane_x_created: return "plane_x_created";
+    case PlaneCounter::plane_y_created: return "plane_y_created";
+    case PlaneCounter::plane_z_created: return "plane_z_created";
+    case PlaneCounter::plane_x_failed: return "plane_x_failed";
+    case PlaneCounter::plane_y_failed: return "plane_y_failed";
+    case PlaneCounter::plane_z_failed: return "plane_z_failed";
+    case PlaneCounter::exceptions_caught: return "exceptions_caught";
+    case PlaneCounter::projection_fallbacks: return "projection_fallbacks";
+    case PlaneCounter::n_counters: break;
+  }
+  assert(!"Should not get here");
+  return "";
+}
+
+std::ostream& ribi::operator<<(std::ostream& os, const PlaneCounterSnapshot& snapshot)
+{
+  for (std::size_t i=0; i!=snapshot.m_values.size(); ++i)
+  {
+    os << ToStr(static_cast<PlaneCounter>(i)) << ' ' << snapshot.m_values[i] << '\n';
+  }
+  return os;
+}
@@ -0,0 +1,95 @@
+#ifndef RIBI_PLANECOUNTERS_H
+#define RIBI_PLANECOUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace ribi {
+
+///The events counted on the hot paths of Plane
+enum class PlaneCounter
+{
+  ///PlaneX, PlaneY and PlaneZ created by CreatePlaneX, CreatePlaneY and CreatePlaneZ
+  plane_x_created,
+  plane_y_created,
+  plane_z_created,
+
+  ///CreatePlaneX, CreatePlaneY and CreatePlaneZ that failed,
+  ///because the plane cannot be expressed in that orientation
+  plane_x_failed,
+  plane_y_failed,
+  plane_z_failed,
+
+  ///Exceptions thrown and caught within Plane
+  exceptions_caught,
+
+  ///Plane::CalcProjection falling back to the next orientation
+  ///after the previous one threw
+  projection_fallbacks,
+
+  ///The number of counters, not a counter itself
+  n_counters
+};
+
+///The total of each counter over all threads, as obtained by GetPlaneCounters
+struct PlaneCounterSnapshot
+{
+  std::array<std::uint64_t,static_cast<std::size_t>(PlaneCounter::n_counters)> m_values;
+
+  std::uint64_t Get(const PlaneCounter counter) const noexcept
+  {
+    return m_values[static_cast<std::size_t>(counter)];
+  }
+};
+
+///The counters of one thread, registered in a PlaneThreadRegistry.
+///Incrementing needs no atomic read-modify-write or lock
+struct PlaneThreadCounters
+{
+  PlaneThreadCounters();
+  PlaneThreadCounters(const PlaneThreadCounters&) = delete;
+  PlaneThreadCounters& operator=(const PlaneThreadCounters&) = delete;
+  ///Adds the counters to those of exited threads
+  ~PlaneThreadCounters();
+
+  void Increment(const PlaneCounter counter) noexcept
+  {
+    std::atomic<std::uint64_t>& value = m_values[static_cast<std::size_t>(counter)];
+    value.store(value.load(std::memory_order_relaxed) + 1,std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<std::uint64_t>,static_cast<std::size_t>(PlaneCounter::n_counters)> m_values;
+};
+
+///The counters of the calling thread
+inline PlaneThreadCounters& GetPlaneThreadCounters()
+{
+  thread_local PlaneThreadCounters counters;
+  return counters;
+}
+
+///The total of each counter over all threads, including exited threads.
+///Counters of running threads may be incremented while taking the snapshot
+PlaneCounterSnapshot GetPlaneCounters();
+
+///The name of a counter, for example to export it to a metrics system
+const char * ToStr(const PlaneCounter counter) noexcept;
+
+///Writes each counter as 'name value' on a line of its own
+std::ostream& operator<<(std::ostream& os, const PlaneCounterSnapshot& snapshot);
+
+} //~namespace ribi
+
+///Count an event, for example RIBI_PLANE_COUNT(exceptions_caught).
+///Define RIBI_PLANE_NO_COUNTERS to compile counting out
+#ifdef RIBI_PLANE_NO_COUNTERS
+#define RIBI_PLANE_COUNT(counter) ((void)0)
+#else
+#define RIBI_PLANE_COUNT(counter) \
+  ::ribi::GetPlaneThreadCounters().Increment(::ribi::PlaneCounter::counter)
+#endif
+
+#endif // RIBI_PLANECOUNTERS_H
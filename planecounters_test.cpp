@@ -0,0 +1,108 @@
+#include "planecounters.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+#ifndef RIBI_PLANE_NO_COUNTERS
+
+///The increase of a counter between two snapshots
+static std::uint64_t CalcIncrease(
+  const PlaneCounterSnapshot& before,
+  const PlaneCounterSnapshot& after,
+  const PlaneCounter counter
+)
+{
+  return after.Get(counter) - before.Get(counter);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planecounters_construction)
+{
+  const PlaneCounterSnapshot before{GetPlaneCounters()};
+  //z = 1, cannot be expressed as a PlaneX or a PlaneY
+  const Plane p(Coordinat3D(0.0,0.0,1.0),Coordinat3D(1.0,0.0,1.0),Coordinat3D(0.0,1.0,1.0));
+  const PlaneCounterSnapshot after{GetPlaneCounters()};
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::plane_x_created),0);
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::plane_x_failed),1);
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::plane_y_failed),1);
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::plane_z_created),1);
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::plane_z_failed),0);
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::exceptions_caught),2);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planecounters_threads)
+{
+  //The counters of a thread that has exited are kept
+  const PlaneCounterSnapshot before{GetPlaneCounters()};
+  std::thread t(
+    []()
+    {
+      for (int i=0; i!=10; ++i)
+      {
+        const Plane p(Coordinat3D(0.0,0.0,1.0),Coordinat3D(1.0,0.0,2.0),Coordinat3D(0.0,1.0,3.0));
+      }
+    }
+  );
+  t.join();
+  const PlaneCounterSnapshot after{GetPlaneCounters()};
+  BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::plane_z_created),10);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planecounters_projection_fallbacks)
+{
+  //Only X and Y throw, so there are two fallbacks, to Y and to Z
+  const auto f = [](const int orientation)
+  {
+    if (orientation != 2) throw std::logic_error("cannot project");
+    return orientation;
+  };
+  {
+    const PlaneCounterSnapshot before{GetPlaneCounters()};
+    BOOST_CHECK_EQUAL(CalcWithPlaneFallback({true,true,true},f),2);
+    const PlaneCounterSnapshot after{GetPlaneCounters()};
+    BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::projection_fallbacks),2);
+    BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::exceptions_caught),2);
+  }
+  //Without a next orientation, there is nothing to fall back to
+  {
+    const PlaneCounterSnapshot before{GetPlaneCounters()};
+    BOOST_CHECK_THROW(CalcWithPlaneFallback({true,false,false},f),std::logic_error);
+    BOOST_CHECK_THROW(CalcWithPlaneFallback({false,false,false},f),std::logic_error);
+    BOOST_CHECK_EQUAL(CalcWithPlaneFallback({false,false,true},f),2);
+    const PlaneCounterSnapshot after{GetPlaneCounters()};
+    BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::projection_fallbacks),0);
+  }
+  //A projection that succeeds on the first orientation falls back to nothing
+  {
+    //z = 1
+    const Plane p(Coordinat3D(0.0,0.0,1.0),Coordinat3D(1.0,0.0,1.0),Coordinat3D(0.0,1.0,1.0));
+    const PlaneCounterSnapshot before{GetPlaneCounters()};
+    p.CalcProjection(Coordinat3D(2.0,3.0,1.0));
+    const PlaneCounterSnapshot after{GetPlaneCounters()};
+    BOOST_CHECK_EQUAL(CalcIncrease(before,after,PlaneCounter::projection_fallbacks),0);
+  }
+}
+
+#endif // RIBI_PLANE_NO_COUNTERS
+
+BOOST_AUTO_TEST_CASE(ribi_planecounters_names)
+{
+  std::stringstream s;
+  s << GetPlaneCounters();
+  std::string name;
+  std::uint64_t value{0};
+  int n{0};
+  while (s >> name >> value)
+  {
+    BOOST_CHECK_EQUAL(name,ToStr(static_cast<PlaneCounter>(n)));
+    ++n;
+  }
+  BOOST_CHECK_EQUAL(n,static_cast<int>(PlaneCounter::n_counters));
+}
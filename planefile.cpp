@@ -0,0 +1,155 @@
+#include "planefile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "plane.h"
+
+namespace ribi {
+
+static const char plane_file_magic[8] = { 'r','i','b','i','p','l','n','s' };
+
+static const std::uint32_t plane_file_byte_order{0x01020304};
+
+///Copy four coefficients to a vector, or give an empty vector
+///if the Plane cannot be expressed in that form
+static std::vector<double> CreateCoefficients(
+  const double * const coefficients,
+  const bool is_valid
+)
+{
+  if (!is_valid) return {};
+  return std::vector<double>(coefficients,coefficients + 4);
+}
+
+///Copy four coefficients from a vector
+static void CopyCoefficients(const std::vector<double>& from, double * const to)
+{
+  assert(from.size() == 4);
+  std::copy(std::begin(from),std::end(from),to);
+}
+
+} //~namespace ribi
+
+ribi::PlaneFile::PlaneFile(const std::string& filename)
+  : m_file(filename),
+    m_records{nullptr},
+    m_size{0}
+{
+  if (m_file.GetSize() < sizeof(PlaneFileHeader))
+  {
+    throw std::runtime_error("PlaneFile: file '" + filename + "' is too short to be a plane-set file");
+  }
+  PlaneFileHeader header;
+  std::memcpy(&header,m_file.GetData(),sizeof(header));
+  if (std::memcmp(header.m_magic,plane_file_magic,sizeof(plane_file_magic)) != 0)
+  {
+    throw std::runtime_error("PlaneFile: file '" + filename + "' is not a plane-set file");
+  }
+  if (header.m_byte_order != plane_file_byte_order)
+  {
+    throw std::runtime_error("PlaneFile: file '" + filename + "' has a different byte order");
+  }
+  if (header.m_version != m_version || header.m_record_size != sizeof(PlaneRecord))
+  {
+    throw std::runtime_error("PlaneFile: file '" + filename + "' has an unsupported version");
+  }
+  if (header.m_n_planes != (m_file.GetSize() - sizeof(PlaneFileHeader)) / sizeof(PlaneRecord)
+    || (m_file.GetSize() - sizeof(PlaneFileHeader)) % sizeof(PlaneRecord) != 0
+  )
+  {
+    throw std::runtime_error("PlaneFile: file '" + filename + "' has an incorrect size");
+  }
+  //The mapping starts at a page boundary, so the records are aligned
+  m_records = reinterpret_cast<const PlaneRecord*>(m_file.GetData() + sizeof(PlaneFileHeader));
+  m_size = static_cast<std::size_t>(header.m_n_planes);
+}
+
+std::unique_ptr<ribi::Plane> ribi::PlaneFile::CreatePlane(const std::size_t i) const
+{
+  return ribi::CreatePlane(GetRecord(i));
+}
+
+const ribi::PlaneRecord& ribi::PlaneFile::GetRecord(const std::size_t i) const noexcept
+{
+  assert(i < m_size);
+  return m_records[i];
+}
+
+std::unique_ptr<ribi::Plane> ribi::CreatePlane(const PlaneRecord& record)
+{
+  const Plane::Coordinats3D points{
+    Plane::Coordinat3D(record.m_points[0][0],record.m_points[0][1],record.m_points[0][2]),
+    Plane::Coordinat3D(record.m_points[1][0],record.m_points[1][1],record.m_points[1][2]),
+    Plane::Coordinat3D(record.m_points[2][0],record.m_points[2][1],record.m_points[2][2])
+  };
+  std::unique_ptr<Plane> plane(
+    new Plane(
+      CreateCoefficients(record.m_coefficients_x,record.m_flags & PlaneRecord::m_can_calc_x),
+      CreateCoefficients(record.m_coefficients_y,record.m_flags & PlaneRecord::m_can_calc_y),
+      CreateCoefficients(record.m_coefficients_z,record.m_flags & PlaneRecord::m_can_calc_z),
+      points
+    )
+  );
+  assert(plane);
+  return plane;
+}
+
+ribi::PlaneRecord ribi::CreatePlaneRecord(const Plane& plane)
+{
+  PlaneRecord record;
+  std::memset(&record,0,sizeof(record));
+  if (plane.CanCalcX())
+  {
+    record.m_flags |= PlaneRecord::m_can_calc_x;
+    CopyCoefficients(plane.GetCoefficientsX(),record.m_coefficients_x);
+  }
+  if (plane.CanCalcY())
+  {
+    record.m_flags |= PlaneRecord::m_can_calc_y;
+    CopyCoefficients(plane.GetCoefficientsY(),record.m_coefficients_y);
+  }
+  if (plane.CanCalcZ())
+  {
+    record.m_flags |= PlaneRecord::m_can_calc_z;
+    CopyCoefficients(plane.GetCoefficientsZ(),record.m_coefficients_z);
+  }
+  const auto& points = plane.GetPoints();
+  assert(points.size() == 3);
+  for (int i=0; i!=3; ++i)
+  {
+    record.m_points[i][0] = boost::geometry::get<0>(points[i]);
+    record.m_points[i][1] = boost::geometry::get<1>(points[i]);
+    record.m_points[i][2] = boost::geometry::get<2>(points[i]);
+  }
+  return record;
+}
+
+void ribi::SavePlaneFile(const std::string& filename, const std::vector<PlaneRecord>& records)
+{
+  PlaneFileHeader header;
+  std::memset(&header,0,sizeof(header));
+  std::memcpy(header.m_magic,plane_file_magic,sizeof(plane_file_magic));
+  header.m_version = PlaneFile::m_version;
+  header.m_byte_order = plane_file_byte_order;
+  header.m_record_size = sizeof(PlaneRecord);
+  header.m_n_planes = records.size();
+
+  std::ofstream f(filename.c_str(),std::ios::binary);
+  f.write(reinterpret_cast<const char*>(&header),sizeof(header));
+  if (!records.empty())
+  {
+    f.write(
+      reinterpret_cast<const char*>(records.data()),
+      static_cast<std::streamsize>(records.size() * sizeof(PlaneRecord))
+    );
+  }
+  f.close();
+  if (!f)
+  {
+    throw std::runtime_error("SavePlaneFile: cannot write file '" + filename + "'");
+  }
+}
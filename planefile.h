@@ -0,0 +1,127 @@
+#ifndef RIBI_PLANEFILE_H
+#define RIBI_PLANEFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "planemappedfile.h"
+
+namespace ribi {
+
+struct Plane;
+
+///A Plane as stored in a plane-set file: all that is needed to create
+///a Plane without recalculating its coefficients. It is a plain struct
+///of fixed size, so it can be read directly from a memory-mapped file
+struct PlaneRecord
+{
+  ///Flags in m_flags: can the Plane be expressed as X, Y or Z
+  static constexpr std::uint32_t m_can_calc_x{1};
+  static constexpr std::uint32_t m_can_calc_y{2};
+  static constexpr std::uint32_t m_can_calc_z{4};
+
+  ///The coefficients as obtained by Plane::GetCoefficientsX,
+  ///only valid if m_can_calc_x is set
+  double m_coefficients_x[4];
+
+  ///The coefficients as obtained by Plane::GetCoefficientsY,
+  ///only valid if m_can_calc_y is set
+  double m_coefficients_y[4];
+
+  ///The coefficients as obtained by Plane::GetCoefficientsZ,
+  ///only valid if m_can_calc_z is set
+  double m_coefficients_z[4];
+
+  ///The X, Y and Z of the three points the Plane is constructed from
+  double m_points[3][3];
+
+  ///Which of the coefficients are valid
+  std::uint32_t m_flags;
+
+  ///Unused, keeps the size a multiple of eight
+  std::uint32_t m_padding;
+};
+
+static_assert(std::is_trivially_copyable<PlaneRecord>::value,"PlaneRecord must be read from memory directly");
+static_assert(sizeof(PlaneRecord) == 176,"PlaneRecord must have no compiler dependent padding");
+
+///The start of a plane-set file, followed by GetSize() PlaneRecords
+struct PlaneFileHeader
+{
+  ///Always 'ribiplns'
+  char m_magic[8];
+
+  ///The version of the file format
+  std::uint32_t m_version;
+
+  ///The value 0x01020304, as written by the machine that wrote the file,
+  ///to detect a file written with a different byte order
+  std::uint32_t m_byte_order;
+
+  ///Must equal sizeof(PlaneRecord)
+  std::uint32_t m_record_size;
+
+  ///Unused, keeps the PlaneRecords aligned
+  std::uint32_t m_padding;
+
+  ///The number of PlaneRecords
+  std::uint64_t m_n_planes;
+};
+
+static_assert(sizeof(PlaneFileHeader) == 32,"PlaneFileHeader must have no compiler dependent padding");
+
+///A plane-set file, memory-mapped for as long as the PlaneFile exists.
+///Loading it does not read the PlaneRecords: these are paged in when
+///used. Use CreatePlane to create a Plane from a PlaneRecord,
+///which does not recalculate its coefficients from its points
+///
+///Use SavePlaneFile to create a plane-set file
+struct PlaneFile
+{
+  ///Memory-maps the file.
+  ///Throws std::runtime_error if the file cannot be opened,
+  ///or is not a plane-set file of this version and byte order
+  explicit PlaneFile(const std::string& filename);
+
+  ///Create the Plane of the PlaneRecord at the index
+  std::unique_ptr<Plane> CreatePlane(const std::size_t i) const;
+
+  ///The PlaneRecord at the index, read directly from the mapped file
+  const PlaneRecord& GetRecord(const std::size_t i) const noexcept;
+
+  ///All PlaneRecords, read directly from the mapped file
+  const PlaneRecord * GetRecords() const noexcept { return m_records; }
+
+  ///The number of PlaneRecords
+  std::size_t GetSize() const noexcept { return m_size; }
+
+  ///The version of the file format
+  static constexpr std::uint32_t m_version{1};
+
+  private:
+
+  PlaneMappedFile m_file;
+
+  const PlaneRecord * m_records;
+
+  std::size_t m_size;
+};
+
+///Create the Plane of a PlaneRecord, without recalculating
+///its coefficients from its points
+std::unique_ptr<Plane> CreatePlane(const PlaneRecord& record);
+
+///Create the PlaneRecord to store a Plane
+PlaneRecord CreatePlaneRecord(const Plane& plane);
+
+///Save the PlaneRecords as a plane-set file, that can be loaded by PlaneFile.
+///Throws std::runtime_error if the file cannot be written
+void SavePlaneFile(const std::string& filename, const std::vector<PlaneRecord>& records);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEFILE_H
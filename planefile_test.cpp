@@ -0,0 +1,66 @@
+#include "planefile.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planefile_save_and_load)
+{
+  const std::string filename{"ribi_planefile_save_and_load.bin"};
+  //z = (2*x) + (3*y) + 5, the vertical x = 1 and the vertical y = 1
+  const Plane a(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  const Plane b(Coordinat3D(1.0,0.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(1.0,0.0,1.0));
+  const Plane c(Coordinat3D(0.0,1.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(0.0,1.0,1.0));
+  SavePlaneFile(filename, { CreatePlaneRecord(a), CreatePlaneRecord(b), CreatePlaneRecord(c) });
+  {
+    const PlaneFile f(filename);
+    BOOST_CHECK_EQUAL(f.GetSize(),3);
+    for (const Plane * const p: { &a, &b, &c })
+    {
+      const auto i = static_cast<std::size_t>(p == &a ? 0 : (p == &b ? 1 : 2));
+      const auto q = f.CreatePlane(i);
+      BOOST_CHECK(p->CanCalcX() == q->CanCalcX());
+      BOOST_CHECK(p->CanCalcY() == q->CanCalcY());
+      BOOST_CHECK(p->CanCalcZ() == q->CanCalcZ());
+      if (p->CanCalcX()) { BOOST_CHECK(p->GetCoefficientsX() == q->GetCoefficientsX()); }
+      if (p->CanCalcY()) { BOOST_CHECK(p->GetCoefficientsY() == q->GetCoefficientsY()); }
+      if (p->CanCalcZ()) { BOOST_CHECK(p->GetCoefficientsZ() == q->GetCoefficientsZ()); }
+      BOOST_CHECK(p->GetPoints().size() == q->GetPoints().size());
+      for (const auto& point: p->GetPoints())
+      {
+        BOOST_CHECK(q->IsInPlane(point));
+      }
+    }
+    BOOST_CHECK(!f.CreatePlane(1)->IsInPlane(Coordinat3D(1.1,2.0,3.0)));
+    BOOST_CHECK( f.CreatePlane(2)->IsInPlane(Coordinat3D(2.0,1.0,3.0)));
+    BOOST_CHECK(f.GetRecord(0).m_flags == f.GetRecords()[0].m_flags);
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planefile_empty)
+{
+  const std::string filename{"ribi_planefile_empty.bin"};
+  SavePlaneFile(filename, {});
+  BOOST_CHECK_EQUAL(PlaneFile(filename).GetSize(),0);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planefile_rejects_other_files)
+{
+  BOOST_CHECK_THROW(PlaneFile("ribi_planefile_does_not_exist.bin"),std::runtime_error);
+  const std::string filename{"ribi_planefile_rejects_other_files.bin"};
+  {
+    std::ofstream f(filename.c_str());
+    f << "This is not a plane-set file, but it is long enough to have a header";
+  }
+  BOOST_CHECK_THROW(PlaneFile{filename},std::runtime_error);
+  std::remove(filename.c_str());
+}
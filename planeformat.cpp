@@ -0,0 +1,30 @@
+#include "planeformat.h"
+
+#include <cassert>
+#include <cstring>
+
+char * ribi::WriteChars(char * const first, char * const last, const char * const text) noexcept
+{
+  assert(text);
+  if (!first) return nullptr;
+  assert(first <= last);
+  const std::size_t size{std::strlen(text)};
+  if (static_cast<std::size_t>(last - first) < size) return nullptr;
+  std::memcpy(first,text,size);
+  return first + size;
+}
+
+char * ribi::WriteChars(char * const first, char * const last, const double x) noexcept
+{
+  if (!first) return nullptr;
+  assert(first <= last);
+  const std::to_chars_result result{std::to_chars(first,last,x)};
+  if (result.ec != std::errc()) return nullptr;
+  return result.ptr;
+}
+
+std::to_chars_result ribi::ToCharsResult(char * const p, char * const last) noexcept
+{
+  if (!p) return { last, std::errc::value_too_large };
+  return { p, std::errc() };
+}
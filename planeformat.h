@@ -0,0 +1,30 @@
+#ifndef RIBI_PLANEFORMAT_H
+#define RIBI_PLANEFORMAT_H
+
+#include <charconv>
+
+namespace ribi {
+
+//Writing text to a caller buffer without allocating, for the ToFunction
+//and ToStr overloads that take a buffer. Each WriteChars writes to
+//[first,last) and returns the end of what it has written, or nullptr if it
+//does not fit. A WriteChars given a nullptr writes nothing and gives nullptr,
+//so these can be chained:
+//
+//  char * p = WriteChars(first,last,"z=(");
+//  p = WriteChars(p,last,a);
+//  return ToCharsResult(p,last);
+
+///Writes the text, without its terminating zero
+char * WriteChars(char * const first, char * const last, const char * const text) noexcept;
+
+///Writes the double in its shortest notation that reads back to the same value
+char * WriteChars(char * const first, char * const last, const double x) noexcept;
+
+///Convert the end of a chain of WriteChars to the result of std::to_chars:
+///the end with no error, or last with std::errc::value_too_large
+std::to_chars_result ToCharsResult(char * const p, char * const last) noexcept;
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEFORMAT_H
@@ -0,0 +1,70 @@
+#include "planeformat.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planeformat_write_chars)
+{
+  char buffer[32];
+  char * const last{buffer + sizeof(buffer)};
+  char * p{WriteChars(buffer,last,"x=")};
+  p = WriteChars(p,last,1.0 / 3.0);
+  BOOST_REQUIRE(p);
+  const std::string s(buffer,p);
+  BOOST_CHECK_EQUAL(s.substr(0,2),"x=");
+  //Shortest notation that reads back to the same value
+  BOOST_CHECK_EQUAL(std::strtod(s.substr(2).c_str(),nullptr),1.0 / 3.0);
+  BOOST_CHECK_EQUAL(std::string(buffer,WriteChars(buffer,last,2.5)),"2.5");
+  //Does not fit, and stays not fitting
+  BOOST_CHECK(!WriteChars(buffer,buffer + 2,"abc"));
+  BOOST_CHECK(!WriteChars(nullptr,last,"abc"));
+  BOOST_CHECK(ToCharsResult(nullptr,last).ec == std::errc::value_too_large);
+  BOOST_CHECK(ToCharsResult(nullptr,last).ptr == last);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeformat_to_function_is_same_as_stream)
+{
+  char buffer[128];
+  char * const last{buffer + sizeof(buffer)};
+  //z = (2*x) + (3*y) + 5
+  const PlaneZ z(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  const auto result = z.ToFunction(buffer,last);
+  BOOST_REQUIRE(result.ec == std::errc());
+  BOOST_CHECK_EQUAL(std::string(buffer,result.ptr),z.ToFunction());
+  BOOST_CHECK_EQUAL(std::string(buffer,result.ptr),"z=(2*x) + (3*y) + 5");
+
+  const PlaneX x(Coordinat3D(1.0,0.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(1.0,0.0,1.0));
+  const auto result_x = x.ToFunction(buffer,last);
+  BOOST_REQUIRE(result_x.ec == std::errc());
+  BOOST_CHECK_EQUAL(std::string(buffer,result_x.ptr),x.ToFunction());
+
+  const PlaneY y(Coordinat3D(0.0,1.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(0.0,1.0,1.0));
+  const auto result_y = y.ToFunction(buffer,last);
+  BOOST_REQUIRE(result_y.ec == std::errc());
+  BOOST_CHECK_EQUAL(std::string(buffer,result_y.ptr),y.ToFunction());
+
+  BOOST_CHECK(z.ToFunction(buffer,buffer + 10).ec == std::errc::value_too_large);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeformat_plane_to_str)
+{
+  char buffer[256];
+  char * const last{buffer + sizeof(buffer)};
+  //The vertical plane x = 1
+  const Plane p(Coordinat3D(1.0,0.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(1.0,0.0,1.0));
+  const auto result = p.ToStr(buffer,last);
+  BOOST_REQUIRE(result.ec == std::errc());
+  BOOST_CHECK_EQUAL(
+    std::string(buffer,result.ptr),
+    "((1,0,0),(1,1,0),(1,0,1)),x=(0*y) + (0*z) + 1,null,null"
+  );
+  BOOST_CHECK(p.ToStr(buffer,buffer + 20).ec == std::errc::value_too_large);
+}
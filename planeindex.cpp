@@ -0,0 +1,297 @@
+#include "planeindex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ribi {
+
+static const char plane_index_magic[8] = { 'r','i','b','i','p','l','n','i' };
+static const std::uint32_t plane_index_byte_order{0x01020304};
+
+///The number of bytes a block is rounded up to
+static const std::uint64_t plane_index_alignment{64};
+
+///The maximum number of cells along an axis
+static const std::uint32_t plane_index_max_cells{1024};
+
+static std::uint64_t RoundUpIndex(const std::uint64_t n) noexcept
+{
+  return ((n + plane_index_alignment - 1) / plane_index_alignment) * plane_index_alignment;
+}
+
+///The cell along an axis of a value, clamped to the grid
+static std::uint32_t CalcCellClamped(
+  const PlaneIndexHeader& header,
+  const int axis,
+  const double value
+) noexcept
+{
+  const double t{std::floor((value - header.m_min[axis]) / header.m_cell_size[axis])};
+  if (!(t > 0.0)) return 0;
+  const double last{static_cast<double>(header.m_n_cells[axis] - 1)};
+  return static_cast<std::uint32_t>(std::min(t,last));
+}
+
+///Choose the number and size of the cells so that the grid covers
+///the boxes, with about n_cells cubic cells
+static void CalcPlaneIndexGrid(
+  PlaneIndexHeader& header,
+  const double min[3],
+  const double max[3],
+  const double n_cells
+) noexcept
+{
+  int n_dimensions{0};
+  double volume{1.0};
+  for (int axis=0; axis!=3; ++axis)
+  {
+    if (max[axis] > min[axis])
+    {
+      ++n_dimensions;
+      volume *= max[axis] - min[axis];
+    }
+  }
+  const double cell_size{
+    n_dimensions == 0 ? 1.0 : std::pow(volume / std::max(1.0,n_cells),1.0 / n_dimensions)
+  };
+  for (int axis=0; axis!=3; ++axis)
+  {
+    const double extent{max[axis] - min[axis]};
+    header.m_min[axis] = min[axis];
+    if (extent > 0.0)
+    {
+      const double n{std::ceil(extent / cell_size)};
+      header.m_n_cells[axis] = static_cast<std::uint32_t>(
+        std::max(1.0,std::min(n,static_cast<double>(plane_index_max_cells)))
+      );
+      header.m_cell_size[axis] = extent / header.m_n_cells[axis];
+    }
+    else
+    {
+      header.m_n_cells[axis] = 1;
+      header.m_cell_size[axis] = 1.0;
+    }
+  }
+}
+
+} //~namespace ribi
+
+ribi::PlaneIndex::PlaneIndex(const std::string& filename)
+  : m_boxes{nullptr},
+    m_cell_offsets{nullptr},
+    m_file(filename),
+    m_header{},
+    m_indices{nullptr}
+{
+  if (m_file.GetSize() < sizeof(PlaneIndexHeader))
+  {
+    throw std::runtime_error("PlaneIndex: file '" + filename + "' is too short to be a plane index file");
+  }
+  std::memcpy(&m_header,m_file.GetData(),sizeof(m_header));
+  if (std::memcmp(m_header.m_magic,plane_index_magic,sizeof(plane_index_magic)) != 0)
+  {
+    throw std::runtime_error("PlaneIndex: file '" + filename + "' is not a plane index file");
+  }
+  if (m_header.m_byte_order != plane_index_byte_order)
+  {
+    throw std::runtime_error("PlaneIndex: file '" + filename + "' has a different byte order");
+  }
+  if (m_header.m_version != m_version)
+  {
+    throw std::runtime_error("PlaneIndex: file '" + filename + "' has an unsupported version");
+  }
+  for (int axis=0; axis!=3; ++axis)
+  {
+    if (m_header.m_n_cells[axis] == 0 || m_header.m_n_cells[axis] > plane_index_max_cells)
+    {
+      throw std::runtime_error("PlaneIndex: file '" + filename + "' has an incorrect number of cells");
+    }
+  }
+  //At most 2^30 cells, so the sizes below cannot wrap around
+  const std::uint64_t n_cells{
+    static_cast<std::uint64_t>(m_header.m_n_cells[0]) * m_header.m_n_cells[1] * m_header.m_n_cells[2]
+  };
+  if (m_header.m_n_indices > m_file.GetSize() / sizeof(std::uint32_t)
+    || m_header.m_n_planes > m_file.GetSize() / (6 * sizeof(double))
+    || m_header.m_cell_offsets_offset != sizeof(PlaneIndexHeader)
+    || m_header.m_indices_offset != m_header.m_cell_offsets_offset + RoundUpIndex((n_cells + 1) * sizeof(std::uint64_t))
+    || m_header.m_boxes_offset != m_header.m_indices_offset + RoundUpIndex(m_header.m_n_indices * sizeof(std::uint32_t))
+    || m_file.GetSize() != m_header.m_boxes_offset + (m_header.m_n_planes * 6 * sizeof(double))
+  )
+  {
+    throw std::runtime_error("PlaneIndex: file '" + filename + "' has an incorrect size");
+  }
+  //The mapping starts at a page boundary, so all blocks are aligned
+  const char * const data{m_file.GetData()};
+  m_cell_offsets = reinterpret_cast<const std::uint64_t*>(data + m_header.m_cell_offsets_offset);
+  m_indices = reinterpret_cast<const std::uint32_t*>(data + m_header.m_indices_offset);
+  m_boxes = reinterpret_cast<const double*>(data + m_header.m_boxes_offset);
+}
+
+std::vector<std::uint32_t> ribi::PlaneIndex::FindPlanes(const Coordinat3D& coordinat) const
+{
+  const double xyz[3] = {
+    boost::geometry::get<0>(coordinat),
+    boost::geometry::get<1>(coordinat),
+    boost::geometry::get<2>(coordinat)
+  };
+  std::vector<std::uint32_t> v;
+  const auto candidates = GetCandidates(coordinat);
+  for (const std::uint32_t * i = candidates.first; i != candidates.second; ++i)
+  {
+    if (*i >= m_header.m_n_planes)
+    {
+      throw std::runtime_error("PlaneIndex: plane index out of range, the file is corrupt");
+    }
+    const double * const box{m_boxes + (6 * static_cast<std::size_t>(*i))};
+    if (box[0] <= xyz[0] && xyz[0] <= box[3]
+      && box[1] <= xyz[1] && xyz[1] <= box[4]
+      && box[2] <= xyz[2] && xyz[2] <= box[5]
+    )
+    {
+      v.push_back(*i);
+    }
+  }
+  return v;
+}
+
+std::pair<const std::uint32_t *, const std::uint32_t *> ribi::PlaneIndex::GetCandidates(
+  const Coordinat3D& coordinat
+) const
+{
+  const double xyz[3] = {
+    boost::geometry::get<0>(coordinat),
+    boost::geometry::get<1>(coordinat),
+    boost::geometry::get<2>(coordinat)
+  };
+  std::uint64_t cell[3];
+  for (int axis=0; axis!=3; ++axis)
+  {
+    const double t{(xyz[axis] - m_header.m_min[axis]) / m_header.m_cell_size[axis]};
+    //Also rejects NaN
+    if (!(t >= 0.0 && t <= static_cast<double>(m_header.m_n_cells[axis])))
+    {
+      return std::make_pair(m_indices,m_indices);
+    }
+    cell[axis] = std::min(static_cast<std::uint64_t>(t),static_cast<std::uint64_t>(m_header.m_n_cells[axis] - 1));
+  }
+  const std::uint64_t i{
+    cell[0] + (m_header.m_n_cells[0] * (cell[1] + (m_header.m_n_cells[1] * cell[2])))
+  };
+  const std::uint64_t first{m_cell_offsets[i]};
+  const std::uint64_t last{m_cell_offsets[i + 1]};
+  if (first > last || last > m_header.m_n_indices)
+  {
+    throw std::runtime_error("PlaneIndex: cell offsets out of range, the file is corrupt");
+  }
+  return std::make_pair(m_indices + first,m_indices + last);
+}
+
+void ribi::SavePlaneIndex(
+  const std::string& filename,
+  const std::vector<PlaneRecord>& records,
+  const double margin,
+  const double cells_per_plane
+)
+{
+  if (!(margin >= 0.0))
+  {
+    throw std::invalid_argument("SavePlaneIndex: margin must be zero or positive");
+  }
+  if (!(cells_per_plane > 0.0))
+  {
+    throw std::invalid_argument("SavePlaneIndex: cells_per_plane must be positive");
+  }
+  if (records.size() > std::numeric_limits<std::uint32_t>::max())
+  {
+    throw std::invalid_argument("SavePlaneIndex: too many planes");
+  }
+  const std::size_t n_planes{records.size()};
+
+  //The enlarged boxes, and the box around all of them
+  std::vector<double> boxes(6 * n_planes);
+  double min[3] = { 0.0, 0.0, 0.0 };
+  double max[3] = { 0.0, 0.0, 0.0 };
+  for (std::size_t i=0; i!=n_planes; ++i)
+  {
+    const auto& points = records[i].m_points;
+    for (int axis=0; axis!=3; ++axis)
+    {
+      const double lo{std::min({points[0][axis],points[1][axis],points[2][axis]}) - margin};
+      const double hi{std::max({points[0][axis],points[1][axis],points[2][axis]}) + margin};
+      boxes[(6 * i) + axis] = lo;
+      boxes[(6 * i) + 3 + axis] = hi;
+      min[axis] = i == 0 ? lo : std::min(min[axis],lo);
+      max[axis] = i == 0 ? hi : std::max(max[axis],hi);
+    }
+  }
+
+  PlaneIndexHeader header;
+  std::memset(&header,0,sizeof(header));
+  std::memcpy(header.m_magic,plane_index_magic,sizeof(plane_index_magic));
+  header.m_version = PlaneIndex::m_version;
+  header.m_byte_order = plane_index_byte_order;
+  header.m_margin = margin;
+  header.m_n_planes = n_planes;
+  CalcPlaneIndexGrid(header,min,max,cells_per_plane * static_cast<double>(n_planes));
+  const std::uint64_t n_cells{
+    static_cast<std::uint64_t>(header.m_n_cells[0]) * header.m_n_cells[1] * header.m_n_cells[2]
+  };
+
+  //The range of cells of each box, counted first to know where each cell starts
+  std::vector<std::uint32_t> ranges(6 * n_planes);
+  std::vector<std::uint64_t> cell_offsets(n_cells + 1,0);
+  for (std::size_t i=0; i!=n_planes; ++i)
+  {
+    for (int axis=0; axis!=3; ++axis)
+    {
+      ranges[(6 * i) + axis] = CalcCellClamped(header,axis,boxes[(6 * i) + axis]);
+      ranges[(6 * i) + 3 + axis] = CalcCellClamped(header,axis,boxes[(6 * i) + 3 + axis]);
+    }
+    for (std::uint64_t z=ranges[(6 * i) + 2]; z<=ranges[(6 * i) + 5]; ++z)
+    {
+      for (std::uint64_t y=ranges[(6 * i) + 1]; y<=ranges[(6 * i) + 4]; ++y)
+      {
+        for (std::uint64_t x=ranges[6 * i]; x<=ranges[(6 * i) + 3]; ++x)
+        {
+          ++cell_offsets[1 + x + (header.m_n_cells[0] * (y + (header.m_n_cells[1] * z)))];
+        }
+      }
+    }
+  }
+  for (std::uint64_t i=0; i!=n_cells; ++i) cell_offsets[i + 1] += cell_offsets[i];
+  header.m_n_indices = cell_offsets[n_cells];
+  header.m_cell_offsets_offset = sizeof(PlaneIndexHeader);
+  header.m_indices_offset = header.m_cell_offsets_offset + RoundUpIndex((n_cells + 1) * sizeof(std::uint64_t));
+  header.m_boxes_offset = header.m_indices_offset + RoundUpIndex(header.m_n_indices * sizeof(std::uint32_t));
+  const std::uint64_t size{header.m_boxes_offset + (n_planes * 6 * sizeof(double))};
+
+  PlaneMappedFile file(filename,size);
+  char * const data{file.GetWritableData()};
+  std::memcpy(data,&header,sizeof(header));
+  std::memcpy(data + header.m_cell_offsets_offset,cell_offsets.data(),cell_offsets.size() * sizeof(std::uint64_t));
+  if (n_planes != 0)
+  {
+    std::memcpy(data + header.m_boxes_offset,boxes.data(),boxes.size() * sizeof(double));
+  }
+  //Fill the cells, in increasing plane index, so each cell is sorted
+  std::uint32_t * const indices{reinterpret_cast<std::uint32_t*>(data + header.m_indices_offset)};
+  for (std::size_t i=0; i!=n_planes; ++i)
+  {
+    for (std::uint64_t z=ranges[(6 * i) + 2]; z<=ranges[(6 * i) + 5]; ++z)
+    {
+      for (std::uint64_t y=ranges[(6 * i) + 1]; y<=ranges[(6 * i) + 4]; ++y)
+      {
+        for (std::uint64_t x=ranges[6 * i]; x<=ranges[(6 * i) + 3]; ++x)
+        {
+          const std::uint64_t cell{x + (header.m_n_cells[0] * (y + (header.m_n_cells[1] * z)))};
+          indices[cell_offsets[cell]++] = static_cast<std::uint32_t>(i);
+        }
+      }
+    }
+  }
+}
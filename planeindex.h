@@ -0,0 +1,139 @@
+#ifndef RIBI_PLANEINDEX_H
+#define RIBI_PLANEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "plane.h"
+#include "planefile.h"
+#include "planemappedfile.h"
+
+namespace ribi {
+
+///The start of a plane index file. The index is a uniform grid over the
+///bounding boxes of the three points of each plane, each enlarged by a
+///margin. Each grid cell has the indices of the planes whose box overlaps
+///it, stored as one block of indices with the start of each cell in it:
+/// - cell offsets: std::uint64_t, n_cells + 1 values, where the planes of
+///   cell i are the indices from offsets[i] to offsets[i + 1]
+/// - indices: std::uint32_t, the plane indices of all cells
+/// - boxes: double, six values per plane: the minimum and maximum X, Y and Z
+///Each block starts at a multiple of 64 bytes from the start of the file.
+///All positions are byte offsets from the start of the file, so the file
+///can be memory-mapped at any address and used as is
+struct PlaneIndexHeader
+{
+  ///Always 'ribiplni'
+  char m_magic[8];
+
+  ///The version of the file format
+  std::uint32_t m_version;
+
+  ///The value 0x01020304, as written by the machine that wrote the file,
+  ///to detect a file written with a different byte order
+  std::uint32_t m_byte_order;
+
+  ///The number of cells along X, Y and Z
+  std::uint32_t m_n_cells[3];
+
+  ///Unused, keeps the doubles aligned
+  std::uint32_t m_padding;
+
+  ///The lowest X, Y and Z of the grid
+  double m_min[3];
+
+  ///The size of a cell along X, Y and Z
+  double m_cell_size[3];
+
+  ///The margin the boxes have been enlarged with
+  double m_margin;
+
+  ///The number of planes
+  std::uint64_t m_n_planes;
+
+  ///The number of plane indices of all cells
+  std::uint64_t m_n_indices;
+
+  ///The byte offsets of the cell offsets, indices and boxes
+  std::uint64_t m_cell_offsets_offset;
+  std::uint64_t m_indices_offset;
+  std::uint64_t m_boxes_offset;
+};
+
+static_assert(sizeof(PlaneIndexHeader) == 128,"PlaneIndexHeader must have no compiler dependent padding");
+
+///A plane index file, memory-mapped for as long as the PlaneIndex exists.
+///Loading it only reads its header, so it takes the same time for any
+///number of planes: the grid is paged in when queried.
+///The plane indices are those of the PlaneRecords the index is saved from,
+///for example the indices of the PlaneFile to create the planes from
+///
+///Use SavePlaneIndex to create a plane index file
+struct PlaneIndex
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+
+  ///Memory-maps the file.
+  ///Throws std::runtime_error if the file cannot be opened,
+  ///is not a plane index file of this version and byte order,
+  ///or its header does not match its size.
+  ///The cells are only checked when queried
+  explicit PlaneIndex(const std::string& filename);
+
+  ///The indices of the planes whose box, enlarged by the margin,
+  ///contains the coordinat, in increasing order.
+  ///Throws std::runtime_error if the cell of the coordinat is corrupt
+  std::vector<std::uint32_t> FindPlanes(const Coordinat3D& coordinat) const;
+
+  ///The indices of the planes whose box, enlarged by the margin, overlaps
+  ///the cell of the coordinat, as [first,last) of the mapped file.
+  ///Empty if the coordinat is outside of the grid.
+  ///Throws std::runtime_error if the cell offsets are out of range
+  std::pair<const std::uint32_t *, const std::uint32_t *> GetCandidates(
+    const Coordinat3D& coordinat
+  ) const;
+
+  ///The margin the boxes have been enlarged with
+  double GetMargin() const noexcept { return m_header.m_margin; }
+
+  ///The number of planes
+  std::size_t GetSize() const noexcept { return static_cast<std::size_t>(m_header.m_n_planes); }
+
+  ///The version of the file format
+  static constexpr std::uint32_t m_version{1};
+
+  private:
+
+  ///The minimum X, Y, Z, followed by the maximum X, Y and Z of each plane
+  const double * m_boxes;
+
+  const std::uint64_t * m_cell_offsets;
+
+  PlaneMappedFile m_file;
+
+  PlaneIndexHeader m_header;
+
+  const std::uint32_t * m_indices;
+};
+
+///Save a plane index of the PlaneRecords, that can be loaded by PlaneIndex.
+///The box of the three points of each plane is enlarged by the margin.
+///The grid has about cells_per_plane cells per plane, with at most
+///1024 cells along each axis, so building it is about linear in the number
+///of planes.
+///Throws std::invalid_argument if the margin is negative, cells_per_plane
+///is not positive or there are more planes than fit in a std::uint32_t.
+///Throws std::runtime_error if the file cannot be written
+void SavePlaneIndex(
+  const std::string& filename,
+  const std::vector<PlaneRecord>& records,
+  const double margin,
+  const double cells_per_plane = 1.0
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEINDEX_H
@@ -0,0 +1,135 @@
+#include "planeindex.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+///Overwrite the bytes at the offset of a file
+template <class T>
+static void PatchPlaneIndexFile(const std::string& filename, const std::size_t offset, const T& value)
+{
+  std::fstream f(filename,std::ios::binary | std::ios::in | std::ios::out);
+  f.seekp(static_cast<std::streamoff>(offset));
+  f.write(reinterpret_cast<const char*>(&value),sizeof(value));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeindex_find)
+{
+  const std::string filename{"ribi_planeindex_find.bin"};
+  //Small tilted planes on a 10x10 raster, one unit apart
+  std::vector<PlaneRecord> records;
+  for (int i=0; i!=100; ++i)
+  {
+    const double x{static_cast<double>(i % 10)};
+    const double y{static_cast<double>(i / 10)};
+    const Plane p(
+      Coordinat3D(x,y,0.0),
+      Coordinat3D(x + 0.5,y,0.1 * i),
+      Coordinat3D(x,y + 0.5,0.2)
+    );
+    records.push_back(CreatePlaneRecord(p));
+  }
+  const double margin{0.1};
+  SavePlaneIndex(filename,records,margin);
+  const PlaneIndex index(filename);
+  BOOST_CHECK_EQUAL(index.GetSize(),100);
+  BOOST_CHECK_EQUAL(index.GetMargin(),margin);
+  //Compare with checking all boxes
+  for (int i=0; i!=1000; ++i)
+  {
+    const Coordinat3D c(
+      -0.5 + (0.0113 * i),
+      -0.5 + (0.0107 * ((i * 7) % 1000)),
+      -0.5 + (0.011 * ((i * 13) % 1000))
+    );
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t j=0; j!=records.size(); ++j)
+    {
+      bool is_inside{true};
+      for (int axis=0; axis!=3; ++axis)
+      {
+        const double v{axis == 0 ? boost::geometry::get<0>(c) : axis == 1 ? boost::geometry::get<1>(c) : boost::geometry::get<2>(c)};
+        const auto& points = records[j].m_points;
+        const double lo{std::min({points[0][axis],points[1][axis],points[2][axis]}) - margin};
+        const double hi{std::max({points[0][axis],points[1][axis],points[2][axis]}) + margin};
+        is_inside = is_inside && lo <= v && v <= hi;
+      }
+      if (is_inside) expected.push_back(j);
+    }
+    BOOST_CHECK(index.FindPlanes(c) == expected);
+  }
+  BOOST_CHECK(index.FindPlanes(Coordinat3D(0.25,0.25,0.1)) == std::vector<std::uint32_t>(1,0));
+  BOOST_CHECK(index.FindPlanes(Coordinat3D(100.0,0.0,0.0)).empty());
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeindex_empty_and_invalid)
+{
+  const std::string filename{"ribi_planeindex_empty.bin"};
+  SavePlaneIndex(filename,{},0.0);
+  const PlaneIndex index(filename);
+  BOOST_CHECK_EQUAL(index.GetSize(),0);
+  BOOST_CHECK(index.FindPlanes(Coordinat3D(0.0,0.0,0.0)).empty());
+  std::remove(filename.c_str());
+  BOOST_CHECK_THROW(SavePlaneIndex(filename,{},-1.0),std::invalid_argument);
+  BOOST_CHECK_THROW(SavePlaneIndex(filename,{},0.0,0.0),std::invalid_argument);
+  BOOST_CHECK_THROW(PlaneIndex("ribi_planeindex_does_not_exist.bin"),std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeindex_corrupt)
+{
+  const std::string filename{"ribi_planeindex_corrupt.bin"};
+  const Plane p(
+    Coordinat3D(0.0,0.0,0.0),
+    Coordinat3D(1.0,0.0,0.0),
+    Coordinat3D(0.0,1.0,0.0)
+  );
+  const std::vector<PlaneRecord> records(1,CreatePlaneRecord(p));
+  const Coordinat3D inside(0.5,0.5,0.0);
+
+  //Too many cells along an axis
+  SavePlaneIndex(filename,records,0.0);
+  PatchPlaneIndexFile(filename,offsetof(PlaneIndexHeader,m_n_cells),std::uint32_t{2000});
+  BOOST_CHECK_THROW(PlaneIndex{filename},std::runtime_error);
+
+  //A number of indices that makes the block sizes wrap around
+  SavePlaneIndex(filename,records,0.0);
+  PatchPlaneIndexFile(filename,offsetof(PlaneIndexHeader,m_n_indices),std::uint64_t{1} << 62);
+  BOOST_CHECK_THROW(PlaneIndex{filename},std::runtime_error);
+
+  //Cell offsets beyond the indices are only detected when queried
+  SavePlaneIndex(filename,records,0.0);
+  {
+    const PlaneIndex index(filename);
+    BOOST_CHECK(index.FindPlanes(inside) == std::vector<std::uint32_t>(1,0));
+  }
+  PatchPlaneIndexFile(filename,sizeof(PlaneIndexHeader) + sizeof(std::uint64_t),std::uint64_t{1000000});
+  {
+    const PlaneIndex index(filename);
+    BOOST_CHECK_THROW(index.GetCandidates(inside),std::runtime_error);
+    BOOST_CHECK_THROW(index.FindPlanes(inside),std::runtime_error);
+  }
+
+  //A plane index beyond the planes
+  SavePlaneIndex(filename,records,0.0);
+  {
+    std::uint64_t indices_offset{0};
+    {
+      std::ifstream f(filename,std::ios::binary);
+      f.seekg(offsetof(PlaneIndexHeader,m_indices_offset));
+      f.read(reinterpret_cast<char*>(&indices_offset),sizeof(indices_offset));
+    }
+    PatchPlaneIndexFile(filename,indices_offset,std::uint32_t{7});
+    const PlaneIndex index(filename);
+    BOOST_CHECK_THROW(index.FindPlanes(inside),std::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,162 @@
+#include "planeint.h"
+
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+#include <stdexcept>
+
+namespace ribi {
+
+///Throws std::out_of_range if an element of the coordinat is out of range
+static void CheckPlaneIntRange(const PlaneInt::Coordinat3D& coordinat)
+{
+  const auto max = PlaneInt::GetMaxCoordinat();
+  const auto x = boost::geometry::get<0>(coordinat);
+  const auto y = boost::geometry::get<1>(coordinat);
+  const auto z = boost::geometry::get<2>(coordinat);
+  if (x < -max || x > max || y < -max || y > max || z < -max || z > max)
+  {
+    throw std::out_of_range("PlaneInt: coordinat element out of range");
+  }
+}
+
+///Greatest common divisor of two non-negative integers
+static PlaneInt::Int128 CalcGcd(PlaneInt::Int128 a, PlaneInt::Int128 b) noexcept
+{
+  assert(a >= 0);
+  assert(b >= 0);
+  while (b != 0)
+  {
+    const auto t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+} //~namespace ribi
+
+ribi::PlaneInt::PlaneInt(
+  const Coordinat3D& p1,
+  const Coordinat3D& p2,
+  const Coordinat3D& p3
+) : m_coefficients(CalcPlaneInt(p1,p2,p3)),
+    m_points{p1,p2,p3}
+{
+
+}
+
+ribi::PlaneInt::Coefficients ribi::CalcPlaneInt(
+  const PlaneInt::Coordinat3D& p1,
+  const PlaneInt::Coordinat3D& p2,
+  const PlaneInt::Coordinat3D& p3
+)
+{
+  using boost::geometry::get;
+  typedef PlaneInt::Int128 Int128;
+  CheckPlaneIntRange(p1);
+  CheckPlaneIntRange(p2);
+  CheckPlaneIntRange(p3);
+
+  //Differences are at most 2^41, their products at most 2^82
+  const Int128 v1_x{get<0>(p3) - get<0>(p1)};
+  const Int128 v1_y{get<1>(p3) - get<1>(p1)};
+  const Int128 v1_z{get<2>(p3) - get<2>(p1)};
+  const Int128 v2_x{get<0>(p2) - get<0>(p1)};
+  const Int128 v2_y{get<1>(p2) - get<1>(p1)};
+  const Int128 v2_z{get<2>(p2) - get<2>(p1)};
+
+  //The normal is the cross product
+  Int128 a{(v1_y * v2_z) - (v1_z * v2_y)};
+  Int128 b{(v1_z * v2_x) - (v1_x * v2_z)};
+  Int128 c{(v1_x * v2_y) - (v1_y * v2_x)};
+  if (a == 0 && b == 0 && c == 0)
+  {
+    throw std::logic_error("PlaneInt: cannot create a plane from collinear points");
+  }
+
+  //Remove common divisors, to keep D small and the coefficients canonical
+  const Int128 gcd{
+    CalcGcd(CalcGcd(a < 0 ? -a : a,b < 0 ? -b : b),c < 0 ? -c : c)
+  };
+  assert(gcd > 0);
+  a /= gcd;
+  b /= gcd;
+  c /= gcd;
+
+  const Int128 first{a != 0 ? a : (b != 0 ? b : c)};
+  if (first < 0)
+  {
+    a = -a;
+    b = -b;
+    c = -c;
+  }
+  const Int128 d{(a * get<0>(p1)) + (b * get<1>(p1)) + (c * get<2>(p1))};
+  return { a, b, c, d };
+}
+
+ribi::PlaneInt::Int128 ribi::PlaneInt::CalcResidual(const Coordinat3D& coordinat) const
+{
+  CheckPlaneIntRange(coordinat);
+  const auto& t = m_coefficients;
+  return
+      (t[0] * boost::geometry::get<0>(coordinat))
+    + (t[1] * boost::geometry::get<1>(coordinat))
+    + (t[2] * boost::geometry::get<2>(coordinat))
+    - t[3]
+  ;
+}
+
+bool ribi::PlaneInt::IsInPlane(const Coordinat3D& coordinat) const
+{
+  return CalcResidual(coordinat) == 0;
+}
+
+std::vector<bool> ribi::PlaneInt::IsInPlane(const Coordinats3D& coordinats) const
+{
+  std::vector<bool> v;
+  v.reserve(coordinats.size());
+  for (const auto& coordinat: coordinats)
+  {
+    v.push_back(IsInPlane(coordinat));
+  }
+  return v;
+}
+
+std::string ribi::ToStr(const PlaneInt::Int128 i)
+{
+  if (i == 0) { return "0"; }
+  //Work with negative values, as -i may not fit for the smallest value
+  PlaneInt::Int128 n{i < 0 ? i : -i};
+  std::string s;
+  while (n != 0)
+  {
+    s += static_cast<char>('0' - static_cast<int>(n % 10));
+    n /= 10;
+  }
+  if (i < 0) { s += '-'; }
+  std::reverse(std::begin(s),std::end(s));
+  return s;
+}
+
+bool ribi::operator==(const PlaneInt& lhs, const PlaneInt& rhs) noexcept
+{
+  return lhs.GetCoefficients() == rhs.GetCoefficients();
+}
+
+bool ribi::operator!=(const PlaneInt& lhs, const PlaneInt& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+std::ostream& ribi::operator<<(std::ostream& os, const PlaneInt& plane)
+{
+  const auto& t = plane.GetCoefficients();
+  os
+    << "(" << ToStr(t[0]) << "*x) + ("
+    << ToStr(t[1]) << "*y) + ("
+    << ToStr(t[2]) << "*z) = "
+    << ToStr(t[3])
+  ;
+  return os;
+}
@@ -0,0 +1,103 @@
+#ifndef RIBI_PLANEINT_H
+#define RIBI_PLANEINT_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <boost/geometry.hpp>
+
+namespace ribi {
+
+///A 3D plane through three points with integer coordinats, for example
+///survey data in millimetres. Its coefficients are integers as well:
+///
+///  A.x + B.y + C.z = D
+///
+///All calculations are exact: IsInPlane has no tolerance.
+///To make this possible, a coordinat element must be in the range
+///[-GetMaxCoordinat(), GetMaxCoordinat()], which is 2^40,
+///or about 1.1 * 10^12. Within this range, all intermediate values fit
+///in 128-bit integers.
+///
+///The coefficients are in canonical form: they have no common divisor, and
+///the first non-zero of A, B and C is positive. Every set of three points
+///of the same plane results in the same coefficients.
+struct PlaneInt
+{
+  typedef std::int64_t Int;
+  __extension__ typedef __int128 Int128;
+  typedef boost::geometry::model::point<Int,3,boost::geometry::cs::cartesian> Coordinat3D;
+  typedef std::vector<Coordinat3D> Coordinats3D;
+  typedef std::array<Int128,4> Coefficients;
+
+  ///Construct from three points.
+  ///Throws std::out_of_range if a coordinat element is out of range.
+  ///Throws std::logic_error if the points are collinear
+  explicit PlaneInt(
+    const Coordinat3D& p1,
+    const Coordinat3D& p2,
+    const Coordinat3D& p3
+  );
+
+  ///A.x + B.y + C.z - D, which is zero for a coordinat in the plane,
+  ///and has the same sign for all coordinats on the same side of it.
+  ///Throws std::out_of_range if a coordinat element is out of range
+  Int128 CalcResidual(const Coordinat3D& coordinat) const;
+
+  ///Can the PlaneInt be expressed as X = A*Y + B*Z + C ?
+  bool CanCalcX() const noexcept { return m_coefficients[0] != 0; }
+
+  ///Can the PlaneInt be expressed as Y = A*X + B*Z + C ?
+  bool CanCalcY() const noexcept { return m_coefficients[1] != 0; }
+
+  ///Can the PlaneInt be expressed as Z = A*X + B*Y + C ?
+  bool CanCalcZ() const noexcept { return m_coefficients[2] != 0; }
+
+  ///The coefficients A, B, C and D
+  const Coefficients& GetCoefficients() const noexcept { return m_coefficients; }
+
+  ///The largest absolute value a coordinat element can have
+  static constexpr Int GetMaxCoordinat() noexcept { return Int(1) << 40; }
+
+  ///The three points the PlaneInt is constructed from
+  const Coordinats3D& GetPoints() const noexcept { return m_points; }
+
+  ///Checks if the coordinat is exactly in the plane.
+  ///Throws std::out_of_range if a coordinat element is out of range
+  bool IsInPlane(const Coordinat3D& coordinat) const;
+
+  ///Checks for each coordinat if it is exactly in the plane.
+  ///Throws std::out_of_range if a coordinat element is out of range
+  std::vector<bool> IsInPlane(const Coordinats3D& coordinats) const;
+
+  private:
+
+  Coefficients m_coefficients;
+
+  Coordinats3D m_points;
+};
+
+///Calculates the coefficients of the plane through three points, in canonical form.
+///Throws std::out_of_range if a coordinat element is out of range.
+///Throws std::logic_error if the points are collinear
+PlaneInt::Coefficients CalcPlaneInt(
+  const PlaneInt::Coordinat3D& p1,
+  const PlaneInt::Coordinat3D& p2,
+  const PlaneInt::Coordinat3D& p3
+);
+
+///Convert a 128-bit integer to its decimal notation
+std::string ToStr(const PlaneInt::Int128 i);
+
+bool operator==(const PlaneInt& lhs, const PlaneInt& rhs) noexcept;
+bool operator!=(const PlaneInt& lhs, const PlaneInt& rhs) noexcept;
+
+///Writes the function, e.g. '(2*x) + (3*y) + (5*z) = 7'
+std::ostream& operator<<(std::ostream& os, const PlaneInt& plane);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEINT_H
@@ -0,0 +1,92 @@
+#include "planeint.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace ribi;
+using Coordinat3D = ribi::PlaneInt::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planeint_z_is_5)
+{
+  const PlaneInt p(
+    Coordinat3D( 2, 3,5),
+    Coordinat3D( 7,11,5),
+    Coordinat3D(13,17,5)
+  );
+  BOOST_CHECK(!p.CanCalcX());
+  BOOST_CHECK(!p.CanCalcY());
+  BOOST_CHECK( p.CanCalcZ());
+  BOOST_CHECK(p.IsInPlane(Coordinat3D(-1000000,123456789,5)));
+  BOOST_CHECK(!p.IsInPlane(Coordinat3D(0,0,4)));
+  BOOST_CHECK(!p.IsInPlane(Coordinat3D(0,0,6)));
+  BOOST_CHECK(p.CalcResidual(Coordinat3D(0,0,4)) < 0);
+  BOOST_CHECK(p.CalcResidual(Coordinat3D(0,0,6)) > 0);
+  std::stringstream s;
+  s << p;
+  BOOST_CHECK_EQUAL(s.str(),"(0*x) + (0*y) + (1*z) = 5");
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeint_is_exact_at_max_coordinat)
+{
+  //z = 2x + 3y + 5, with coordinats near the edge of the range
+  const PlaneInt::Int m{PlaneInt::GetMaxCoordinat() / 8};
+  const PlaneInt p(
+    Coordinat3D(0,0,5),
+    Coordinat3D(m,0,(2*m) + 5),
+    Coordinat3D(0,m,(3*m) + 5)
+  );
+  BOOST_CHECK(p.CanCalcX());
+  BOOST_CHECK(p.CanCalcY());
+  BOOST_CHECK(p.CanCalcZ());
+  const PlaneInt::Int x{m - 1};
+  const PlaneInt::Int y{-m + 3};
+  const PlaneInt::Int z{(2*x) + (3*y) + 5};
+  BOOST_CHECK( p.IsInPlane(Coordinat3D(x,y,z)));
+  BOOST_CHECK(!p.IsInPlane(Coordinat3D(x,y,z + 1)));
+  BOOST_CHECK(!p.IsInPlane(Coordinat3D(x,y,z - 1)));
+  BOOST_CHECK(!p.IsInPlane(Coordinat3D(x + 1,y,z)));
+  const std::vector<bool> v{
+    p.IsInPlane({ Coordinat3D(x,y,z), Coordinat3D(x,y,z+1) })
+  };
+  BOOST_CHECK(v == std::vector<bool>({ true, false }));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeint_is_canonical)
+{
+  const Coordinat3D p1( 1, 2,3);
+  const Coordinat3D p2( 4, 6,9);
+  const Coordinat3D p3(12,11,9);
+  const Coordinat3D p4(
+    p1.get<0>() + (p2.get<0>() - p1.get<0>()) * 2 + (p3.get<0>() - p1.get<0>()) * 3,
+    p1.get<1>() + (p2.get<1>() - p1.get<1>()) * 2 + (p3.get<1>() - p1.get<1>()) * 3,
+    p1.get<2>() + (p2.get<2>() - p1.get<2>()) * 2 + (p3.get<2>() - p1.get<2>()) * 3
+  );
+  const PlaneInt a(p1,p2,p3);
+  BOOST_CHECK(a.IsInPlane(p4));
+  BOOST_CHECK(a == PlaneInt(p3,p2,p1));
+  BOOST_CHECK(a == PlaneInt(p2,p4,p3));
+  BOOST_CHECK(a == PlaneInt(p4,p1,p2));
+  BOOST_CHECK(a != PlaneInt(p1,p2,Coordinat3D(12,11,10)));
+  //30x - 48y + 17z = -15, see ribi_planez_test_11
+  BOOST_CHECK(ToStr(a.GetCoefficients()[0]) == "30");
+  BOOST_CHECK(ToStr(a.GetCoefficients()[1]) == "-48");
+  BOOST_CHECK(ToStr(a.GetCoefficients()[2]) == "17");
+  BOOST_CHECK(ToStr(a.GetCoefficients()[3]) == "-15");
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeint_throws)
+{
+  const PlaneInt::Int too_big{PlaneInt::GetMaxCoordinat() + 1};
+  BOOST_CHECK_THROW(
+    PlaneInt(Coordinat3D(0,0,0),Coordinat3D(1,1,1),Coordinat3D(2,2,2)),
+    std::logic_error
+  );
+  BOOST_CHECK_THROW(
+    PlaneInt(Coordinat3D(0,0,0),Coordinat3D(1,0,0),Coordinat3D(0,too_big,0)),
+    std::out_of_range
+  );
+  const PlaneInt p(Coordinat3D(0,0,0),Coordinat3D(1,0,0),Coordinat3D(0,1,0));
+  BOOST_CHECK_THROW(p.IsInPlane(Coordinat3D(0,0,-too_big)),std::out_of_range);
+}
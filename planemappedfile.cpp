@@ -0,0 +1,89 @@
+#include "planemappedfile.h"
+
+#include <cassert>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ribi::PlaneMappedFile::PlaneMappedFile(const std::string& filename)
+  : m_data{nullptr},
+    m_is_writable{false},
+    m_size{0}
+{
+  const int fd{::open(filename.c_str(),O_RDONLY)};
+  if (fd == -1)
+  {
+    throw std::runtime_error("PlaneMappedFile: cannot open file '" + filename + "'");
+  }
+  struct stat s;
+  if (::fstat(fd,&s) == -1)
+  {
+    ::close(fd);
+    throw std::runtime_error("PlaneMappedFile: cannot obtain the size of file '" + filename + "'");
+  }
+  m_size = static_cast<std::size_t>(s.st_size);
+  if (m_size == 0)
+  {
+    //mmap cannot map zero bytes
+    ::close(fd);
+    return;
+  }
+  void * const data{::mmap(nullptr,m_size,PROT_READ,MAP_PRIVATE,fd,0)};
+  //The mapping stays valid after closing the file
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    throw std::runtime_error("PlaneMappedFile: cannot map file '" + filename + "'");
+  }
+  m_data = static_cast<char*>(data);
+}
+
+ribi::PlaneMappedFile::PlaneMappedFile(const std::string& filename, const std::size_t size)
+  : m_data{nullptr},
+    m_is_writable{true},
+    m_size{size}
+{
+  const int fd{::open(filename.c_str(),O_RDWR | O_CREAT | O_TRUNC,0644)};
+  if (fd == -1)
+  {
+    throw std::runtime_error("PlaneMappedFile: cannot create file '" + filename + "'");
+  }
+  if (::ftruncate(fd,static_cast<off_t>(m_size)) == -1)
+  {
+    ::close(fd);
+    throw std::runtime_error("PlaneMappedFile: cannot set the size of file '" + filename + "'");
+  }
+  if (m_size == 0)
+  {
+    //mmap cannot map zero bytes
+    ::close(fd);
+    return;
+  }
+  void * const data{::mmap(nullptr,m_size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0)};
+  //The mapping stays valid after closing the file
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    throw std::runtime_error("PlaneMappedFile: cannot map file '" + filename + "'");
+  }
+  m_data = static_cast<char*>(data);
+}
+
+ribi::PlaneMappedFile::~PlaneMappedFile() noexcept
+{
+  if (m_data)
+  {
+    const int result{::munmap(m_data,m_size)};
+    assert(result == 0);
+    (void)result;
+  }
+}
+
+void ribi::PlaneMappedFile::AdviseSequential() const noexcept
+{
+  //Only a hint, so failure is no problem
+  if (m_data) ::madvise(m_data,m_size,MADV_SEQUENTIAL);
+}
@@ -0,0 +1,54 @@
+#ifndef RIBI_PLANEMAPPEDFILE_H
+#define RIBI_PLANEMAPPEDFILE_H
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+namespace ribi {
+
+///A file that is memory-mapped for as long as the PlaneMappedFile exists.
+///Reading its data pages the file in on demand, instead of copying it into
+///a buffer first. Writing its data is written to the file by the
+///operating system, without a buffer as well.
+///Uses POSIX mmap
+struct PlaneMappedFile
+{
+  ///Maps the file read-only.
+  ///Throws std::runtime_error if the file cannot be opened or mapped
+  explicit PlaneMappedFile(const std::string& filename);
+
+  ///Creates the file with the size in bytes, overwriting any existing file,
+  ///and maps it read-write.
+  ///Throws std::runtime_error if the file cannot be created or mapped
+  explicit PlaneMappedFile(const std::string& filename, const std::size_t size);
+  PlaneMappedFile(const PlaneMappedFile&) = delete;
+  PlaneMappedFile& operator=(const PlaneMappedFile&) = delete;
+  ~PlaneMappedFile() noexcept;
+
+  ///The first byte of the file, nullptr for an empty file.
+  ///It is aligned to a page boundary
+  const char * GetData() const noexcept { return m_data; }
+
+  ///The first byte of a file mapped read-write, nullptr for an empty file
+  char * GetWritableData() noexcept { assert(m_is_writable); return m_data; }
+
+  ///The size of the file in bytes
+  std::size_t GetSize() const noexcept { return m_size; }
+
+  ///Tell the operating system the data will be read or written
+  ///from front to back, so it can read ahead and free pages behind
+  void AdviseSequential() const noexcept;
+
+  ///Is the file mapped read-write?
+  bool IsWritable() const noexcept { return m_is_writable; }
+
+  private:
+  char * m_data;
+  bool m_is_writable;
+  std::size_t m_size;
+};
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEMAPPEDFILE_H
@@ -0,0 +1,126 @@
+#include "planemarginhistogram.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+#include "planethreadregistry.h"
+
+namespace ribi {
+
+typedef PlaneThreadRegistry<PlaneThreadMarginHistogram,PlaneMarginHistogram> PlaneMarginHistogramRegistry;
+
+///Add the counts of a thread to a histogram
+static void AddThreadMarginHistogram(
+  PlaneMarginHistogram& histogram,
+  const PlaneThreadMarginHistogram& thread
+) noexcept
+{
+  for (std::size_t bin=0; bin!=PlaneMarginHistogram::m_n_bins; ++bin)
+  {
+    histogram.AddCount(bin,thread.m_counts[bin].load(std::memory_order_relaxed));
+  }
+}
+
+} //~namespace ribi
+
+void ribi::PlaneMarginHistogram::Add(const PlaneMarginHistogram& other) noexcept
+{
+  for (std::size_t bin=0; bin!=m_n_bins; ++bin)
+  {
+    m_counts[bin] += other.m_counts[bin];
+  }
+}
+
+std::size_t ribi::PlaneMarginHistogram::CalcBin(const double ratio) noexcept
+{
+  if (ratio == 0.0) return 0;
+  if (!(ratio > 0.0) || std::isinf(ratio)) return m_n_bins - 1;
+  //The exponent of the power of two that is the upper bound
+  int exponent{std::ilogb(ratio)};
+  if (ratio != std::ldexp(1.0,exponent)) ++exponent;
+  const int bin{exponent - m_min_exponent};
+  return static_cast<std::size_t>(std::max(1,std::min(bin,static_cast<int>(m_n_bins) - 1)));
+}
+
+double ribi::PlaneMarginHistogram::GetLowerBound(const std::size_t bin) noexcept
+{
+  assert(bin < m_n_bins);
+  if (bin == 0) return 0.0;
+  return std::ldexp(1.0,m_min_exponent + static_cast<int>(bin) - 1);
+}
+
+std::uint64_t ribi::PlaneMarginHistogram::GetNumberAboveOne() const noexcept
+{
+  //One is the upper bound of its bin, so the bins after it are above one
+  std::uint64_t n{0};
+  for (std::size_t bin=CalcBin(1.0) + 1; bin!=m_n_bins; ++bin) n += m_counts[bin];
+  return n;
+}
+
+std::uint64_t ribi::PlaneMarginHistogram::GetTotal() const noexcept
+{
+  std::uint64_t n{0};
+  for (const auto count: m_counts) n += count;
+  return n;
+}
+
+std::ostream& ribi::operator<<(std::ostream& os, const PlaneMarginHistogram& histogram)
+{
+  for (std::size_t bin=0; bin!=PlaneMarginHistogram::m_n_bins; ++bin)
+  {
+    if (histogram.GetCount(bin) == 0) continue;
+    os << PlaneMarginHistogram::GetLowerBound(bin) << ' ' << histogram.GetCount(bin) << '\n';
+  }
+  return os;
+}
+
+double ribi::CalcMarginRatio(const double error, const double max_error) noexcept
+{
+  if (error == 0.0) return 0.0;
+  return error / max_error;
+}
+
+void ribi::AddMargins(
+  const Plane& plane,
+  const Plane::Coordinats3D& points,
+  PlaneMarginHistogram& histogram
+)
+{
+  for (const auto& point: points)
+  {
+    histogram.Add(CalcMarginRatio(plane.CalcError(point),plane.CalcMaxError(point)));
+  }
+}
+
+ribi::PlaneThreadMarginHistogram::PlaneThreadMarginHistogram()
+  : m_counts{}
+{
+  for (auto& count: m_counts) count.store(0,std::memory_order_relaxed);
+  PlaneMarginHistogramRegistry::Get().Add(*this);
+}
+
+ribi::PlaneThreadMarginHistogram::~PlaneThreadMarginHistogram()
+{
+  PlaneMarginHistogramRegistry::Get().Remove(
+    *this,
+    [this](PlaneMarginHistogram& exited) { AddThreadMarginHistogram(exited,*this); }
+  );
+}
+
+ribi::PlaneMarginHistogram ribi::GetPlaneMarginHistogram()
+{
+  return PlaneMarginHistogramRegistry::Get().Read(
+    [](const PlaneMarginHistogram& exited, const std::vector<const PlaneThreadMarginHistogram *>& threads)
+    {
+      PlaneMarginHistogram histogram = exited;
+      for (const PlaneThreadMarginHistogram * const thread: threads)
+      {
+        AddThreadMarginHistogram(histogram,*thread);
+      }
+      return histogram;
+    }
+  );
+}
@@ -0,0 +1,118 @@
+#ifndef RIBI_PLANEMARGINHISTOGRAM_H
+#define RIBI_PLANEMARGINHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#include "plane.h"
+
+namespace ribi {
+
+///A histogram of the ratio between the error of a point to a plane and the
+///maximum error for it to be in the plane, as obtained by CalcError and
+///CalcMaxError. A ratio up to one is a point in the plane.
+///The bins are log-scale, one per power of two, and include their upper
+///bound, so that a ratio of exactly one is in a bin of points in the plane:
+/// - bin 0: ratio zero, the point is exactly in the plane
+/// - bin 1: ratio up to 2^(m_min_exponent + 1), including ratios up to 2^m_min_exponent
+/// - bin i: ratio in (2^(m_min_exponent + i - 1), 2^(m_min_exponent + i)]
+/// - last bin: ratio above 2^(m_min_exponent + m_n_bins - 2),
+///   including infinity and NaN
+struct PlaneMarginHistogram
+{
+  static constexpr std::size_t m_n_bins{64};
+  static constexpr int m_min_exponent{-48};
+
+  PlaneMarginHistogram() noexcept : m_counts{} {}
+
+  ///Add a ratio, as obtained by CalcMarginRatio
+  void Add(const double ratio) noexcept { ++m_counts[CalcBin(ratio)]; }
+
+  ///Add all counts of another histogram, for example of another thread
+  void Add(const PlaneMarginHistogram& other) noexcept;
+
+  ///Add a number of ratios to a bin
+  void AddCount(const std::size_t bin, const std::uint64_t count) noexcept { m_counts[bin] += count; }
+
+  ///The bin of a ratio
+  static std::size_t CalcBin(const double ratio) noexcept;
+
+  std::uint64_t GetCount(const std::size_t bin) const noexcept { return m_counts[bin]; }
+
+  ///The lower bound of a bin, which is not in the bin itself
+  static double GetLowerBound(const std::size_t bin) noexcept;
+
+  ///The number of ratios above one, that is, of points not in the plane.
+  ///A ratio of exactly one is a point on the boundary, so in the plane
+  std::uint64_t GetNumberAboveOne() const noexcept;
+
+  ///The number of ratios
+  std::uint64_t GetTotal() const noexcept;
+
+  private:
+
+  std::array<std::uint64_t,m_n_bins> m_counts;
+};
+
+///Writes each non-empty bin as 'lower_bound count' on a line of its own
+std::ostream& operator<<(std::ostream& os, const PlaneMarginHistogram& histogram);
+
+///The ratio between error and maximum error, as in PlaneMarginHistogram:
+///zero if both are zero
+double CalcMarginRatio(const double error, const double max_error) noexcept;
+
+///Add the ratios of the points to the histogram of a plane.
+///This calls CalcError and CalcMaxError, so it is as costly as they are
+void AddMargins(
+  const Plane& plane,
+  const Plane::Coordinats3D& points,
+  PlaneMarginHistogram& histogram
+);
+
+///The global histogram of one thread, registered in a PlaneThreadRegistry
+struct PlaneThreadMarginHistogram
+{
+  PlaneThreadMarginHistogram();
+  PlaneThreadMarginHistogram(const PlaneThreadMarginHistogram&) = delete;
+  PlaneThreadMarginHistogram& operator=(const PlaneThreadMarginHistogram&) = delete;
+  ///Adds the histogram to that of exited threads
+  ~PlaneThreadMarginHistogram();
+
+  void Add(const double ratio) noexcept
+  {
+    std::atomic<std::uint64_t>& count = m_counts[PlaneMarginHistogram::CalcBin(ratio)];
+    count.store(count.load(std::memory_order_relaxed) + 1,std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<std::uint64_t>,PlaneMarginHistogram::m_n_bins> m_counts;
+};
+
+///The global histogram of the calling thread
+inline PlaneThreadMarginHistogram& GetPlaneThreadMarginHistogram()
+{
+  thread_local PlaneThreadMarginHistogram histogram;
+  return histogram;
+}
+
+///The global histograms of all threads merged, including exited threads.
+///Histograms of running threads may be added to while merging
+PlaneMarginHistogram GetPlaneMarginHistogram();
+
+} //~namespace ribi
+
+///Record the margin of a point in the global histogram of the thread.
+///Only done if RIBI_PLANE_MARGIN_HISTOGRAM is defined, as it calls
+///CalcError and CalcMaxError for each point checked by Plane::IsInPlane,
+///with any tolerance policy. The ratio is always to the maximum error of
+///UlpTolerance, so histograms of different policies can be compared
+#ifdef RIBI_PLANE_MARGIN_HISTOGRAM
+#define RIBI_PLANE_RECORD_MARGIN(error,max_error) \
+  ::ribi::GetPlaneThreadMarginHistogram().Add(::ribi::CalcMarginRatio(error,max_error))
+#else
+#define RIBI_PLANE_RECORD_MARGIN(error,max_error) ((void)0)
+#endif
+
+#endif // RIBI_PLANEMARGINHISTOGRAM_H
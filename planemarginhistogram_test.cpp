@@ -0,0 +1,90 @@
+#include "planemarginhistogram.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "plane.h"
+#include "planetolerance.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planemarginhistogram_bins)
+{
+  using H = PlaneMarginHistogram;
+  BOOST_CHECK_EQUAL(H::CalcBin(0.0),0);
+  BOOST_CHECK_EQUAL(H::CalcBin(1e-300),1);
+  BOOST_CHECK_EQUAL(H::CalcBin(std::numeric_limits<double>::infinity()),H::m_n_bins - 1);
+  BOOST_CHECK_EQUAL(H::CalcBin(std::nan("")),H::m_n_bins - 1);
+  BOOST_CHECK_EQUAL(H::CalcBin(1e300),H::m_n_bins - 1);
+  for (const double ratio: { 1e-12, 0.001, 0.5, 0.75, 1.0, 1.5, 100.0 })
+  {
+    const std::size_t bin{H::CalcBin(ratio)};
+    BOOST_CHECK_LT(H::GetLowerBound(bin),ratio);
+    BOOST_CHECK_GE(H::GetLowerBound(bin + 1),ratio);
+  }
+  //A ratio of exactly one is a point on the boundary, so in the plane
+  {
+    H h;
+    h.Add(1.0);
+    BOOST_CHECK_EQUAL(h.GetNumberAboveOne(),0);
+    h.Add(std::nextafter(1.0,2.0));
+    BOOST_CHECK_EQUAL(h.GetNumberAboveOne(),1);
+  }
+  BOOST_CHECK_EQUAL(CalcMarginRatio(0.0,0.0),0.0);
+  BOOST_CHECK_EQUAL(CalcMarginRatio(1.0,4.0),0.25);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planemarginhistogram_per_plane)
+{
+  //z = (2*x) + (3*y) + 5
+  const Plane p(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  const Plane::Coordinats3D points{
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(3.0,4.0,23.0),
+    Coordinat3D(3.0,4.0,24.0),
+    Coordinat3D(3.0,4.0,25.0)
+  };
+  PlaneMarginHistogram h;
+  AddMargins(p,points,h);
+  BOOST_CHECK_EQUAL(h.GetTotal(),4);
+  BOOST_CHECK_EQUAL(h.GetCount(0),2);
+  BOOST_CHECK_EQUAL(h.GetNumberAboveOne(),2);
+  PlaneMarginHistogram sum;
+  sum.Add(h);
+  sum.Add(h);
+  BOOST_CHECK_EQUAL(sum.GetTotal(),8);
+  std::stringstream s;
+  s << sum;
+  BOOST_CHECK_EQUAL(s.str().substr(0,4),"0 4\n");
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planemarginhistogram_threads)
+{
+  //The histograms of all threads, also exited ones, are merged
+  const std::uint64_t before{GetPlaneMarginHistogram().GetNumberAboveOne()};
+  std::thread t([]() { for (int i=0; i!=10; ++i) GetPlaneThreadMarginHistogram().Add(2.0); });
+  t.join();
+  GetPlaneThreadMarginHistogram().Add(3.0);
+  BOOST_CHECK_EQUAL(GetPlaneMarginHistogram().GetNumberAboveOne() - before,11);
+}
+
+#ifdef RIBI_PLANE_MARGIN_HISTOGRAM
+BOOST_AUTO_TEST_CASE(ribi_planemarginhistogram_records_any_tolerance)
+{
+  //z = (2*x) + (3*y) + 5, the point is one above it
+  const Plane p(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  const Coordinat3D above(3.0,4.0,24.0);
+  const std::uint64_t before{GetPlaneMarginHistogram().GetTotal()};
+  BOOST_CHECK(!p.IsInPlane(above,AbsoluteTolerance(1.0e-9)));
+  BOOST_CHECK(p.IsInPlane(Plane::Coordinats3D(2,above),AbsoluteTolerance(2.0)) == std::vector<bool>(2,true));
+  BOOST_CHECK_EQUAL(p.IsInPlane(Plane::Coordinats3D(3,above)).size(),3);
+  BOOST_CHECK(!p.IsInPlane(above));
+  BOOST_CHECK_EQUAL(GetPlaneMarginHistogram().GetTotal() - before,7);
+}
+#endif
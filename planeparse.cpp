@@ -0,0 +1,248 @@
+#include "planeparse.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "planemappedfile.h"
+#include "planetrace.h"
+
+namespace ribi {
+
+///The minimum number of bytes parsed by a thread of ParsePlaneFunctions
+static const std::int64_t plane_parse_min_range_size{4096};
+
+///Read the literal text at the start of [first,last),
+///returns the end of it, or nullptr if it is absent
+static const char * ReadLiteral(
+  const char * const first,
+  const char * const last,
+  const char * const text
+) noexcept
+{
+  if (!first) return nullptr;
+  const std::size_t size{std::strlen(text)};
+  if (static_cast<std::size_t>(last - first) < size) return nullptr;
+  if (std::memcmp(first,text,size) != 0) return nullptr;
+  return first + size;
+}
+
+///Read a double at the start of [first,last),
+///returns the end of it, or nullptr if it is absent
+static const char * ReadDouble(
+  const char * const first,
+  const char * const last,
+  double& x
+) noexcept
+{
+  if (!first) return nullptr;
+  const std::from_chars_result result{std::from_chars(first,last,x)};
+  if (result.ec != std::errc()) return nullptr;
+  return result.ptr;
+}
+
+///Parse the lines in [first,last) that start in that range,
+///throws std::invalid_argument at the first line that is not a function
+static void ParsePlaneFunctionLines(
+  const char * first,
+  const char * const last,
+  const char * const begin_of_text,
+  std::vector<PlaneFunction>& functions
+)
+{
+  while (first != last)
+  {
+    const char * const newline{std::find(first,last,'\n')};
+    const char * end_of_line{newline};
+    if (end_of_line != first && *(end_of_line - 1) == '\r') --end_of_line;
+    if (end_of_line != first)
+    {
+      PlaneFunction function;
+      const std::from_chars_result result{ParsePlaneFunction(first,end_of_line,function)};
+      if (result.ec != std::errc() || result.ptr != end_of_line)
+      {
+        throw std::invalid_argument(
+          "ParsePlaneFunctions: no function at byte "
+          + std::to_string(first - begin_of_text)
+        );
+      }
+      functions.push_back(function);
+    }
+    first = newline == last ? last : newline + 1;
+  }
+}
+
+} //~namespace ribi
+
+std::vector<double> ribi::PlaneFunction::GetCoefficients() const
+{
+  //The PlaneZ with z = A*x + B*y + C has coefficients {A,B,-1,-C},
+  //as GetFunctionA is -A/-1 which is exactly A, etcetera.
+  //PlaneX and PlaneY are such a PlaneZ with rotated coordinats
+  switch (m_lhs)
+  {
+    case 'x': return { -1.0, m_a, m_b, -m_c };
+    case 'y': return { m_b, -1.0, m_a, -m_c };
+    case 'z': return { m_a, m_b, -1.0, -m_c };
+  }
+  throw std::logic_error("PlaneFunction::GetCoefficients: unknown function");
+}
+
+bool ribi::operator==(const PlaneFunction& lhs, const PlaneFunction& rhs) noexcept
+{
+  return lhs.m_lhs == rhs.m_lhs
+    && lhs.m_a == rhs.m_a
+    && lhs.m_b == rhs.m_b
+    && lhs.m_c == rhs.m_c
+  ;
+}
+
+bool ribi::operator!=(const PlaneFunction& lhs, const PlaneFunction& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+std::from_chars_result ribi::ParsePlaneFunction(
+  const char * const first,
+  const char * const last,
+  PlaneFunction& function
+) noexcept
+{
+  const std::from_chars_result failure{first,std::errc::invalid_argument};
+  if (last - first < 2 || first[1] != '=') return failure;
+  //The names of the variables on the right hand side
+  const char * variables{nullptr};
+  switch (first[0])
+  {
+    case 'x': variables = "yz"; break;
+    case 'y': variables = "xz"; break;
+    case 'z': variables = "xy"; break;
+    default: return failure;
+  }
+  const char a_end[] = { '*', variables[0], ')', ' ', '+', ' ', '(', '\0' };
+  const char b_end[] = { '*', variables[1], ')', ' ', '+', ' ', '\0' };
+
+  PlaneFunction f;
+  f.m_lhs = first[0];
+  const char * p{ReadLiteral(first + 2,last,"(")};
+  p = ReadDouble(p,last,f.m_a);
+  p = ReadLiteral(p,last,a_end);
+  p = ReadDouble(p,last,f.m_b);
+  p = ReadLiteral(p,last,b_end);
+  p = ReadDouble(p,last,f.m_c);
+  if (!p) return failure;
+  function = f;
+  return { p, std::errc() };
+}
+
+ribi::PlaneFunction ribi::ParsePlaneFunction(const std::string& text)
+{
+  const char * const first{text.data()};
+  const char * const last{text.data() + text.size()};
+  PlaneFunction function;
+  const std::from_chars_result result{ParsePlaneFunction(first,last,function)};
+  if (result.ec != std::errc() || result.ptr != last)
+  {
+    throw std::invalid_argument("ParsePlaneFunction: '" + text + "' is not a function");
+  }
+  return function;
+}
+
+std::vector<ribi::PlaneFunction> ribi::ParsePlaneFunctions(
+  const char * const first,
+  const char * const last,
+  const int n_threads
+)
+{
+  if (n_threads < 1)
+  {
+    throw std::logic_error("ParsePlaneFunctions: the number of threads must be at least one");
+  }
+  assert(first <= last);
+  const std::int64_t n{last - first};
+  //More threads than cores, or than ranges worth a thread, only add the cost of starting them
+  const std::int64_t n_cores{static_cast<std::int64_t>(std::thread::hardware_concurrency())};
+  const int n_ranges{
+    static_cast<int>(
+      std::max(
+        std::int64_t(1),
+        std::min(
+          {
+            std::int64_t(n_threads),
+            n / plane_parse_min_range_size,
+            n_cores == 0 ? std::int64_t(n_threads) : n_cores
+          }
+        )
+      )
+    )
+  };
+  //Each range starts at the start of a line
+  std::vector<const char *> starts;
+  starts.push_back(first);
+  for (int i=1; i!=n_ranges; ++i)
+  {
+    const char * start{first + (n * i / n_ranges)};
+    start = std::max(start,starts.back());
+    if (start != first && *(start - 1) != '\n')
+    {
+      start = std::find(start,last,'\n');
+      if (start != last) ++start;
+    }
+    starts.push_back(start);
+  }
+  starts.push_back(last);
+
+  std::vector<std::vector<PlaneFunction>> results(n_ranges);
+  std::vector<std::exception_ptr> errors(n_ranges);
+  const auto parse_range = [&](const int i)
+  {
+    RIBI_PLANE_TRACE_SCOPE("ParsePlaneFunctions range");
+    try
+    {
+      auto& v = results[i];
+      //About 25 characters per function
+      v.reserve(static_cast<std::size_t>(starts[i + 1] - starts[i]) / 25);
+      ParsePlaneFunctionLines(starts[i],starts[i + 1],first,v);
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i=1; i<n_ranges; ++i)
+  {
+    threads.emplace_back(parse_range,i);
+  }
+  parse_range(0);
+  for (auto& thread: threads) { thread.join(); }
+
+  for (const auto& error: errors)
+  {
+    if (error) { std::rethrow_exception(error); }
+  }
+  std::size_t n_functions{0};
+  for (const auto& v: results) { n_functions += v.size(); }
+  std::vector<PlaneFunction> all;
+  all.reserve(n_functions);
+  for (const auto& v: results)
+  {
+    all.insert(all.end(),v.begin(),v.end());
+  }
+  return all;
+}
+
+std::vector<ribi::PlaneFunction> ribi::ParsePlaneFunctionFile(
+  const std::string& filename,
+  const int n_threads
+)
+{
+  const PlaneMappedFile file(filename);
+  const char * const first{file.GetData()};
+  return ParsePlaneFunctions(first,first + file.GetSize(),n_threads);
+}
@@ -0,0 +1,72 @@
+#ifndef RIBI_PLANEPARSE_H
+#define RIBI_PLANEPARSE_H
+
+#include <charconv>
+#include <string>
+#include <vector>
+
+namespace ribi {
+
+///A function as written by ToFunction of PlaneX, PlaneY or PlaneZ:
+///
+///  x=(A*y) + (B*z) + C
+///  y=(A*x) + (B*z) + C
+///  z=(A*x) + (B*y) + C
+///
+///Use GetCoefficients to construct the PlaneX, PlaneY or PlaneZ, for example
+///
+///  const PlaneZ p(function.GetCoefficients());
+struct PlaneFunction
+{
+  ///Is it a function of x, y or z?
+  char m_lhs;
+
+  double m_a;
+  double m_b;
+  double m_c;
+
+  ///The coefficients of the PlaneX, PlaneY or PlaneZ (depending on m_lhs)
+  ///with this function, as obtained by its GetCoefficients
+  std::vector<double> GetCoefficients() const;
+};
+
+bool operator==(const PlaneFunction& lhs, const PlaneFunction& rhs) noexcept;
+bool operator!=(const PlaneFunction& lhs, const PlaneFunction& rhs) noexcept;
+
+///Parse a function as written by ToFunction of PlaneX, PlaneY or PlaneZ
+///from the start of [first,last), without allocating. Numbers are read by
+///std::from_chars. Returns as std::from_chars does: the end of the function,
+///or first and std::errc::invalid_argument if it is not a function
+std::from_chars_result ParsePlaneFunction(
+  const char * const first,
+  const char * const last,
+  PlaneFunction& function
+) noexcept;
+
+///Parse a function as written by ToFunction of PlaneX, PlaneY or PlaneZ.
+///Throws std::invalid_argument if the text is not exactly a function
+PlaneFunction ParsePlaneFunction(const std::string& text);
+
+///Parse the newline-separated functions in [first,last), in parallel.
+///Uses at most n_threads threads, including the calling thread, and no
+///more than std::thread::hardware_concurrency() or one per 4 KiB of text.
+///Empty lines are skipped, a carriage return at the end of a line is allowed.
+///Throws std::invalid_argument if a line is not a function.
+///Throws std::logic_error if the number of threads is less than one
+std::vector<PlaneFunction> ParsePlaneFunctions(
+  const char * const first,
+  const char * const last,
+  const int n_threads
+);
+
+///Parse the newline-separated functions in a file, which is memory-mapped,
+///in parallel, as done by ParsePlaneFunctions.
+///Throws std::runtime_error if the file cannot be read
+std::vector<PlaneFunction> ParsePlaneFunctionFile(
+  const std::string& filename,
+  const int n_threads
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPARSE_H
@@ -0,0 +1,108 @@
+#include "planeparse.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planeparse_planez)
+{
+  const PlaneFunction f{ParsePlaneFunction("z=(2*x) + (-3.5*y) + 5e-07")};
+  BOOST_CHECK_EQUAL(f.m_lhs,'z');
+  BOOST_CHECK_EQUAL(f.m_a,2.0);
+  BOOST_CHECK_EQUAL(f.m_b,-3.5);
+  BOOST_CHECK_EQUAL(f.m_c,5e-07);
+  const PlaneZ p(f.GetCoefficients());
+  BOOST_CHECK_EQUAL(p.GetFunctionA(),2.0);
+  BOOST_CHECK_EQUAL(p.GetFunctionB(),-3.5);
+  BOOST_CHECK_EQUAL(p.GetFunctionC(),5e-07);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeparse_round_trip)
+{
+  char buffer[128];
+  //z = (2*x) + (3*y) + 5, tilted a bit to have non-trivial numbers
+  const PlaneZ z(Coordinat3D(1.0,1.1,10.0),Coordinat3D(1.0,2.0,13.3),Coordinat3D(2.7,1.0,12.0));
+  const PlaneX x(Coordinat3D(1.0,0.0,0.1),Coordinat3D(1.3,1.0,0.0),Coordinat3D(1.0,0.7,1.0));
+  const PlaneY y(Coordinat3D(0.0,1.0,0.1),Coordinat3D(1.3,1.0,0.0),Coordinat3D(0.7,1.1,1.0));
+  {
+    const auto written = z.ToFunction(buffer,buffer + sizeof(buffer));
+    PlaneFunction f;
+    const auto read = ParsePlaneFunction(buffer,written.ptr,f);
+    BOOST_REQUIRE(read.ec == std::errc());
+    BOOST_CHECK(read.ptr == written.ptr);
+    const PlaneZ q(f.GetCoefficients());
+    BOOST_CHECK_EQUAL(q.GetFunctionA(),z.GetFunctionA());
+    BOOST_CHECK_EQUAL(q.GetFunctionB(),z.GetFunctionB());
+    BOOST_CHECK_EQUAL(q.GetFunctionC(),z.GetFunctionC());
+  }
+  {
+    const auto written = x.ToFunction(buffer,buffer + sizeof(buffer));
+    const PlaneX q(ParsePlaneFunction(std::string(buffer,written.ptr)).GetCoefficients());
+    BOOST_CHECK_EQUAL(q.GetFunctionA(),x.GetFunctionA());
+    BOOST_CHECK_EQUAL(q.GetFunctionB(),x.GetFunctionB());
+    BOOST_CHECK_EQUAL(q.GetFunctionC(),x.GetFunctionC());
+  }
+  {
+    const auto written = y.ToFunction(buffer,buffer + sizeof(buffer));
+    const PlaneY q(ParsePlaneFunction(std::string(buffer,written.ptr)).GetCoefficients());
+    BOOST_CHECK_EQUAL(q.GetFunctionA(),y.GetFunctionA());
+    BOOST_CHECK_EQUAL(q.GetFunctionB(),y.GetFunctionB());
+    BOOST_CHECK_EQUAL(q.GetFunctionC(),y.GetFunctionC());
+    BOOST_CHECK_EQUAL(q.ToFunction(),y.ToFunction());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeparse_rejects_other_text)
+{
+  for (const std::string s: {
+      "", "z", "z=", "w=(1*x) + (2*y) + 3", "z=(1*y) + (2*x) + 3",
+      "z=(1*x)+(2*y)+3", "z=(1*x) + (2*y) + ", "z=(1*x) + (2*y) + 3 ", "x=(1*x) + (2*z) + 3"
+    }
+  )
+  {
+    BOOST_CHECK_THROW(ParsePlaneFunction(s),std::invalid_argument);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeparse_bulk)
+{
+  std::stringstream s;
+  std::vector<PlaneFunction> expected;
+  for (int i=0; i!=1000; ++i)
+  {
+    const PlaneFunction f{"xyz"[i % 3], i * 0.5, -i * 0.25, i + 0.125};
+    expected.push_back(f);
+    s << f.m_lhs << "=(" << f.m_a << "*" << (f.m_lhs == 'x' ? 'y' : 'x') << ") + ("
+      << f.m_b << "*" << (f.m_lhs == 'z' ? 'y' : 'z') << ") + " << f.m_c
+      << (i % 2 ? "\r\n" : "\n") << (i % 100 ? "" : "\n")
+    ;
+  }
+  const std::string text{s.str()};
+  //The number of threads is capped, so a huge number does not start that many
+  for (const int n_threads: { 1, 2, 7, 1000000 })
+  {
+    BOOST_CHECK(ParsePlaneFunctions(text.data(),text.data() + text.size(),n_threads) == expected);
+  }
+  const std::string filename{"ribi_planeparse_bulk.txt"};
+  {
+    std::ofstream f(filename.c_str(),std::ios::binary);
+    f << text << "z=(1*x) + (1*y)";
+  }
+  BOOST_CHECK_THROW(ParsePlaneFunctionFile(filename,3),std::invalid_argument);
+  {
+    std::ofstream f(filename.c_str(),std::ios::binary);
+    f << text;
+  }
+  BOOST_CHECK(ParsePlaneFunctionFile(filename,3) == expected);
+  std::remove(filename.c_str());
+  BOOST_CHECK(ParsePlaneFunctions(text.data(),text.data(),4).empty());
+  BOOST_CHECK_THROW(ParsePlaneFunctions(text.data(),text.data(),0),std::logic_error);
+}
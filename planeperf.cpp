@@ -0,0 +1,228 @@
+#include "planeperf.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ribi {
+
+static std::int64_t GetPerfTimeNs() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+#ifdef __linux__
+///Open a counter of the calling thread on any CPU, -1 if this fails.
+///Without a group leader, this counter becomes the disabled leader of a
+///new group. Else it joins the group of the leader, and counts when it does
+static int OpenPerfEvent(const PlanePerfEventConfig& event, const int leader) noexcept
+{
+  perf_event_attr attr;
+  std::memset(&attr,0,sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.m_type;
+  attr.config = event.m_config;
+  attr.disabled = leader == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  const long fd{syscall(__NR_perf_event_open,&attr,0,-1,leader,0)};
+  return static_cast<int>(fd);
+}
+#endif // __linux__
+
+///The events of PlanePerfCounters, in the order of PlanePerfEvent
+static std::vector<PlanePerfEventConfig> GetPlanePerfEventConfigs()
+{
+  #ifdef __linux__
+  return {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    {
+      PERF_TYPE_HW_CACHE,
+      PERF_COUNT_HW_CACHE_L1D
+      | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+  };
+  #else
+  //Never opened, so the values do not matter
+  return std::vector<PlanePerfEventConfig>(PlanePerfSample::m_n_events,PlanePerfEventConfig{0,0});
+  #endif
+}
+
+} //~namespace ribi
+
+const char * ribi::ToStr(const PlanePerfEvent event) noexcept
+{
+  switch (event)
+  {
+    case PlanePerfEvent::cycles: return "cycles";
+    case PlanePerfEvent::instructions: return "instructions";
+    case PlanePerfEvent::l1d_misses: return "l1d_misses";
+    case PlanePerfEvent::llc_misses: return "llc_misses";
+    case PlanePerfEvent::branch_misses: return "branch_misses";
+    case PlanePerfEvent::n_events: break;
+  }
+  assert(!"Should not get here");
+  return "";
+}
+
+double ribi::PlanePerfSample::GetInstructionsPerCycle() const noexcept
+{
+  if (!IsAvailable(PlanePerfEvent::cycles)
+    || !IsAvailable(PlanePerfEvent::instructions)
+    || Get(PlanePerfEvent::cycles) == 0.0
+  )
+  {
+    return 0.0;
+  }
+  return Get(PlanePerfEvent::instructions) / Get(PlanePerfEvent::cycles);
+}
+
+ribi::PlanePerfGroup::PlanePerfGroup(const std::vector<PlanePerfEventConfig>& events)
+  : m_fds(events.size(),-1)
+{
+  for (std::size_t i=0; i!=events.size(); ++i)
+  {
+    #ifdef __linux__
+    m_fds[i] = OpenPerfEvent(events[i],GetLeader());
+    #endif
+  }
+}
+
+ribi::PlanePerfGroup::~PlanePerfGroup() noexcept
+{
+  #ifdef __linux__
+  //The leader is closed last, after the counters in its group
+  for (auto i = m_fds.rbegin(); i != m_fds.rend(); ++i)
+  {
+    if (*i != -1) close(*i);
+  }
+  #endif
+}
+
+int ribi::PlanePerfGroup::GetLeader() const noexcept
+{
+  for (const int fd: m_fds)
+  {
+    if (fd != -1) return fd;
+  }
+  return -1;
+}
+
+void ribi::PlanePerfGroup::Start() noexcept
+{
+  #ifdef __linux__
+  const int leader{GetLeader()};
+  if (leader != -1)
+  {
+    ioctl(leader,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+    ioctl(leader,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+  }
+  #endif
+}
+
+std::vector<std::uint64_t> ribi::PlanePerfGroup::Stop()
+{
+  //The number of counters, the time enabled, the time running and the counts
+  std::vector<std::uint64_t> values(3 + m_fds.size(),0);
+  std::size_t n_read{0};
+  #ifdef __linux__
+  const int leader{GetLeader()};
+  if (leader != -1)
+  {
+    ioctl(leader,PERF_EVENT_IOC_DISABLE,PERF_IOC_FLAG_GROUP);
+    const ssize_t n_bytes{read(leader,values.data(),values.size() * sizeof(std::uint64_t))};
+    if (n_bytes > 0) n_read = static_cast<std::size_t>(n_bytes) / sizeof(std::uint64_t);
+  }
+  #endif
+  values.resize(n_read);
+  return values;
+}
+
+ribi::PlanePerfCounters::PlanePerfCounters()
+  : m_group(GetPlanePerfEventConfigs()),
+    m_start_ns{0}
+{
+
+}
+
+ribi::PlanePerfSample ribi::CreatePlanePerfSample(
+  const std::vector<std::uint64_t>& values,
+  const std::array<bool,PlanePerfSample::m_n_events>& is_in_group,
+  const double seconds
+) noexcept
+{
+  PlanePerfSample sample;
+  sample.m_counts.fill(0.0);
+  sample.m_is_available.fill(false);
+  sample.m_seconds = seconds;
+  std::uint64_t n_in_group{0};
+  for (const bool b: is_in_group) n_in_group += b ? 1 : 0;
+  if (values.size() < 3 || values[0] != n_in_group || values.size() != 3 + n_in_group)
+  {
+    return sample;
+  }
+  const std::uint64_t time_enabled{values[1]};
+  const std::uint64_t time_running{values[2]};
+  //A group that was opened but never ran, for example because the
+  //counters were used by others all the time, has no counts
+  if (time_running == 0) return sample;
+  std::size_t j{3};
+  for (std::size_t i=0; i!=is_in_group.size(); ++i)
+  {
+    if (!is_in_group[i]) continue;
+    sample.m_is_available[i] = true;
+    //Scale up if the kernel had to multiplex the counters
+    sample.m_counts[i]
+      = static_cast<double>(values[j]) * static_cast<double>(time_enabled) / static_cast<double>(time_running);
+    ++j;
+  }
+  return sample;
+}
+
+bool ribi::PlanePerfCounters::IsAnyAvailable() const noexcept
+{
+  return m_group.GetLeader() != -1;
+}
+
+bool ribi::PlanePerfCounters::IsAvailable(const PlanePerfEvent event) const noexcept
+{
+  return m_group.IsAvailable(static_cast<std::size_t>(event));
+}
+
+void ribi::PlanePerfCounters::Start() noexcept
+{
+  m_group.Start();
+  m_start_ns = GetPerfTimeNs();
+}
+
+ribi::PlanePerfSample ribi::PlanePerfCounters::Stop()
+{
+  const std::int64_t stop_ns{GetPerfTimeNs()};
+  const double seconds{static_cast<double>(stop_ns - m_start_ns) * 1.0e-9};
+  std::array<bool,PlanePerfSample::m_n_events> is_in_group;
+  for (std::size_t i=0; i!=is_in_group.size(); ++i) is_in_group[i] = m_group.IsAvailable(i);
+  return CreatePlanePerfSample(m_group.Stop(),is_in_group,seconds);
+}
+
+ribi::PlanePerfSample ribi::MeasurePerf(const std::function<void()>& f, const int n_repeats)
+{
+  f();
+  PlanePerfCounters counters;
+  counters.Start();
+  for (int i=0; i!=n_repeats; ++i) f();
+  return counters.Stop();
+}
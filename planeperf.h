@@ -0,0 +1,147 @@
+#ifndef RIBI_PLANEPERF_H
+#define RIBI_PLANEPERF_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ribi {
+
+///The hardware events counted by PlanePerfCounters
+enum class PlanePerfEvent
+{
+  cycles,
+  instructions,
+  l1d_misses,
+  llc_misses,
+  branch_misses,
+
+  ///The number of events, not an event itself
+  n_events
+};
+
+///The name of an event
+const char * ToStr(const PlanePerfEvent event) noexcept;
+
+///The counts of the events between PlanePerfCounters::Start and Stop
+struct PlanePerfSample
+{
+  static constexpr std::size_t m_n_events{static_cast<std::size_t>(PlanePerfEvent::n_events)};
+
+  ///The count of an event, scaled up if the kernel could only count it
+  ///part of the time. Zero if the event is unavailable
+  double Get(const PlanePerfEvent event) const noexcept { return m_counts[static_cast<std::size_t>(event)]; }
+
+  ///Instructions per cycle, zero if either is unavailable
+  double GetInstructionsPerCycle() const noexcept;
+
+  ///Could the event be counted? Not if it could not be opened, or if it
+  ///was opened but never ran, for example on a virtual machine
+  bool IsAvailable(const PlanePerfEvent event) const noexcept { return m_is_available[static_cast<std::size_t>(event)]; }
+
+  std::array<double,m_n_events> m_counts;
+  std::array<bool,m_n_events> m_is_available;
+
+  ///The wall-clock time, always available
+  double m_seconds;
+};
+
+///The sample of a read of a group of counters, as read from the group leader
+///with PERF_FORMAT_GROUP, PERF_FORMAT_TOTAL_TIME_ENABLED and
+///PERF_FORMAT_TOTAL_TIME_RUNNING: the number of counters, the time enabled,
+///the time running and the count of each counter. is_in_group tells which
+///events are in the group, in the order of their counts. All events are
+///unavailable if the read does not match the group, or if the group never ran
+PlanePerfSample CreatePlanePerfSample(
+  const std::vector<std::uint64_t>& values,
+  const std::array<bool,PlanePerfSample::m_n_events>& is_in_group,
+  const double seconds
+) noexcept;
+
+///An event to count, as the type and config of perf_event_attr,
+///for example PERF_TYPE_SOFTWARE and PERF_COUNT_SW_TASK_CLOCK
+struct PlanePerfEventConfig
+{
+  std::uint32_t m_type;
+  std::uint64_t m_config;
+};
+
+///A group of counters of the calling thread, using Linux perf_event_open.
+///The first event that can be opened is the group leader, the other
+///events join its group, so that all are counted over the same time
+struct PlanePerfGroup
+{
+  explicit PlanePerfGroup(const std::vector<PlanePerfEventConfig>& events);
+  PlanePerfGroup(const PlanePerfGroup&) = delete;
+  PlanePerfGroup& operator=(const PlanePerfGroup&) = delete;
+  ~PlanePerfGroup() noexcept;
+
+  ///The file descriptor of an event, -1 if it could not be opened
+  int GetFd(const std::size_t i) const noexcept { return m_fds[i]; }
+
+  ///The file descriptor of the group leader, -1 if no event could be opened
+  int GetLeader() const noexcept;
+
+  ///The number of events, including those that could not be opened
+  std::size_t GetSize() const noexcept { return m_fds.size(); }
+
+  ///Could the event be opened?
+  bool IsAvailable(const std::size_t i) const noexcept { return m_fds[i] != -1; }
+
+  ///Reset and start counting all events of the group
+  void Start() noexcept;
+
+  ///Stop counting and read the group from its leader: the number of
+  ///counters, the time enabled, the time running and the count of each
+  ///event that could be opened, in order. Empty if the read fails
+  std::vector<std::uint64_t> Stop();
+
+  private:
+
+  ///The file descriptor of each event, -1 if unavailable
+  std::vector<int> m_fds;
+};
+
+///Hardware performance counters of the calling thread, using Linux
+///perf_event_open. Events that cannot be opened, for example because of
+///perf_event_paranoid, a virtual machine or another operating system, are
+///unavailable: the other events and the wall-clock time still work.
+///The events are counted as one group, so they are counted over the same
+///time, also when the kernel multiplexes counters: instructions per cycle
+///and misses per point compare counts of the same time window
+struct PlanePerfCounters
+{
+  PlanePerfCounters();
+  PlanePerfCounters(const PlanePerfCounters&) = delete;
+  PlanePerfCounters& operator=(const PlanePerfCounters&) = delete;
+
+  ///Is there any event available?
+  bool IsAnyAvailable() const noexcept;
+
+  ///Could the event be opened?
+  bool IsAvailable(const PlanePerfEvent event) const noexcept;
+
+  ///Reset and start counting
+  void Start() noexcept;
+
+  ///Stop counting and read the counts since Start
+  PlanePerfSample Stop();
+
+  private:
+
+  ///The counters of the events, in the order of PlanePerfEvent
+  PlanePerfGroup m_group;
+
+  ///The wall-clock time of Start, in nanoseconds
+  std::int64_t m_start_ns;
+};
+
+///Count the events of calling the function n_repeats times,
+///after calling it once to warm the caches up
+PlanePerfSample MeasurePerf(const std::function<void()>& f, const int n_repeats = 1);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPERF_H
@@ -0,0 +1,144 @@
+#include "planeperf.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace ribi;
+
+BOOST_AUTO_TEST_CASE(ribi_planeperf_measure)
+{
+  //Hardware counters are often unavailable, for example in a container,
+  //so only check they are sensible if available
+  volatile double sink{0.0};
+  const PlanePerfSample sample{
+    MeasurePerf([&sink]() { for (int i=0; i!=100000; ++i) sink = sink + i; },3)
+  };
+  BOOST_CHECK_GT(sample.m_seconds,0.0);
+  if (sample.IsAvailable(PlanePerfEvent::instructions))
+  {
+    BOOST_CHECK_GT(sample.Get(PlanePerfEvent::instructions),300000.0);
+  }
+  if (sample.IsAvailable(PlanePerfEvent::cycles) && sample.IsAvailable(PlanePerfEvent::instructions))
+  {
+    BOOST_CHECK_GT(sample.GetInstructionsPerCycle(),0.0);
+  }
+  else
+  {
+    BOOST_CHECK_EQUAL(sample.GetInstructionsPerCycle(),0.0);
+  }
+  const PlanePerfCounters counters;
+  for (std::size_t i=0; i!=PlanePerfSample::m_n_events; ++i)
+  {
+    const PlanePerfEvent event{static_cast<PlanePerfEvent>(i)};
+    BOOST_CHECK(!std::string(ToStr(event)).empty());
+    BOOST_CHECK(!counters.IsAvailable(event) || counters.IsAnyAvailable());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeperf_group_read)
+{
+  //Cycles and llc misses are in the group, the others could not be opened
+  std::array<bool,PlanePerfSample::m_n_events> is_in_group;
+  is_in_group.fill(false);
+  is_in_group[static_cast<std::size_t>(PlanePerfEvent::cycles)] = true;
+  is_in_group[static_cast<std::size_t>(PlanePerfEvent::llc_misses)] = true;
+
+  //The group ran half of the time it was enabled, so counts are doubled
+  {
+    const PlanePerfSample sample{CreatePlanePerfSample({2,100,50,5,7},is_in_group,1.0)};
+    BOOST_CHECK(sample.IsAvailable(PlanePerfEvent::cycles));
+    BOOST_CHECK(sample.IsAvailable(PlanePerfEvent::llc_misses));
+    BOOST_CHECK(!sample.IsAvailable(PlanePerfEvent::instructions));
+    BOOST_CHECK_EQUAL(sample.Get(PlanePerfEvent::cycles),10.0);
+    BOOST_CHECK_EQUAL(sample.Get(PlanePerfEvent::llc_misses),14.0);
+    BOOST_CHECK_EQUAL(sample.m_seconds,1.0);
+  }
+  //A group that never ran has no counts
+  {
+    const PlanePerfSample sample{CreatePlanePerfSample({2,100,0,0,0},is_in_group,1.0)};
+    for (std::size_t i=0; i!=PlanePerfSample::m_n_events; ++i)
+    {
+      BOOST_CHECK(!sample.IsAvailable(static_cast<PlanePerfEvent>(i)));
+    }
+  }
+  //A read that does not match the group
+  {
+    const PlanePerfSample sample{CreatePlanePerfSample({3,100,50,5,7},is_in_group,1.0)};
+    BOOST_CHECK(!sample.IsAvailable(PlanePerfEvent::cycles));
+  }
+}
+
+#ifdef __linux__
+///Can the task clock be opened, without PlanePerfGroup? Software events are
+///available without hardware counters, but may still be forbidden, for
+///example by a seccomp profile
+static bool CanOpenTaskClock()
+{
+  perf_event_attr attr;
+  std::memset(&attr,0,sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_SOFTWARE;
+  attr.config = PERF_COUNT_SW_TASK_CLOCK;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  const long fd{syscall(__NR_perf_event_open,&attr,0,-1,-1,0)};
+  if (fd == -1) return false;
+  close(static_cast<int>(fd));
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeperf_group_of_software_events)
+{
+  if (!CanOpenTaskClock())
+  {
+    BOOST_TEST_MESSAGE("Software perf events unavailable, not testing the group");
+    return;
+  }
+  const PlanePerfGroup group(
+    {
+      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES }
+    }
+  );
+  BOOST_REQUIRE_EQUAL(group.GetSize(),3);
+  BOOST_REQUIRE(group.IsAvailable(0));
+  BOOST_CHECK_EQUAL(group.GetLeader(),group.GetFd(0));
+  //The later events joined the group of the leader
+  BOOST_CHECK(group.IsAvailable(1));
+  BOOST_CHECK(group.IsAvailable(2));
+  BOOST_CHECK(group.GetFd(1) != group.GetLeader());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeperf_group_counts_together)
+{
+  PlanePerfGroup group(
+    {
+      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+    }
+  );
+  if (!CanOpenTaskClock()) return;
+  BOOST_REQUIRE(group.IsAvailable(0));
+  group.Start();
+  volatile double sink{0.0};
+  for (int i=0; i!=1000000; ++i) sink = sink + i;
+  const std::vector<std::uint64_t> values{group.Stop()};
+  //The leader reads the whole group: two counters, enabled and running times, two counts
+  BOOST_REQUIRE_EQUAL(values.size(),5);
+  BOOST_CHECK_EQUAL(values[0],2);
+  BOOST_CHECK_GT(values[2],0);
+  BOOST_CHECK_GT(values[3],0);
+}
+#endif // __linux__
@@ -0,0 +1,322 @@
+#include "planepipeline.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "planequeue.h"
+#include "planetrace.h"
+
+namespace ribi {
+
+///A chunk of points travelling through the pipeline
+template <class Result>
+struct PlanePipelineChunk
+{
+  ///The index of the chunk in the file, used to restore the order
+  std::uint64_t m_index;
+  Plane::Coordinats3D m_points;
+  Result m_result;
+};
+
+///Lets a stage wait for another stage, without using a core while it waits.
+///A stage that changed something another stage may wait for calls Notify.
+///That is once per chunk, which is cheap compared to the chunk itself
+struct PlanePipelineSignal
+{
+  PlanePipelineSignal() : m_mutex{}, m_condition{} {}
+
+  ///Wakes up the waiting stages, to check if what they wait for has happened
+  void Notify()
+  {
+    //Taking the mutex ensures a stage is either still checking, and sees
+    //the change, or is already waiting, and is woken up
+    { const std::lock_guard<std::mutex> lock(m_mutex); }
+    m_condition.notify_all();
+  }
+
+  ///Waits until is_ready returns true. As the wait is often short, this
+  ///first retries a few times, then blocks until the next Notify
+  template <class IsReady>
+  void Wait(const IsReady& is_ready)
+  {
+    for (int i=0; i!=m_n_spins; ++i)
+    {
+      if (is_ready()) return;
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock,is_ready);
+  }
+
+  private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+
+  ///The number of retries before blocking
+  static constexpr int m_n_spins{64};
+};
+
+///The state shared by the stages of the pipeline
+template <class Result>
+struct PlanePipelineState
+{
+  explicit PlanePipelineState(const std::size_t queue_capacity)
+    : m_classified(queue_capacity),
+      m_n_chunks{0},
+      m_n_written{0},
+      m_read(queue_capacity),
+      m_reader_done{false},
+      m_signal{},
+      m_stop{false}
+  {
+  }
+
+  ///Chunks classified by the workers
+  PlaneQueue<PlanePipelineChunk<Result>> m_classified;
+
+  ///The number of chunks read, valid when m_reader_done is true
+  std::atomic<std::uint64_t> m_n_chunks;
+
+  ///The number of chunks given to the function
+  std::atomic<std::uint64_t> m_n_written;
+
+  ///Chunks read by the reader
+  PlaneQueue<PlanePipelineChunk<Result>> m_read;
+
+  ///Has the reader read all chunks?
+  std::atomic<bool> m_reader_done;
+
+  ///Notified after every push, pop and write of a chunk, and when stopping
+  PlanePipelineSignal m_signal;
+
+  ///Set when a stage has thrown, all stages stop as soon as possible
+  std::atomic<bool> m_stop;
+};
+
+///The smallest power of two of at least n
+static std::size_t CalcPowerOfTwo(const std::size_t n) noexcept
+{
+  std::size_t p{2};
+  while (p < n) p *= 2;
+  return p;
+}
+
+template <class Result>
+static void RunPipelineReader(
+  PlanePipelineState<Result>& state,
+  PlanePointReader& reader,
+  const std::size_t n_points,
+  const std::size_t max_chunks
+)
+{
+  std::uint64_t index{0};
+  while (!state.m_stop)
+  {
+    //Backpressure: wait for the oldest chunk to be written
+    state.m_signal.Wait(
+      [&state,index,max_chunks]()
+      {
+        return state.m_stop
+          || index - state.m_n_written.load(std::memory_order_acquire) < max_chunks;
+      }
+    );
+    if (state.m_stop) return;
+    PlanePipelineChunk<Result> chunk;
+    chunk.m_index = index;
+    if (!reader.Read(chunk.m_points,n_points)) break;
+    //There are at most max_chunks chunks in flight, so this only waits briefly
+    bool is_pushed{false};
+    state.m_signal.Wait(
+      [&state,&chunk,&is_pushed]()
+      {
+        return state.m_stop || (is_pushed = state.m_read.TryPush(chunk));
+      }
+    );
+    if (!is_pushed) return;
+    state.m_signal.Notify();
+    ++index;
+  }
+  state.m_n_chunks.store(index,std::memory_order_relaxed);
+  state.m_reader_done.store(true,std::memory_order_release);
+  state.m_signal.Notify();
+}
+
+template <class Result, class Calculate>
+static void RunPipelineWorker(PlanePipelineState<Result>& state, const Calculate& calculate)
+{
+  while (!state.m_stop)
+  {
+    PlanePipelineChunk<Result> chunk;
+    bool is_popped{false};
+    bool is_done{false};
+    state.m_signal.Wait(
+      [&state,&chunk,&is_popped,&is_done]()
+      {
+        if (state.m_stop) return true;
+        //All pushes by the reader are visible after seeing it is done,
+        //so an empty queue then means there is no more work
+        is_done = state.m_reader_done.load(std::memory_order_acquire);
+        is_popped = state.m_read.TryPop(chunk);
+        return is_popped || is_done;
+      }
+    );
+    if (!is_popped) return;
+    //The reader may wait for room in the queue
+    state.m_signal.Notify();
+    {
+      RIBI_PLANE_TRACE_SCOPE("Pipeline calculate chunk");
+      chunk.m_result = calculate(chunk.m_points);
+    }
+    bool is_pushed{false};
+    state.m_signal.Wait(
+      [&state,&chunk,&is_pushed]()
+      {
+        return state.m_stop || (is_pushed = state.m_classified.TryPush(chunk));
+      }
+    );
+    if (!is_pushed) return;
+    state.m_signal.Notify();
+  }
+}
+
+template <class Result, class Function>
+static void RunPipelineWriter(PlanePipelineState<Result>& state, const Function& f)
+{
+  //Chunks calculated before their predecessors
+  std::map<std::uint64_t,PlanePipelineChunk<Result>> pending;
+  std::uint64_t n_written{0};
+  const auto is_all_written = [&state,&n_written]()
+  {
+    return state.m_reader_done.load(std::memory_order_acquire)
+      && n_written == state.m_n_chunks.load(std::memory_order_relaxed);
+  };
+  while (!state.m_stop)
+  {
+    if (is_all_written()) return;
+    PlanePipelineChunk<Result> chunk;
+    bool is_popped{false};
+    state.m_signal.Wait(
+      [&state,&chunk,&is_popped,&is_all_written]()
+      {
+        return state.m_stop
+          || is_all_written()
+          || (is_popped = state.m_classified.TryPop(chunk));
+      }
+    );
+    if (!is_popped) continue;
+    pending.insert(std::make_pair(chunk.m_index,std::move(chunk)));
+    for (auto i = pending.begin(); i != pending.end() && i->first == n_written; i = pending.erase(i))
+    {
+      RIBI_PLANE_TRACE_SCOPE("Pipeline write chunk");
+      f(i->second.m_points,i->second.m_result);
+      ++n_written;
+      state.m_n_written.store(n_written,std::memory_order_release);
+    }
+    //The workers may wait for room in the queue, the reader for chunks to be written
+    state.m_signal.Notify();
+  }
+}
+
+///Runs the pipeline, see ClassifyPointFilePipeline
+template <class Result, class Calculate, class Function>
+static void RunPipeline(
+  PlanePointReader& reader,
+  const Calculate& calculate,
+  const Function& f,
+  const int n_workers,
+  const std::size_t n_points,
+  const std::size_t max_chunks
+)
+{
+  if (n_workers < 1)
+  {
+    throw std::logic_error("PointFilePipeline: the number of workers must be at least one");
+  }
+  if (n_points == 0 || max_chunks == 0)
+  {
+    throw std::logic_error("PointFilePipeline: n_points and max_chunks must be at least one");
+  }
+  PlanePipelineState<Result> state(CalcPowerOfTwo(max_chunks));
+  //One error per thread: the reader, the workers and the writer
+  std::vector<std::exception_ptr> errors(n_workers + 2);
+  const auto run = [&state,&errors](const std::size_t i, const std::function<void()>& stage)
+  {
+    try
+    {
+      stage();
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+      state.m_stop = true;
+      state.m_signal.Notify();
+    }
+  };
+  std::vector<std::thread> threads;
+  try
+  {
+    threads.emplace_back(
+      run,
+      0,
+      [&state,&reader,n_points,max_chunks]() { RunPipelineReader(state,reader,n_points,max_chunks); }
+    );
+    for (int i=0; i!=n_workers; ++i)
+    {
+      threads.emplace_back(run,i + 1,[&state,&calculate]() { RunPipelineWorker(state,calculate); });
+    }
+  }
+  catch (...)
+  {
+    //Stop the threads already started, as destroying a joinable thread terminates
+    state.m_stop = true;
+    state.m_signal.Notify();
+    for (auto& thread: threads) thread.join();
+    throw;
+  }
+  run(n_workers + 1,[&state,&f]() { RunPipelineWriter(state,f); });
+  for (auto& thread: threads) thread.join();
+  for (const auto& error: errors)
+  {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+} //~namespace ribi
+
+void ribi::CalcPointFilePipeline(
+  PlanePointReader& reader,
+  const std::function<std::vector<char>(const Plane::Coordinats3D&)>& calculate,
+  const std::function<void(const Plane::Coordinats3D&, const std::vector<char>&)>& f,
+  const int n_workers,
+  const std::size_t n_points,
+  const std::size_t max_chunks
+)
+{
+  RunPipeline<std::vector<char>>(reader,calculate,f,n_workers,n_points,max_chunks);
+}
+
+void ribi::ClassifyPointFilePipeline(
+  const Plane& plane,
+  PlanePointReader& reader,
+  const std::function<void(const Plane::Coordinats3D&, const std::vector<bool>&)>& f,
+  const int n_workers,
+  const std::size_t n_points,
+  const std::size_t max_chunks
+)
+{
+  RunPipeline<std::vector<bool>>(
+    reader,
+    [&plane](const Plane::Coordinats3D& points) { return plane.IsInPlane(points); },
+    f,
+    n_workers,
+    n_points,
+    max_chunks
+  );
+}
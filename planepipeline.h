@@ -0,0 +1,54 @@
+#ifndef RIBI_PLANEPIPELINE_H
+#define RIBI_PLANEPIPELINE_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "plane.h"
+#include "planepointreader.h"
+
+namespace ribi {
+
+///Calls the function on each chunk of at most n_points points read
+///by the reader, together with the points being in the plane or not,
+///in the order the chunks are read.
+///
+///The work is done by a pipeline of three stages, connected by PlaneQueues:
+/// - a reader thread, reading the chunks
+/// - n_workers worker threads, classifying the chunks
+/// - the calling thread, calling the function on the chunks, in order
+///At most max_chunks chunks are in the pipeline at the same time: the
+///reader waits until the function is called on the oldest one, so a fast
+///reader cannot fill memory when the function or the workers are slow.
+///
+///Throws std::logic_error if n_workers, n_points or max_chunks is zero.
+///Throws what the reader, the classification or the function throws,
+///after all threads have stopped
+void ClassifyPointFilePipeline(
+  const Plane& plane,
+  PlanePointReader& reader,
+  const std::function<void(const Plane::Coordinats3D&, const std::vector<bool>&)>& f,
+  const int n_workers,
+  const std::size_t n_points = 1 << 16,
+  const std::size_t max_chunks = 16
+);
+
+///Calls the function on each chunk of at most n_points points read by the
+///reader, together with the bytes calculated from them, in the order the
+///chunks are read. The calculation is done by the n_workers workers of
+///the pipeline of ClassifyPointFilePipeline, so it must be safe to call
+///from multiple threads at the same time.
+///Throws as ClassifyPointFilePipeline does
+void CalcPointFilePipeline(
+  PlanePointReader& reader,
+  const std::function<std::vector<char>(const Plane::Coordinats3D&)>& calculate,
+  const std::function<void(const Plane::Coordinats3D&, const std::vector<char>&)>& f,
+  const int n_workers,
+  const std::size_t n_points = 1 << 16,
+  const std::size_t max_chunks = 16
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPIPELINE_H
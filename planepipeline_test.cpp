@@ -0,0 +1,148 @@
+#include "planepipeline.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planepipeline_classify)
+{
+  const std::string filename{"ribi_planepipeline_classify.xyz"};
+  //z = (2*x) + (3*y) + 5
+  const Plane p(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  {
+    std::ofstream f(filename.c_str());
+    for (int i=0; i!=50000; ++i)
+    {
+      const double x{static_cast<double>(i)};
+      const double y{static_cast<double>(i % 7)};
+      f << x << ' ' << y << ' ' << ((2.0 * x) + (3.0 * y) + 5.0 + (i % 3 == 0 ? 1.0 : 0.0)) << '\n';
+    }
+  }
+  for (const int n_workers: { 1, 3 })
+  {
+    PlanePointReader r(filename);
+    int n_points{0};
+    bool in_order{true};
+    bool is_correct{true};
+    ClassifyPointFilePipeline(
+      p,
+      r,
+      [&](const Plane::Coordinats3D& points, const std::vector<bool>& is_in_plane)
+      {
+        BOOST_REQUIRE(points.size() == is_in_plane.size());
+        for (std::size_t i=0; i!=points.size(); ++i)
+        {
+          const int index{static_cast<int>(boost::geometry::get<0>(points[i]))};
+          in_order = in_order && index == n_points;
+          is_correct = is_correct && is_in_plane[i] == (index % 3 != 0);
+          ++n_points;
+        }
+      },
+      n_workers,
+      1000,
+      4
+    );
+    BOOST_CHECK_EQUAL(n_points,50000);
+    BOOST_CHECK(in_order);
+    BOOST_CHECK(is_correct);
+  }
+  //An exception of the function stops the pipeline and is rethrown
+  {
+    PlanePointReader r(filename);
+    int n_chunks{0};
+    BOOST_CHECK_THROW(
+      ClassifyPointFilePipeline(
+        p,
+        r,
+        [&n_chunks](const Plane::Coordinats3D&, const std::vector<bool>&)
+        {
+          if (++n_chunks == 3) throw std::runtime_error("stop");
+        },
+        2,
+        1000
+      ),
+      std::runtime_error
+    );
+    BOOST_CHECK_EQUAL(n_chunks,3);
+  }
+  {
+    PlanePointReader r(filename);
+    BOOST_CHECK_THROW(
+      ClassifyPointFilePipeline(p,r,[](const Plane::Coordinats3D&, const std::vector<bool>&) {},0),
+      std::logic_error
+    );
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepipeline_calc)
+{
+  const std::string filename{"ribi_planepipeline_calc.xyz"};
+  {
+    std::ofstream f(filename.c_str());
+    for (int i=0; i!=10000; ++i) f << i << " 0 0\n";
+  }
+  PlanePointReader r(filename);
+  std::vector<char> bytes;
+  CalcPointFilePipeline(
+    r,
+    [](const Plane::Coordinats3D& points)
+    {
+      std::vector<char> v;
+      for (const auto& point: points) v.push_back(static_cast<char>(static_cast<int>(boost::geometry::get<0>(point)) % 100));
+      return v;
+    },
+    [&bytes](const Plane::Coordinats3D&, const std::vector<char>& v) { bytes.insert(bytes.end(),v.begin(),v.end()); },
+    4,
+    100,
+    2
+  );
+  BOOST_REQUIRE_EQUAL(bytes.size(),10000);
+  bool in_order{true};
+  for (int i=0; i!=10000; ++i) in_order = in_order && bytes[i] == i % 100;
+  BOOST_CHECK(in_order);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepipeline_waits_without_spinning)
+{
+  const std::string filename{"ribi_planepipeline_waits.xyz"};
+  {
+    std::ofstream f(filename.c_str());
+    for (int i=0; i!=1000; ++i) f << i << " 0 0\n";
+  }
+  //While the one worker sleeps, the reader, the other workers and the
+  //writer have nothing to do, and must not use a core for waiting
+  PlanePointReader r(filename);
+  const std::clock_t cpu_start{std::clock()};
+  const auto start = std::chrono::steady_clock::now();
+  int n_chunks{0};
+  CalcPointFilePipeline(
+    r,
+    [](const Plane::Coordinats3D&)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      return std::vector<char>();
+    },
+    [&n_chunks](const Plane::Coordinats3D&, const std::vector<char>&) { ++n_chunks; },
+    1,
+    100,
+    2
+  );
+  const double cpu_seconds{static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC};
+  const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+  BOOST_CHECK_EQUAL(n_chunks,10);
+  BOOST_CHECK(seconds >= 0.2);
+  BOOST_CHECK_MESSAGE(cpu_seconds < 0.5 * seconds,"CPU " << cpu_seconds << " s in " << seconds << " s");
+  std::remove(filename.c_str());
+}
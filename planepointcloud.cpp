@@ -0,0 +1,284 @@
+#include "planepointcloud.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace ribi {
+
+typedef std::array<double,3> Vector3D;
+
+static constexpr double pi{3.14159265358979323846};
+
+///A small random number generator (SplitMix64), that is cheap to seed,
+///so that each point can have its own
+struct PlanePointCloudRandom
+{
+  explicit PlanePointCloudRandom(const std::uint64_t seed) noexcept : m_state{seed} {}
+
+  std::uint64_t Next() noexcept
+  {
+    m_state += 0x9e3779b97f4a7c15ull;
+    std::uint64_t z{m_state};
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  ///Uniform in [0,1)
+  double NextUniform() noexcept
+  {
+    return static_cast<double>(Next() >> 11) * 0x1.0p-53;
+  }
+
+  ///Uniform in [-1,1)
+  double NextSigned() noexcept { return (2.0 * NextUniform()) - 1.0; }
+
+  ///Standard normal, using the Box-Muller transform
+  double NextNormal() noexcept
+  {
+    const double u1{1.0 - NextUniform()}; //In (0,1], so its log is finite
+    const double u2{NextUniform()};
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * pi * u2);
+  }
+
+  std::uint64_t m_state;
+};
+
+///The generator of a point, which depends on the seed and the index only
+static PlanePointCloudRandom CreatePointRandom(const std::uint64_t seed, const std::int64_t index) noexcept
+{
+  PlanePointCloudRandom mix(seed ^ (static_cast<std::uint64_t>(index) * 0xd1b54a32d192ed03ull));
+  return PlanePointCloudRandom(mix.Next());
+}
+
+static Vector3D Cross(const Vector3D& a, const Vector3D& b) noexcept
+{
+  return {
+    (a[1] * b[2]) - (a[2] * b[1]),
+    (a[2] * b[0]) - (a[0] * b[2]),
+    (a[0] * b[1]) - (a[1] * b[0])
+  };
+}
+
+static Vector3D Normalize(const Vector3D& a) noexcept
+{
+  const double length{std::sqrt((a[0] * a[0]) + (a[1] * a[1]) + (a[2] * a[2]))};
+  return { a[0] / length, a[1] / length, a[2] / length };
+}
+
+static void CheckPointCloudConfig(const PlanePointCloudConfig& config)
+{
+  if (config.m_n_planes < 1)
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: there must be at least one plane");
+  }
+  if (!(config.m_magnitude > 0.0) || std::isinf(config.m_magnitude))
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: magnitude must be positive and finite");
+  }
+  //Below this, the extent of a plane has too few bits left to put three
+  //different points on it, down to denorm_min, where all points are equal
+  if (config.m_magnitude < std::numeric_limits<double>::min())
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: magnitude must be at least the smallest normal double");
+  }
+  if (!(config.m_noise >= 0.0) || std::isinf(config.m_noise))
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: noise must be non-negative and finite");
+  }
+  if (config.m_noise > 0.0 && config.m_noise * config.m_magnitude == 0.0)
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: noise must not underflow to zero at this magnitude");
+  }
+  if (!(config.m_outlier_ratio >= 0.0 && config.m_outlier_ratio <= 1.0))
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: outlier ratio must be in [0,1]");
+  }
+  if (!(config.m_tilted_weight >= 0.0)
+    || !(config.m_horizontal_weight >= 0.0)
+    || !(config.m_vertical_weight >= 0.0)
+    || !(config.m_tilted_weight + config.m_horizontal_weight + config.m_vertical_weight > 0.0)
+  )
+  {
+    throw std::invalid_argument("PlanePointCloudConfig: orientation weights must be non-negative, with a positive sum");
+  }
+}
+
+///Generate the points of [first,last) into the buffers, all indexed by point index minus offset
+static void GeneratePointCloudRange(
+  const PlanePointCloudConfig& config,
+  const std::vector<PlanePointCloudPlane>& planes,
+  const std::int64_t first,
+  const std::int64_t last,
+  const std::int64_t offset,
+  double * const x,
+  double * const y,
+  double * const z,
+  std::int32_t * const plane_indices
+) noexcept
+{
+  const double noise{config.m_noise * config.m_magnitude};
+  const std::uint64_t n_planes{planes.size()};
+  for (std::int64_t i=first; i!=last; ++i)
+  {
+    PlanePointCloudRandom random{CreatePointRandom(config.m_seed,i)};
+    const std::size_t j{static_cast<std::size_t>(i - offset)};
+    if (random.NextUniform() < config.m_outlier_ratio)
+    {
+      x[j] = random.NextSigned() * config.m_magnitude;
+      y[j] = random.NextSigned() * config.m_magnitude;
+      z[j] = random.NextSigned() * config.m_magnitude;
+      if (plane_indices) plane_indices[j] = -1;
+      continue;
+    }
+    const std::uint64_t plane_index{random.Next() % n_planes};
+    const PlanePointCloudPlane& p = planes[plane_index];
+    const double s{random.NextSigned() * p.m_extent};
+    const double t{random.NextSigned() * p.m_extent};
+    const double d{noise == 0.0 ? 0.0 : random.NextNormal() * noise};
+    x[j] = p.m_center[0] + (s * p.m_u[0]) + (t * p.m_v[0]) + (d * p.m_normal[0]);
+    y[j] = p.m_center[1] + (s * p.m_u[1]) + (t * p.m_v[1]) + (d * p.m_normal[1]);
+    z[j] = p.m_center[2] + (s * p.m_u[2]) + (t * p.m_v[2]) + (d * p.m_normal[2]);
+    if (plane_indices) plane_indices[j] = static_cast<std::int32_t>(plane_index);
+  }
+}
+
+} //~namespace ribi
+
+std::array<ribi::Plane::Coordinat3D,3> ribi::PlanePointCloudPlane::GetPoints() const noexcept
+{
+  const double e{m_extent};
+  return {
+    Plane::Coordinat3D(m_center[0],m_center[1],m_center[2]),
+    Plane::Coordinat3D(m_center[0] + (e * m_u[0]),m_center[1] + (e * m_u[1]),m_center[2] + (e * m_u[2])),
+    Plane::Coordinat3D(m_center[0] + (e * m_v[0]),m_center[1] + (e * m_v[1]),m_center[2] + (e * m_v[2]))
+  };
+}
+
+std::vector<ribi::PlanePointCloudPlane> ribi::CreatePointCloudPlanes(const PlanePointCloudConfig& config)
+{
+  CheckPointCloudConfig(config);
+  //A stream of its own, different from that of any point
+  PlanePointCloudRandom random{CreatePointRandom(~config.m_seed,-1)};
+  const double sum{config.m_tilted_weight + config.m_horizontal_weight + config.m_vertical_weight};
+  std::vector<PlanePointCloudPlane> planes;
+  planes.reserve(config.m_n_planes);
+  for (int i=0; i!=config.m_n_planes; ++i)
+  {
+    //The center is at most half the magnitude from the origin, and the
+    //points at most a quarter of it along u and v from the center
+    PlanePointCloudPlane p;
+    const double half{config.m_magnitude * 0.5};
+    p.m_extent = config.m_magnitude * 0.25;
+    p.m_center = { random.NextSigned() * half, random.NextSigned() * half, random.NextSigned() * half };
+    const double orientation{random.NextUniform() * sum};
+    if (orientation < config.m_tilted_weight)
+    {
+      //A random direction, not too close to an axis
+      do
+      {
+        p.m_normal = Normalize({ random.NextNormal(), random.NextNormal(), random.NextNormal() });
+      }
+      while (std::abs(p.m_normal[0]) < 0.1 || std::abs(p.m_normal[1]) < 0.1 || std::abs(p.m_normal[2]) < 0.1);
+    }
+    else if (orientation < config.m_tilted_weight + config.m_horizontal_weight)
+    {
+      p.m_normal = { 0.0, 0.0, 1.0 };
+    }
+    else
+    {
+      const double angle{random.NextUniform() * 2.0 * pi};
+      p.m_normal = { std::cos(angle), std::sin(angle), 0.0 };
+    }
+    //u is perpendicular to the normal and to the axis the normal is least along
+    const Vector3D axis{
+      std::abs(p.m_normal[0]) <= std::abs(p.m_normal[1]) && std::abs(p.m_normal[0]) <= std::abs(p.m_normal[2])
+        ? Vector3D{1.0,0.0,0.0}
+        : std::abs(p.m_normal[1]) <= std::abs(p.m_normal[2]) ? Vector3D{0.0,1.0,0.0} : Vector3D{0.0,0.0,1.0}
+    };
+    p.m_u = Normalize(Cross(p.m_normal,axis));
+    p.m_v = Cross(p.m_normal,p.m_u);
+    planes.push_back(p);
+  }
+  return planes;
+}
+
+void ribi::GeneratePointCloud(
+  const PlanePointCloudConfig& config,
+  const std::vector<PlanePointCloudPlane>& planes,
+  const std::int64_t first_point,
+  const std::int64_t n_points,
+  double * const x,
+  double * const y,
+  double * const z,
+  std::int32_t * const plane_indices,
+  const int n_threads
+)
+{
+  CheckPointCloudConfig(config);
+  if (planes.size() != static_cast<std::size_t>(config.m_n_planes))
+  {
+    throw std::invalid_argument("GeneratePointCloud: the planes must be those of the configuration");
+  }
+  if (first_point < 0 || n_points < 0)
+  {
+    throw std::invalid_argument("GeneratePointCloud: point indices cannot be negative");
+  }
+  if (n_threads < 1)
+  {
+    throw std::logic_error("GeneratePointCloud: need at least one thread");
+  }
+  const auto generate_range = [&](const int i)
+  {
+    GeneratePointCloudRange(
+      config,
+      planes,
+      first_point + (n_points * i / n_threads),
+      first_point + (n_points * (i + 1) / n_threads),
+      first_point,
+      x,
+      y,
+      z,
+      plane_indices
+    );
+  };
+  std::vector<std::thread> threads;
+  for (int i=1; i<n_threads; ++i)
+  {
+    threads.emplace_back(generate_range,i);
+  }
+  generate_range(0);
+  for (auto& thread: threads) { thread.join(); }
+}
+
+ribi::PlanePointCloud ribi::CreatePointCloud(
+  const PlanePointCloudConfig& config,
+  const std::int64_t n_points,
+  const int n_threads
+)
+{
+  if (n_points < 0)
+  {
+    throw std::invalid_argument("CreatePointCloud: number of points cannot be negative");
+  }
+  PlanePointCloud cloud;
+  cloud.m_planes = CreatePointCloudPlanes(config);
+  cloud.m_x.resize(n_points);
+  cloud.m_y.resize(n_points);
+  cloud.m_z.resize(n_points);
+  cloud.m_plane_indices.resize(n_points);
+  GeneratePointCloud(
+    config,
+    cloud.m_planes,
+    0,
+    n_points,
+    cloud.m_x.data(),
+    cloud.m_y.data(),
+    cloud.m_z.data(),
+    cloud.m_plane_indices.data(),
+    n_threads
+  );
+  return cloud;
+}
@@ -0,0 +1,115 @@
+#ifndef RIBI_PLANEPOINTCLOUD_H
+#define RIBI_PLANEPOINTCLOUD_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "plane.h"
+
+namespace ribi {
+
+///How to generate a synthetic point cloud: points on and near planes,
+///and outliers
+struct PlanePointCloudConfig
+{
+  ///The number of planes the points are sampled on
+  int m_n_planes{16};
+
+  ///All coordinats are at most about this magnitude, for example a value
+  ///of GetPlaneAccuracySeries, which includes the extremes of GetTestSeries.
+  ///Must be at least std::numeric_limits<double>::min(): smaller magnitudes
+  ///are subnormal, with too few bits to put three different points on a plane
+  double m_magnitude{1000.0};
+
+  ///The standard deviation of the distance of a point to its plane,
+  ///as a fraction of the magnitude. Zero puts the points on the plane,
+  ///up to rounding. Must not underflow to zero when multiplied by the magnitude
+  double m_noise{0.0};
+
+  ///The fraction of points that are outliers: random in the bounding box
+  double m_outlier_ratio{0.0};
+
+  ///The relative number of planes of each orientation: tilted in
+  ///a random direction, horizontal (Z is constant) and vertical
+  ///(cannot be expressed as Z)
+  double m_tilted_weight{1.0};
+  double m_horizontal_weight{0.0};
+  double m_vertical_weight{0.0};
+
+  ///The same seed and configuration give the same points
+  std::uint64_t m_seed{42};
+};
+
+///A plane of a point cloud: its center and two perpendicular unit
+///vectors in it. Its points are center + (s * u) + (t * v) + (noise * normal),
+///with s and t in [-m_extent,m_extent)
+struct PlanePointCloudPlane
+{
+  double m_extent;
+  std::array<double,3> m_center;
+  std::array<double,3> m_u;
+  std::array<double,3> m_v;
+  std::array<double,3> m_normal;
+
+  ///Three points in the plane, to construct a Plane from: the center,
+  ///and m_extent along u and along v from it
+  std::array<Plane::Coordinat3D,3> GetPoints() const noexcept;
+};
+
+///The planes of a point cloud.
+///Throws std::invalid_argument if the configuration is invalid
+std::vector<PlanePointCloudPlane> CreatePointCloudPlanes(const PlanePointCloudConfig& config);
+
+///Generate the points [first_point,first_point + n_points) of a point
+///cloud, as a structure of arrays: point i is written to x[i], y[i] and
+///z[i], and the index of its plane, or -1 for an outlier, to
+///plane_indices[i] if plane_indices is not null.
+///
+///A point only depends on the configuration and its index, so a cloud of
+///billions of points can be generated in chunks, with any number of
+///threads, with the same result.
+///Throws std::invalid_argument if the configuration is invalid or the planes are not its planes.
+///Throws std::logic_error if the number of threads is less than one
+void GeneratePointCloud(
+  const PlanePointCloudConfig& config,
+  const std::vector<PlanePointCloudPlane>& planes,
+  const std::int64_t first_point,
+  const std::int64_t n_points,
+  double * const x,
+  double * const y,
+  double * const z,
+  std::int32_t * const plane_indices,
+  const int n_threads
+);
+
+///The points of a point cloud, as a structure of arrays
+struct PlanePointCloud
+{
+  std::vector<PlanePointCloudPlane> m_planes;
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_z;
+
+  ///The index of the plane of each point in m_planes, -1 for an outlier
+  std::vector<std::int32_t> m_plane_indices;
+
+  ///Point i as a Coordinat3D, for the functions that take these
+  Plane::Coordinat3D GetPoint(const std::size_t i) const noexcept
+  {
+    return Plane::Coordinat3D(m_x[i],m_y[i],m_z[i]);
+  }
+
+  std::size_t GetSize() const noexcept { return m_x.size(); }
+};
+
+///Create the first n_points points of a point cloud, as GeneratePointCloud does
+PlanePointCloud CreatePointCloud(
+  const PlanePointCloudConfig& config,
+  const std::int64_t n_points,
+  const int n_threads
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPOINTCLOUD_H
@@ -0,0 +1,176 @@
+#include "planepointcloud.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "planeaccuracy.h"
+
+using namespace ribi;
+
+BOOST_AUTO_TEST_CASE(ribi_planepointcloud_points_are_on_their_plane)
+{
+  PlanePointCloudConfig config;
+  config.m_n_planes = 4;
+  config.m_outlier_ratio = 0.25;
+  const PlanePointCloud cloud{CreatePointCloud(config,1000,2)};
+  BOOST_REQUIRE_EQUAL(cloud.GetSize(),1000);
+  BOOST_REQUIRE_EQUAL(cloud.m_planes.size(),4);
+  int n_outliers{0};
+  for (std::size_t i=0; i!=cloud.GetSize(); ++i)
+  {
+    const std::int32_t index{cloud.m_plane_indices[i]};
+    BOOST_CHECK(std::abs(cloud.m_x[i]) <= config.m_magnitude);
+    BOOST_CHECK(std::abs(cloud.m_y[i]) <= config.m_magnitude);
+    BOOST_CHECK(std::abs(cloud.m_z[i]) <= config.m_magnitude);
+    if (index == -1)
+    {
+      ++n_outliers;
+      continue;
+    }
+    const auto p = cloud.m_planes[index].GetPoints();
+    const Plane plane(p[0],p[1],p[2]);
+    BOOST_CHECK(plane.CalcError(cloud.GetPoint(i)) < 1.0e-9);
+  }
+  BOOST_CHECK(n_outliers > 150 && n_outliers < 350);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointcloud_is_independent_of_threads_and_chunks)
+{
+  PlanePointCloudConfig config;
+  config.m_noise = 0.01;
+  config.m_outlier_ratio = 0.1;
+  config.m_horizontal_weight = 1.0;
+  config.m_vertical_weight = 1.0;
+  config.m_seed = 12345;
+  const PlanePointCloud one{CreatePointCloud(config,1000,1)};
+  const PlanePointCloud many{CreatePointCloud(config,1000,7)};
+  BOOST_CHECK(one.m_x == many.m_x);
+  BOOST_CHECK(one.m_y == many.m_y);
+  BOOST_CHECK(one.m_z == many.m_z);
+  BOOST_CHECK(one.m_plane_indices == many.m_plane_indices);
+
+  //Points [600,700) generated on their own
+  std::vector<double> x(100);
+  std::vector<double> y(100);
+  std::vector<double> z(100);
+  GeneratePointCloud(config,one.m_planes,600,100,x.data(),y.data(),z.data(),nullptr,3);
+  for (std::size_t i=0; i!=x.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(x[i],one.m_x[600 + i]);
+    BOOST_CHECK_EQUAL(y[i],one.m_y[600 + i]);
+    BOOST_CHECK_EQUAL(z[i],one.m_z[600 + i]);
+  }
+
+  //Another seed, other points
+  config.m_seed = 54321;
+  const PlanePointCloud other{CreatePointCloud(config,1000,1)};
+  BOOST_CHECK(one.m_x != other.m_x);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointcloud_orientations)
+{
+  PlanePointCloudConfig config;
+  config.m_n_planes = 10;
+  config.m_tilted_weight = 0.0;
+  config.m_horizontal_weight = 1.0;
+  for (const auto& p: CreatePointCloudPlanes(config))
+  {
+    const auto q = p.GetPoints();
+    const Plane plane(q[0],q[1],q[2]);
+    BOOST_CHECK(plane.CanCalcZ());
+    BOOST_CHECK(!plane.CanCalcX());
+    BOOST_CHECK(!plane.CanCalcY());
+  }
+  config.m_horizontal_weight = 0.0;
+  config.m_vertical_weight = 1.0;
+  for (const auto& p: CreatePointCloudPlanes(config))
+  {
+    const auto q = p.GetPoints();
+    BOOST_CHECK(!Plane(q[0],q[1],q[2]).CanCalcZ());
+  }
+  config.m_vertical_weight = 0.0;
+  config.m_tilted_weight = 1.0;
+  for (const auto& p: CreatePointCloudPlanes(config))
+  {
+    const auto q = p.GetPoints();
+    const Plane plane(q[0],q[1],q[2]);
+    BOOST_CHECK(plane.CanCalcX() && plane.CanCalcY() && plane.CanCalcZ());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointcloud_extreme_magnitudes_stay_finite)
+{
+  for (const double magnitude: GetPlaneAccuracySeries())
+  {
+    PlanePointCloudConfig config;
+    config.m_magnitude = magnitude;
+    config.m_outlier_ratio = 0.5;
+    config.m_tilted_weight = 1.0;
+    config.m_horizontal_weight = 1.0;
+    config.m_vertical_weight = 1.0;
+    if (magnitude < std::numeric_limits<double>::min())
+    {
+      BOOST_CHECK_THROW(CreatePointCloudPlanes(config),std::invalid_argument);
+      continue;
+    }
+    const PlanePointCloud cloud{CreatePointCloud(config,200,2)};
+    for (std::size_t i=0; i!=cloud.GetSize(); ++i)
+    {
+      BOOST_CHECK(std::isfinite(cloud.m_x[i]) && std::abs(cloud.m_x[i]) <= magnitude);
+      BOOST_CHECK(std::isfinite(cloud.m_y[i]) && std::abs(cloud.m_y[i]) <= magnitude);
+      BOOST_CHECK(std::isfinite(cloud.m_z[i]) && std::abs(cloud.m_z[i]) <= magnitude);
+    }
+    //The three points of each plane are not on one line
+    for (const auto& plane: cloud.m_planes)
+    {
+      const std::array<Plane::Coordinat3D,3> p{plane.GetPoints()};
+      //The differences with the first point, scaled by a power of two to
+      //about one, so that their cross product does not underflow
+      const int e{std::ilogb(plane.m_extent)};
+      std::array<std::array<double,3>,2> d;
+      for (int j=0; j!=2; ++j)
+      {
+        d[j] = {
+          std::ldexp(boost::geometry::get<0>(p[j + 1]) - boost::geometry::get<0>(p[0]),-e),
+          std::ldexp(boost::geometry::get<1>(p[j + 1]) - boost::geometry::get<1>(p[0]),-e),
+          std::ldexp(boost::geometry::get<2>(p[j + 1]) - boost::geometry::get<2>(p[0]),-e)
+        };
+      }
+      const double nx{(d[0][1] * d[1][2]) - (d[0][2] * d[1][1])};
+      const double ny{(d[0][2] * d[1][0]) - (d[0][0] * d[1][2])};
+      const double nz{(d[0][0] * d[1][1]) - (d[0][1] * d[1][0])};
+      BOOST_CHECK_GT(std::sqrt((nx * nx) + (ny * ny) + (nz * nz)),0.5);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointcloud_invalid_arguments_throw)
+{
+  PlanePointCloudConfig config;
+  BOOST_CHECK_THROW(CreatePointCloud(config,-1,1),std::invalid_argument);
+  BOOST_CHECK_THROW(CreatePointCloud(config,10,0),std::logic_error);
+  const std::vector<PlanePointCloudPlane> planes{CreatePointCloudPlanes(config)};
+  double x{0.0};
+  BOOST_CHECK_THROW(
+    GeneratePointCloud(config,std::vector<PlanePointCloudPlane>(),0,1,&x,&x,&x,nullptr,1),
+    std::invalid_argument
+  );
+  config.m_outlier_ratio = 1.5;
+  BOOST_CHECK_THROW(CreatePointCloudPlanes(config),std::invalid_argument);
+  config.m_outlier_ratio = 0.0;
+  config.m_magnitude = 0.0;
+  BOOST_CHECK_THROW(CreatePointCloudPlanes(config),std::invalid_argument);
+  config.m_magnitude = 1.0;
+  config.m_tilted_weight = 0.0;
+  BOOST_CHECK_THROW(CreatePointCloudPlanes(config),std::invalid_argument);
+  config.m_tilted_weight = 1.0;
+  config.m_noise = -1.0;
+  BOOST_CHECK_THROW(CreatePointCloudPlanes(config),std::invalid_argument);
+  config.m_noise = 0.0;
+  config.m_n_planes = 0;
+  BOOST_CHECK_THROW(CreatePointCloudPlanes(config),std::invalid_argument);
+}
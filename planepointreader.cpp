@@ -0,0 +1,381 @@
+#include "planepointreader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+
+#include "planetrace.h"
+
+namespace ribi {
+
+///Is this machine big endian?
+static bool IsBigEndian() noexcept
+{
+  const std::uint16_t one{1};
+  char first_byte{0};
+  std::memcpy(&first_byte,&one,1);
+  return first_byte == 0;
+}
+
+static bool IsSpaceOrTab(const char c) noexcept
+{
+  return c == ' ' || c == '\t';
+}
+
+///Reads chunks of points into two buffers, letting a second thread read the
+///next chunk while the current one is calculated and given to the function
+template <class Result, class Calculate, class Function>
+static void ProcessPointFile(
+  PlanePointReader& reader,
+  const std::size_t n_points,
+  const Calculate& calculate,
+  const Function& f
+)
+{
+  assert(n_points > 0);
+  Plane::Coordinats3D current;
+  Plane::Coordinats3D next;
+  bool has_current{reader.Read(current,n_points)};
+  while (has_current)
+  {
+    //If the calculation throws, the destructor of the future waits for the reading
+    std::future<bool> has_next{
+      std::async(
+        std::launch::async,
+        [&reader,&next,n_points]() { return reader.Read(next,n_points); }
+      )
+    };
+    RIBI_PLANE_TRACE_SCOPE("ProcessPointFile chunk");
+    const Result result{calculate(current)};
+    f(current,result);
+    has_current = has_next.get();
+    std::swap(current,next);
+  }
+}
+
+} //~namespace ribi
+
+ribi::PlanePointReader::PlanePointReader(const std::string& filename)
+  : m_buffer(1 << 20,'\0'),
+    m_buffer_begin{0},
+    m_buffer_end{0},
+    m_file(filename.c_str(),std::ios::binary),
+    m_filename{filename},
+    m_format{Format::xyz},
+    m_n_lines_read{0},
+    m_n_points_read{0},
+    m_ply_n_points{0},
+    m_ply_offsets{0,0,0},
+    m_ply_is_big_endian{false},
+    m_ply_stride{0},
+    m_ply_types{PlyType::float64,PlyType::float64,PlyType::float64}
+{
+  if (!m_file.is_open())
+  {
+    throw std::runtime_error("PlanePointReader: cannot open file '" + filename + "'");
+  }
+  char start[4] = { '\0', '\0', '\0', '\0' };
+  m_file.read(start,4);
+  const bool is_ply{
+    m_file.gcount() == 4
+    && std::string(start,3) == "ply"
+    && (start[3] == '\n' || start[3] == '\r')
+  };
+  m_file.clear();
+  m_file.seekg(0);
+  if (is_ply)
+  {
+    m_format = Format::ply;
+    ReadPlyHeader();
+  }
+}
+
+std::size_t ribi::PlanePointReader::GetSize(const PlyType type) noexcept
+{
+  switch (type)
+  {
+    case PlyType::int8: case PlyType::uint8: return 1;
+    case PlyType::int16: case PlyType::uint16: return 2;
+    case PlyType::int32: case PlyType::uint32: case PlyType::float32: return 4;
+    case PlyType::float64: return 8;
+  }
+  assert(!"Should not get here");
+  return 0;
+}
+
+bool ribi::PlanePointReader::Read(Coordinats3D& points, const std::size_t n)
+{
+  RIBI_PLANE_TRACE_SCOPE("PlanePointReader::Read");
+  points.clear();
+  if (n == 0) return false;
+  return m_format == Format::ply ? ReadPly(points,n) : ReadXyz(points,n);
+}
+
+bool ribi::PlanePointReader::ReadLine(const char *& begin, const char *& end)
+{
+  while (1)
+  {
+    char * const data{m_buffer.data()};
+    const char * const first{data + m_buffer_begin};
+    const char * const last{data + m_buffer_end};
+    const char * const newline{std::find(first,last,'\n')};
+    if (newline != last)
+    {
+      begin = first;
+      //A CRLF line ends at the carriage return, so strtod cannot skip it
+      end = newline != first && *(newline - 1) == '\r' ? newline - 1 : newline;
+      m_buffer_begin = static_cast<std::size_t>(newline - data) + 1;
+      return true;
+    }
+    if (!m_file)
+    {
+      //The last line, which has no newline
+      if (first == last) return false;
+      begin = first;
+      end = *(last - 1) == '\r' ? last - 1 : last;
+      m_buffer_begin = m_buffer_end;
+      return true;
+    }
+    //Move the start of the line to the front, then read more of it
+    const std::size_t n_kept{m_buffer_end - m_buffer_begin};
+    const std::size_t capacity{m_buffer.size() - 1};
+    if (n_kept == capacity)
+    {
+      std::stringstream msg;
+      msg << "PlanePointReader: line " << (m_n_lines_read + 1)
+        << " of file '" << m_filename << "' is too long";
+      throw std::runtime_error(msg.str());
+    }
+    std::memmove(data,first,n_kept);
+    m_file.read(data + n_kept,static_cast<std::streamsize>(capacity - n_kept));
+    m_buffer_begin = 0;
+    m_buffer_end = n_kept + static_cast<std::size_t>(m_file.gcount());
+    data[m_buffer_end] = '\0';
+  }
+}
+
+void ribi::PlanePointReader::ReadPlyHeader()
+{
+  std::string line;
+  std::getline(m_file,line);
+  bool has_format{false};
+  bool has_vertex{false};
+  bool has_coordinat[3] = { false, false, false };
+  while (1)
+  {
+    if (!std::getline(m_file,line))
+    {
+      throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' has no end of header");
+    }
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    std::stringstream s(line);
+    std::string keyword;
+    s >> keyword;
+    if (keyword == "end_header") break;
+    if (keyword == "format")
+    {
+      std::string format;
+      s >> format;
+      if (format == "binary_little_endian") m_ply_is_big_endian = false;
+      else if (format == "binary_big_endian") m_ply_is_big_endian = true;
+      else
+      {
+        throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' is not binary");
+      }
+      has_format = true;
+    }
+    else if (keyword == "element")
+    {
+      //The elements after the vertex element are not read
+      if (has_vertex) break;
+      std::string name;
+      s >> name >> m_ply_n_points;
+      if (name != "vertex")
+      {
+        throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' must start with the vertex element");
+      }
+      has_vertex = true;
+    }
+    else if (keyword == "property" && has_vertex)
+    {
+      std::string type;
+      std::string name;
+      s >> type >> name;
+      if (type == "list")
+      {
+        throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' has a list in its vertex element");
+      }
+      const PlyType ply_type{ToPlyType(type)};
+      for (int i=0; i!=3; ++i)
+      {
+        if (name == std::string(1,static_cast<char>('x' + i)))
+        {
+          m_ply_offsets[i] = m_ply_stride;
+          m_ply_types[i] = ply_type;
+          has_coordinat[i] = true;
+        }
+      }
+      m_ply_stride += GetSize(ply_type);
+    }
+  }
+  //Skip the rest of the header, if the vertex element is followed by others
+  while (line != "end_header")
+  {
+    if (!std::getline(m_file,line))
+    {
+      throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' has no end of header");
+    }
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+  }
+  if (!has_format || !has_vertex || !has_coordinat[0] || !has_coordinat[1] || !has_coordinat[2])
+  {
+    throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' has no binary x, y and z");
+  }
+}
+
+bool ribi::PlanePointReader::ReadPly(Coordinats3D& points, const std::size_t n)
+{
+  assert(m_ply_stride > 0);
+  const std::size_t n_wanted{
+    static_cast<std::size_t>(std::min<std::uint64_t>(n,m_ply_n_points - m_n_points_read))
+  };
+  if (n_wanted == 0) return false;
+  points.reserve(n_wanted);
+  const std::size_t n_per_block{std::max<std::size_t>(1,m_buffer.size() / m_ply_stride)};
+  if (m_buffer.size() < m_ply_stride) m_buffer.resize(m_ply_stride);
+  while (points.size() != n_wanted)
+  {
+    const std::size_t n_block{std::min(n_per_block,n_wanted - points.size())};
+    const std::size_t n_bytes{n_block * m_ply_stride};
+    m_file.read(m_buffer.data(),static_cast<std::streamsize>(n_bytes));
+    if (static_cast<std::size_t>(m_file.gcount()) != n_bytes)
+    {
+      throw std::runtime_error("PlanePointReader: PLY file '" + m_filename + "' has fewer vertices than its header states");
+    }
+    for (std::size_t i=0; i!=n_block; ++i)
+    {
+      const char * const p{m_buffer.data() + (i * m_ply_stride)};
+      points.push_back(
+        Coordinat3D(
+          ToDouble(p + m_ply_offsets[0],m_ply_types[0],m_ply_is_big_endian),
+          ToDouble(p + m_ply_offsets[1],m_ply_types[1],m_ply_is_big_endian),
+          ToDouble(p + m_ply_offsets[2],m_ply_types[2],m_ply_is_big_endian)
+        )
+      );
+    }
+  }
+  m_n_points_read += points.size();
+  return true;
+}
+
+bool ribi::PlanePointReader::ReadXyz(Coordinats3D& points, const std::size_t n)
+{
+  const char * begin{nullptr};
+  const char * end{nullptr};
+  while (points.size() != n && ReadLine(begin,end))
+  {
+    ++m_n_lines_read;
+    while (begin != end && IsSpaceOrTab(*begin)) ++begin;
+    if (begin == end || *begin == '#') continue;
+    double xyz[3] = { 0.0, 0.0, 0.0 };
+    const char * p{begin};
+    for (int i=0; i!=3; ++i)
+    {
+      //Stay within the line: strtod would skip a newline
+      char * next{const_cast<char*>(p)};
+      if (p != end) xyz[i] = std::strtod(p,&next);
+      if (next == p)
+      {
+        std::stringstream msg;
+        msg << "PlanePointReader: cannot read a point from line "
+          << m_n_lines_read << " of file '" << m_filename << "'";
+        throw std::runtime_error(msg.str());
+      }
+      p = next;
+      while (p != end && IsSpaceOrTab(*p)) ++p;
+      if (p != end && *p == ',') ++p;
+      while (p != end && IsSpaceOrTab(*p)) ++p;
+    }
+    points.push_back(Coordinat3D(xyz[0],xyz[1],xyz[2]));
+  }
+  m_n_points_read += points.size();
+  return !points.empty();
+}
+
+double ribi::PlanePointReader::ToDouble(
+  const char * const p,
+  const PlyType type,
+  const bool is_big_endian
+) noexcept
+{
+  char bytes[8];
+  const std::size_t size{GetSize(type)};
+  if (is_big_endian == IsBigEndian())
+  {
+    std::memcpy(bytes,p,size);
+  }
+  else
+  {
+    std::reverse_copy(p,p + size,bytes);
+  }
+  switch (type)
+  {
+    case PlyType::int8: { std::int8_t x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::uint8: { std::uint8_t x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::int16: { std::int16_t x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::uint16: { std::uint16_t x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::int32: { std::int32_t x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::uint32: { std::uint32_t x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::float32: { float x; std::memcpy(&x,bytes,size); return x; }
+    case PlyType::float64: { double x; std::memcpy(&x,bytes,size); return x; }
+  }
+  assert(!"Should not get here");
+  return 0.0;
+}
+
+ribi::PlanePointReader::PlyType ribi::PlanePointReader::ToPlyType(const std::string& s)
+{
+  if (s == "char" || s == "int8") return PlyType::int8;
+  if (s == "uchar" || s == "uint8") return PlyType::uint8;
+  if (s == "short" || s == "int16") return PlyType::int16;
+  if (s == "ushort" || s == "uint16") return PlyType::uint16;
+  if (s == "int" || s == "int32") return PlyType::int32;
+  if (s == "uint" || s == "uint32") return PlyType::uint32;
+  if (s == "float" || s == "float32") return PlyType::float32;
+  if (s == "double" || s == "float64") return PlyType::float64;
+  throw std::runtime_error("PlanePointReader: unknown PLY property type '" + s + "'");
+}
+
+void ribi::ClassifyPointFile(
+  const Plane& plane,
+  PlanePointReader& reader,
+  const std::function<void(const Plane::Coordinats3D&, const std::vector<bool>&)>& f,
+  const std::size_t n_points
+)
+{
+  ProcessPointFile<std::vector<bool>>(
+    reader,
+    n_points,
+    [&plane](const Plane::Coordinats3D& points) { return plane.IsInPlane(points); },
+    f
+  );
+}
+
+void ribi::CalcErrorPointFile(
+  const Plane& plane,
+  PlanePointReader& reader,
+  const std::function<void(const Plane::Coordinats3D&, const Plane::Doubles&)>& f,
+  const std::size_t n_points
+)
+{
+  ProcessPointFile<Plane::Doubles>(
+    reader,
+    n_points,
+    [&plane](const Plane::Coordinats3D& points) { return plane.CalcError(points); },
+    f
+  );
+}
@@ -0,0 +1,127 @@
+#ifndef RIBI_PLANEPOINTREADER_H
+#define RIBI_PLANEPOINTREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "plane.h"
+
+namespace ribi {
+
+///Reads the points of a point file in chunks, so that a file larger than
+///memory can be processed. Supported are:
+/// - ASCII XYZ: one point per line, as 'x y z' followed by anything,
+///   separated by spaces, tabs or commas. Empty lines and lines starting
+///   with '#' are skipped
+/// - binary PLY, little or big endian: the x, y and z properties of the
+///   vertex element, which must be the first element
+///The format is detected from the start of the file: a PLY file starts with 'ply'
+struct PlanePointReader
+{
+  typedef Plane::Coordinat3D Coordinat3D;
+  typedef Plane::Coordinats3D Coordinats3D;
+
+  enum class Format { xyz, ply };
+
+  ///Opens the file and reads its header, if any.
+  ///Throws std::runtime_error if the file cannot be opened
+  ///or has an unsupported PLY header
+  explicit PlanePointReader(const std::string& filename);
+  PlanePointReader(const PlanePointReader&) = delete;
+  PlanePointReader& operator=(const PlanePointReader&) = delete;
+
+  Format GetFormat() const noexcept { return m_format; }
+
+  ///The number of points read so far
+  std::uint64_t GetNumberOfPointsRead() const noexcept { return m_n_points_read; }
+
+  ///Replaces the content of points by the next at most n points.
+  ///Returns false if there are no more points.
+  ///Throws std::runtime_error if the file cannot be parsed
+  bool Read(Coordinats3D& points, const std::size_t n);
+
+  private:
+
+  ///The type of a PLY property
+  enum class PlyType { int8, uint8, int16, uint16, int32, uint32, float32, float64 };
+
+  ///The buffer of unparsed bytes, with one extra byte for a terminating zero
+  std::vector<char> m_buffer;
+
+  ///The index of the first unparsed byte in m_buffer
+  std::size_t m_buffer_begin;
+
+  ///The index after the last unparsed byte in m_buffer
+  std::size_t m_buffer_end;
+
+  std::ifstream m_file;
+
+  const std::string m_filename;
+
+  Format m_format;
+
+  ///The number of lines read by an XYZ file, for error messages
+  std::uint64_t m_n_lines_read;
+
+  std::uint64_t m_n_points_read;
+
+  ///The number of points in a PLY file
+  std::uint64_t m_ply_n_points;
+
+  ///The byte offsets of x, y and z in a PLY vertex
+  std::size_t m_ply_offsets[3];
+
+  ///Is the PLY file big endian?
+  bool m_ply_is_big_endian;
+
+  ///The number of bytes of a PLY vertex
+  std::size_t m_ply_stride;
+
+  ///The types of x, y and z in a PLY vertex
+  PlyType m_ply_types[3];
+
+  ///Read the header of a PLY file
+  void ReadPlyHeader();
+
+  ///Read the next line of an XYZ file in [begin,end), with *end being
+  ///a whitespace or zero. The line excludes a CRLF or LF line ending.
+  ///Returns false if there are no more lines
+  bool ReadLine(const char *& begin, const char *& end);
+
+  bool ReadPly(Coordinats3D& points, const std::size_t n);
+  bool ReadXyz(Coordinats3D& points, const std::size_t n);
+
+  static double ToDouble(const char * const p, const PlyType type, const bool is_big_endian) noexcept;
+  static PlyType ToPlyType(const std::string& s);
+  static std::size_t GetSize(const PlyType type) noexcept;
+};
+
+///Calls the function on each chunk of at most n_points points read
+///by the reader, together with the points being in the plane or not.
+///Reading the next chunk is done in a second thread while the current
+///chunk is classified, so at most two chunks are in memory
+void ClassifyPointFile(
+  const Plane& plane,
+  PlanePointReader& reader,
+  const std::function<void(const Plane::Coordinats3D&, const std::vector<bool>&)>& f,
+  const std::size_t n_points = 1 << 20
+);
+
+///Calls the function on each chunk of at most n_points points read
+///by the reader, together with the errors between plane and points.
+///Reading the next chunk is done in a second thread while the current
+///chunk is processed, so at most two chunks are in memory
+void CalcErrorPointFile(
+  const Plane& plane,
+  PlanePointReader& reader,
+  const std::function<void(const Plane::Coordinats3D&, const Plane::Doubles&)>& f,
+  const std::size_t n_points = 1 << 20
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPOINTREADER_H
@@ -0,0 +1,168 @@
+#include "planepointreader.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planepointreader_xyz)
+{
+  const std::string filename{"ribi_planepointreader_xyz.xyz"};
+  {
+    std::ofstream f(filename.c_str());
+    f << "# x y z\n"
+      << "1 1 10\n"
+      << "\n"
+      << "  3.0\t4.0\t23.0 255 0 0\r\n"
+      << "1.0,2.0,13.0\n"
+      << "3, 4, 24";
+  }
+  PlanePointReader r(filename);
+  BOOST_CHECK(r.GetFormat() == PlanePointReader::Format::xyz);
+  Plane::Coordinats3D points;
+  BOOST_CHECK(r.Read(points,3));
+  BOOST_CHECK_EQUAL(points.size(),3);
+  BOOST_CHECK_EQUAL(boost::geometry::get<2>(points[1]),23.0);
+  BOOST_CHECK(r.Read(points,3));
+  BOOST_CHECK_EQUAL(points.size(),1);
+  BOOST_CHECK_EQUAL(boost::geometry::get<2>(points[0]),24.0);
+  BOOST_CHECK(!r.Read(points,3));
+  BOOST_CHECK(points.empty());
+  BOOST_CHECK_EQUAL(r.GetNumberOfPointsRead(),4);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointreader_xyz_rejects_too_few_values)
+{
+  const std::string filename{"ribi_planepointreader_xyz_rejects.xyz"};
+  {
+    std::ofstream f(filename.c_str());
+    f << "1 2 3\n4 5\n6 7 8\n";
+  }
+  PlanePointReader r(filename);
+  Plane::Coordinats3D points;
+  BOOST_CHECK_THROW(r.Read(points,10),std::runtime_error);
+  std::remove(filename.c_str());
+  //With CRLF line endings, the short line must not take a value of the next
+  {
+    std::ofstream f(filename.c_str(),std::ios::binary);
+    f << "1 2 3\r\n4 5\r\n6 7 8\r\n";
+  }
+  PlanePointReader crlf(filename);
+  BOOST_CHECK_THROW(crlf.Read(points,10),std::runtime_error);
+  std::remove(filename.c_str());
+  BOOST_CHECK_THROW(PlanePointReader("ribi_planepointreader_does_not_exist.xyz"),std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointreader_ply)
+{
+  const std::string filename{"ribi_planepointreader_ply.ply"};
+  {
+    std::ofstream f(filename.c_str(),std::ios::binary);
+    f << "ply\n"
+      << "format binary_big_endian 1.0\n"
+      << "comment written by a test\n"
+      << "element vertex 3\n"
+      << "property double x\n"
+      << "property uchar intensity\n"
+      << "property float y\n"
+      << "property int z\n"
+      << "element face 0\n"
+      << "property list uchar int vertex_indices\n"
+      << "end_header\n";
+    const double xs[3] = { 1.0, 3.0, -1.5 };
+    const float ys[3] = { 1.0f, 4.0f, 0.25f };
+    const std::int32_t zs[3] = { 10, 23, -7 };
+    //Write big endian, whatever this machine is
+    const auto write_big_endian = [&f](const void * const p, const std::size_t size)
+    {
+      char bytes[8];
+      std::memcpy(bytes,p,size);
+      const std::uint16_t one{1};
+      char first_byte{0};
+      std::memcpy(&first_byte,&one,1);
+      if (first_byte == 1) std::reverse(bytes,bytes + size);
+      f.write(bytes,static_cast<std::streamsize>(size));
+    };
+    for (int i=0; i!=3; ++i)
+    {
+      write_big_endian(&xs[i],sizeof(double));
+      f.put(static_cast<char>(255));
+      write_big_endian(&ys[i],sizeof(float));
+      write_big_endian(&zs[i],sizeof(std::int32_t));
+    }
+  }
+  PlanePointReader r(filename);
+  BOOST_CHECK(r.GetFormat() == PlanePointReader::Format::ply);
+  Plane::Coordinats3D points;
+  BOOST_CHECK(r.Read(points,2));
+  BOOST_CHECK_EQUAL(points.size(),2);
+  BOOST_CHECK(r.Read(points,2));
+  BOOST_CHECK_EQUAL(points.size(),1);
+  BOOST_CHECK_EQUAL(boost::geometry::get<0>(points[0]),-1.5);
+  BOOST_CHECK_EQUAL(boost::geometry::get<1>(points[0]),0.25);
+  BOOST_CHECK_EQUAL(boost::geometry::get<2>(points[0]),-7.0);
+  BOOST_CHECK(!r.Read(points,2));
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planepointreader_classify)
+{
+  const std::string filename{"ribi_planepointreader_classify.xyz"};
+  //z = (2*x) + (3*y) + 5
+  const Plane p(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  {
+    std::ofstream f(filename.c_str());
+    //Large enough to be read in more than one block
+    for (int i=0; i!=100000; ++i)
+    {
+      const double x{static_cast<double>(i)};
+      const double y{static_cast<double>(i % 7)};
+      f << x << ' ' << y << ' ' << ((2.0 * x) + (3.0 * y) + 5.0 + (i % 3 == 0 ? 1.0 : 0.0)) << '\n';
+    }
+  }
+  {
+    PlanePointReader r(filename);
+    int n_points{0};
+    int n_in_plane{0};
+    int n_chunks{0};
+    ClassifyPointFile(
+      p,
+      r,
+      [&](const Plane::Coordinats3D& points, const std::vector<bool>& is_in_plane)
+      {
+        BOOST_CHECK(points.size() == is_in_plane.size());
+        BOOST_CHECK(points.size() <= 4096);
+        n_points += static_cast<int>(points.size());
+        n_in_plane += static_cast<int>(std::count(std::begin(is_in_plane),std::end(is_in_plane),true));
+        ++n_chunks;
+      },
+      4096
+    );
+    BOOST_CHECK_EQUAL(n_points,100000);
+    BOOST_CHECK_EQUAL(n_in_plane,66666);
+    BOOST_CHECK_EQUAL(n_chunks,25);
+  }
+  {
+    PlanePointReader r(filename);
+    double max_error{0.0};
+    CalcErrorPointFile(
+      p,
+      r,
+      [&](const Plane::Coordinats3D&, const Plane::Doubles& errors)
+      {
+        max_error = std::max(max_error,*std::max_element(std::begin(errors),std::end(errors)));
+      },
+      10000
+    );
+    //The smallest error of a point 1.0 above the plane is along the Y axis
+    BOOST_CHECK_CLOSE(max_error,1.0 / 3.0,0.001);
+  }
+  std::remove(filename.c_str());
+}
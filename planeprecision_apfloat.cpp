@@ -0,0 +1,79 @@
+#include "planeprecision_apfloat.h"
+
+#include <cassert>
+#include <utility>
+
+namespace ribi {
+
+///The precision of the innermost PlanePrecision of this thread
+static thread_local std::size_t plane_precision = 0;
+
+///The vectors given back by PlaneScratchCoordinats of this thread
+static thread_local std::vector<PlaneScratchCoordinats::Coordinats3D> plane_scratch_pool;
+
+} //~namespace ribi
+
+ribi::PlanePrecision::PlanePrecision(const std::size_t n_digits) noexcept
+  : m_previous{plane_precision}
+{
+  plane_precision = n_digits;
+}
+
+ribi::PlanePrecision::~PlanePrecision() noexcept
+{
+  plane_precision = m_previous;
+}
+
+std::size_t ribi::PlanePrecision::Get() noexcept
+{
+  return plane_precision;
+}
+
+ribi::PlaneScratchCoordinats::PlaneScratchCoordinats() noexcept
+  : m_coordinats{}
+{
+  if (!plane_scratch_pool.empty())
+  {
+    std::swap(m_coordinats,plane_scratch_pool.back());
+    plane_scratch_pool.pop_back();
+  }
+  assert(m_coordinats.empty());
+}
+
+ribi::PlaneScratchCoordinats::~PlaneScratchCoordinats() noexcept
+{
+  m_coordinats.clear();
+  try
+  {
+    plane_scratch_pool.push_back(std::move(m_coordinats));
+  }
+  catch (std::exception&) {} //!OCLINT this is ok, the buffer is just not reused
+}
+
+apfloat ribi::ToPlanePrecision(const apfloat& x)
+{
+  const std::size_t n_digits{PlanePrecision::Get()};
+  if (n_digits == 0 || x.prec() <= n_digits)
+  {
+    return x;
+  }
+  apfloat y(x);
+  y.prec(n_digits);
+  return y;
+}
+
+boost::geometry::model::point<apfloat,3,boost::geometry::cs::cartesian>
+ribi::ToPlanePrecision(
+  const boost::geometry::model::point<apfloat,3,boost::geometry::cs::cartesian>& coordinat
+)
+{
+  if (PlanePrecision::Get() == 0)
+  {
+    return coordinat;
+  }
+  return boost::geometry::model::point<apfloat,3,boost::geometry::cs::cartesian>(
+    ToPlanePrecision(coordinat.get<0>()),
+    ToPlanePrecision(coordinat.get<1>()),
+    ToPlanePrecision(coordinat.get<2>())
+  );
+}
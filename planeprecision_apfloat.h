@@ -0,0 +1,73 @@
+#ifndef RIBI_PLANEPRECISION_H
+#define RIBI_PLANEPRECISION_H
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/geometry.hpp>
+
+#include "apfloat.h"
+
+namespace ribi {
+
+///Sets the precision, in decimal digits, of the apfloat intermediates
+///used by Plane, PlaneX, PlaneY and PlaneZ, for as long as it exists.
+///It only affects the current thread. When it goes out of scope, the
+///previous precision is restored, so PlanePrecisions can be nested.
+///Without a PlanePrecision, intermediates have the precision
+///of the coordinats they are calculated from
+struct PlanePrecision
+{
+  explicit PlanePrecision(const std::size_t n_digits) noexcept;
+  PlanePrecision(const PlanePrecision&) = delete;
+  PlanePrecision& operator=(const PlanePrecision&) = delete;
+  ~PlanePrecision() noexcept;
+
+  ///The precision of the innermost PlanePrecision of this thread,
+  ///zero if there is none
+  static std::size_t Get() noexcept;
+
+  private:
+  const std::size_t m_previous;
+};
+
+///A std::vector of coordinats borrowed from a pool of the current thread.
+///PlaneX::CalcProjection uses it for the coordinats it would otherwise
+///allocate a vector for per call. The apfloat values themselves are still
+///allocated by apfloat. When it goes out of scope, the vector is
+///cleared and given back to the pool, keeping its capacity for the
+///next borrower
+struct PlaneScratchCoordinats
+{
+  typedef boost::geometry::model::point<apfloat,3,boost::geometry::cs::cartesian> Coordinat3D;
+  typedef std::vector<Coordinat3D> Coordinats3D;
+
+  PlaneScratchCoordinats() noexcept;
+  PlaneScratchCoordinats(const PlaneScratchCoordinats&) = delete;
+  PlaneScratchCoordinats& operator=(const PlaneScratchCoordinats&) = delete;
+  ~PlaneScratchCoordinats() noexcept;
+
+  Coordinats3D& Get() noexcept { return m_coordinats; }
+
+  private:
+  Coordinats3D m_coordinats;
+};
+
+///Rounds the apfloat to the precision of the current PlanePrecision.
+///Returns the apfloat unchanged if there is no PlanePrecision,
+///or if its precision is already lower. Returning it is a copy, so
+///callers that can use the apfloat by reference check PlanePrecision::Get()
+///first and only call this if it is non-zero
+apfloat ToPlanePrecision(const apfloat& x);
+
+///Rounds the elements of the coordinat to the precision of the
+///current PlanePrecision. Like the apfloat overload, this copies the
+///coordinat if there is no PlanePrecision
+boost::geometry::model::point<apfloat,3,boost::geometry::cs::cartesian>
+ToPlanePrecision(
+  const boost::geometry::model::point<apfloat,3,boost::geometry::cs::cartesian>& coordinat
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPRECISION_H
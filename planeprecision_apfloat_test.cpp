@@ -0,0 +1,156 @@
+#include "planeprecision_apfloat.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "plane.h"
+
+using namespace ribi;
+
+BOOST_AUTO_TEST_CASE(ribi_planeprecision_nests_and_restores)
+{
+  BOOST_CHECK_EQUAL(PlanePrecision::Get(),0);
+  {
+    const PlanePrecision outer(30);
+    BOOST_CHECK_EQUAL(PlanePrecision::Get(),30);
+    {
+      const PlanePrecision inner(10);
+      BOOST_CHECK_EQUAL(PlanePrecision::Get(),10);
+      {
+        //An inner precision may also be higher
+        const PlanePrecision innermost(50);
+        BOOST_CHECK_EQUAL(PlanePrecision::Get(),50);
+      }
+      BOOST_CHECK_EQUAL(PlanePrecision::Get(),10);
+    }
+    BOOST_CHECK_EQUAL(PlanePrecision::Get(),30);
+  }
+  BOOST_CHECK_EQUAL(PlanePrecision::Get(),0);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeprecision_is_per_thread)
+{
+  const PlanePrecision p(10);
+  std::size_t other_thread_precision{1};
+  std::thread t([&other_thread_precision]() { other_thread_precision = PlanePrecision::Get(); });
+  t.join();
+  BOOST_CHECK_EQUAL(other_thread_precision,0);
+  BOOST_CHECK_EQUAL(PlanePrecision::Get(),10);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeprecision_rounds_only_to_lower_precision)
+{
+  const apfloat x(1.0 / 3.0);
+  const std::size_t n_digits{x.prec()};
+  BOOST_CHECK(n_digits > 10);
+  BOOST_CHECK_EQUAL(ToPlanePrecision(x).prec(),n_digits);
+  {
+    const PlanePrecision p(10);
+    BOOST_CHECK_EQUAL(ToPlanePrecision(x).prec(),10);
+    const PlaneScratchCoordinats::Coordinat3D c(x,x,x);
+    const auto rounded = ToPlanePrecision(c);
+    BOOST_CHECK_EQUAL(rounded.get<0>().prec(),10);
+    BOOST_CHECK_EQUAL(rounded.get<1>().prec(),10);
+    BOOST_CHECK_EQUAL(rounded.get<2>().prec(),10);
+  }
+  {
+    const PlanePrecision p(n_digits + 10);
+    BOOST_CHECK_EQUAL(ToPlanePrecision(x).prec(),n_digits);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planescratchcoordinats_reuses_its_buffer)
+{
+  const PlaneScratchCoordinats::Coordinat3D c(1.0,2.0,3.0);
+  const PlaneScratchCoordinats::Coordinat3D * data{nullptr};
+  std::size_t capacity{0};
+  {
+    PlaneScratchCoordinats scratch;
+    scratch.Get().assign(100,c);
+    data = scratch.Get().data();
+    capacity = scratch.Get().capacity();
+  }
+  {
+    //The next borrower gets the same memory, emptied, so filling it
+    //up to the same size does not allocate
+    PlaneScratchCoordinats scratch;
+    BOOST_CHECK(scratch.Get().empty());
+    BOOST_CHECK_EQUAL(scratch.Get().capacity(),capacity);
+    BOOST_CHECK(scratch.Get().data() == data);
+    scratch.Get().assign(100,c);
+    BOOST_CHECK(scratch.Get().data() == data);
+
+    //A nested borrower gets a buffer of its own
+    PlaneScratchCoordinats nested;
+    BOOST_CHECK(nested.Get().empty());
+    nested.Get().push_back(c);
+    BOOST_CHECK(nested.Get().data() != scratch.Get().data());
+    BOOST_CHECK_EQUAL(scratch.Get().size(),100);
+  }
+}
+
+///The seconds to construct the Plane and calculate the error of each coordinat
+static double TimePlaneCalcError(
+  const Plane::Coordinat3D& p1,
+  const Plane::Coordinat3D& p2,
+  const Plane::Coordinat3D& p3,
+  const Plane::Coordinats3D& coordinats,
+  const int n_repeats,
+  apfloat& sum
+)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i=0; i!=n_repeats; ++i)
+  {
+    const Plane plane(p1,p2,p3);
+    for (const auto& coordinat: coordinats)
+    {
+      sum = sum + plane.CalcError(coordinat) + plane.CalcMaxError(coordinat);
+    }
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeprecision_throughput)
+{
+  //Coordinats of 60 digits, as when apfloat accuracy is needed,
+  //with the intermediates at that precision (before) and at 20 digits (after)
+  typedef Plane::Coordinat3D Coordinat3D;
+  const std::size_t n_digits{60};
+  const Coordinat3D p1(apfloat(1.0,n_digits),apfloat(2.0,n_digits),apfloat(3.0,n_digits));
+  const Coordinat3D p2(apfloat(4.0,n_digits),apfloat(6.0,n_digits),apfloat(9.0,n_digits));
+  const Coordinat3D p3(apfloat(2.0,n_digits),apfloat(9.0,n_digits),apfloat(7.0,n_digits));
+  Plane::Coordinats3D coordinats;
+  for (int i=0; i!=100; ++i)
+  {
+    coordinats.push_back(
+      Coordinat3D(
+        apfloat(0.1 * i,n_digits),
+        apfloat(0.3 * i,n_digits),
+        apfloat(1.0 / (i + 1),n_digits)
+      )
+    );
+  }
+  const int n_repeats{10};
+  apfloat sum_before(0.0);
+  apfloat sum_after(0.0);
+  const double before{TimePlaneCalcError(p1,p2,p3,coordinats,n_repeats,sum_before)};
+  double after{0.0};
+  {
+    const PlanePrecision precision(20);
+    after = TimePlaneCalcError(p1,p2,p3,coordinats,n_repeats,sum_after);
+  }
+  const double n_calls{static_cast<double>(n_repeats * coordinats.size())};
+  BOOST_TEST_MESSAGE(
+    "Plane CalcError and CalcMaxError per second, " << n_digits << " digits: "
+    << (n_calls / before) << ", at PlanePrecision(20): " << (n_calls / after)
+    << ", speedup: " << (before / after)
+  );
+  //Only check the timings were taken: the speedup depends on the machine
+  BOOST_CHECK(before > 0.0);
+  BOOST_CHECK(after > 0.0);
+  BOOST_CHECK(sum_before > apfloat(0.0));
+  BOOST_CHECK(sum_after > apfloat(0.0));
+}
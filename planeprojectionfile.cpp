@@ -0,0 +1,73 @@
+#include "planeprojectionfile.h"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+#include "plane.h"
+#include "planemappedfile.h"
+
+namespace ribi {
+
+///Projects all points of the mapped input to the mapped output,
+///with T being the type of the numbers
+template <class T>
+static void CalcProjectionMapped(
+  const Plane& plane,
+  const PlaneMappedFile& input,
+  PlaneMappedFile& output,
+  const std::size_t n_points
+)
+{
+  const char * in{input.GetData()};
+  char * out{output.GetWritableData()};
+  for (std::size_t i=0; i!=n_points; ++i)
+  {
+    //The mapped data is suitably aligned, memcpy is for strict aliasing
+    T xyz[3];
+    std::memcpy(xyz,in,sizeof(xyz));
+    in += sizeof(xyz);
+    const Plane::Coordinat2D projection{
+      plane.CalcProjection(Plane::Coordinat3D(xyz[0],xyz[1],xyz[2]))
+    };
+    const T xy[2] = {
+      static_cast<T>(boost::geometry::get<0>(projection)),
+      static_cast<T>(boost::geometry::get<1>(projection))
+    };
+    std::memcpy(out,xy,sizeof(xy));
+    out += sizeof(xy);
+  }
+}
+
+} //~namespace ribi
+
+std::size_t ribi::CalcProjectionFile(
+  const Plane& plane,
+  const std::string& input_filename,
+  const std::string& output_filename,
+  const PlanePointFileType type
+)
+{
+  const std::size_t value_size{type == PlanePointFileType::float32 ? sizeof(float) : sizeof(double)};
+  const PlaneMappedFile input(input_filename);
+  if (input.GetSize() % (3 * value_size) != 0)
+  {
+    throw std::runtime_error(
+      "CalcProjectionFile: file '" + input_filename + "' does not contain a whole number of points"
+    );
+  }
+  const std::size_t n_points{input.GetSize() / (3 * value_size)};
+  PlaneMappedFile output(output_filename,n_points * 2 * value_size);
+  input.AdviseSequential();
+  output.AdviseSequential();
+  if (n_points == 0) return 0;
+  if (type == PlanePointFileType::float32)
+  {
+    CalcProjectionMapped<float>(plane,input,output,n_points);
+  }
+  else
+  {
+    CalcProjectionMapped<double>(plane,input,output,n_points);
+  }
+  return n_points;
+}
@@ -0,0 +1,32 @@
+#ifndef RIBI_PLANEPROJECTIONFILE_H
+#define RIBI_PLANEPROJECTIONFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace ribi {
+
+struct Plane;
+
+///The type of the numbers in a packed point file
+enum class PlanePointFileType { float32, float64 };
+
+///Calculates the 2D projection of the points in a packed point file, as
+///done by Plane::CalcProjection, and writes these to a packed point file.
+///The input file contains the X, Y and Z of each point, the output file
+///contains the X and Y of each projected point, both without any header
+///or padding, in the byte order and number type of the machine.
+///Both files are memory-mapped, so no point is copied to a container.
+///Returns the number of points projected.
+///Throws std::runtime_error if a file cannot be read or written,
+///or if the size of the input file is not a whole number of points
+std::size_t CalcProjectionFile(
+  const Plane& plane,
+  const std::string& input_filename,
+  const std::string& output_filename,
+  const PlanePointFileType type
+);
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEPROJECTIONFILE_H
@@ -0,0 +1,90 @@
+#include "planeprojectionfile.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "plane.h"
+#include "planemappedfile.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planeprojectionfile_doubles)
+{
+  const std::string input_filename{"ribi_planeprojectionfile_doubles.bin"};
+  const std::string output_filename{"ribi_planeprojectionfile_doubles_2d.bin"};
+  //z = (2*x) + (3*y) + 5
+  const Plane p(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  const Plane::Coordinats3D points{
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(1.0,2.0,13.0),
+    Coordinat3D(2.0,1.0,12.0),
+    Coordinat3D(-3.0,0.5,0.5)
+  };
+  {
+    std::ofstream f(input_filename.c_str(),std::ios::binary);
+    for (const auto& point: points)
+    {
+      const double xyz[3] = {
+        boost::geometry::get<0>(point),
+        boost::geometry::get<1>(point),
+        boost::geometry::get<2>(point)
+      };
+      f.write(reinterpret_cast<const char*>(xyz),sizeof(xyz));
+    }
+  }
+  BOOST_CHECK_EQUAL(CalcProjectionFile(p,input_filename,output_filename,PlanePointFileType::float64),4);
+  const auto expected = p.CalcProjection(points);
+  {
+    const PlaneMappedFile output(output_filename);
+    BOOST_REQUIRE_EQUAL(output.GetSize(),4 * 2 * sizeof(double));
+    const double * const xys{reinterpret_cast<const double*>(output.GetData())};
+    for (int i=0; i!=4; ++i)
+    {
+      BOOST_CHECK_EQUAL(xys[(2 * i) + 0],boost::geometry::get<0>(expected[i]));
+      BOOST_CHECK_EQUAL(xys[(2 * i) + 1],boost::geometry::get<1>(expected[i]));
+    }
+  }
+  std::remove(input_filename.c_str());
+  std::remove(output_filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeprojectionfile_floats)
+{
+  const std::string input_filename{"ribi_planeprojectionfile_floats.bin"};
+  const std::string output_filename{"ribi_planeprojectionfile_floats_2d.bin"};
+  //The vertical plane x = 1
+  const Plane p(Coordinat3D(1.0,0.0,0.0),Coordinat3D(1.0,1.0,0.0),Coordinat3D(1.0,0.0,1.0));
+  const std::vector<float> xyzs = { 1.0f, 2.0f, 3.0f, 1.0f, -0.5f, 0.25f };
+  {
+    std::ofstream f(input_filename.c_str(),std::ios::binary);
+    f.write(reinterpret_cast<const char*>(xyzs.data()),static_cast<std::streamsize>(xyzs.size() * sizeof(float)));
+  }
+  BOOST_CHECK_EQUAL(CalcProjectionFile(p,input_filename,output_filename,PlanePointFileType::float32),2);
+  {
+    const PlaneMappedFile output(output_filename);
+    BOOST_REQUIRE_EQUAL(output.GetSize(),2 * 2 * sizeof(float));
+    const float * const xys{reinterpret_cast<const float*>(output.GetData())};
+    for (int i=0; i!=2; ++i)
+    {
+      const auto expected = p.CalcProjection(Coordinat3D(xyzs[3 * i],xyzs[(3 * i) + 1],xyzs[(3 * i) + 2]));
+      BOOST_CHECK_EQUAL(xys[(2 * i) + 0],static_cast<float>(boost::geometry::get<0>(expected)));
+      BOOST_CHECK_EQUAL(xys[(2 * i) + 1],static_cast<float>(boost::geometry::get<1>(expected)));
+    }
+  }
+  //Seven floats is not a whole number of points
+  {
+    std::ofstream f(input_filename.c_str(),std::ios::binary | std::ios::app);
+    f.write(reinterpret_cast<const char*>(xyzs.data()),sizeof(float));
+  }
+  BOOST_CHECK_THROW(
+    CalcProjectionFile(p,input_filename,output_filename,PlanePointFileType::float32),
+    std::runtime_error
+  );
+  std::remove(input_filename.c_str());
+  std::remove(output_filename.c_str());
+}
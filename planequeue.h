@@ -0,0 +1,123 @@
+#ifndef RIBI_PLANEQUEUE_H
+#define RIBI_PLANEQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace ribi {
+
+///A bounded multi-producer multi-consumer queue without locks, after
+///Dmitry Vyukov. Each cell has a sequence number telling if it is free
+///for the producer or filled for the consumer of the current lap, so
+///pushing and popping each take a single compare-and-swap.
+///Neither TryPush nor TryPop ever waits: a full or empty queue is
+///reported, leaving it to the caller to retry, wait or give up
+template <class T>
+struct PlaneQueue
+{
+  ///Throws std::invalid_argument if the capacity is not a power of two
+  explicit PlaneQueue(const std::size_t capacity)
+    : m_cells{},
+      m_mask{capacity - 1},
+      m_enqueue_pos{0},
+      m_dequeue_pos{0}
+  {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+    {
+      throw std::invalid_argument("PlaneQueue: capacity must be a power of two of at least two");
+    }
+    m_cells.reset(new Cell[capacity]);
+    for (std::size_t i=0; i!=capacity; ++i)
+    {
+      m_cells[i].m_sequence.store(i,std::memory_order_relaxed);
+    }
+  }
+  PlaneQueue(const PlaneQueue&) = delete;
+  PlaneQueue& operator=(const PlaneQueue&) = delete;
+
+  std::size_t GetCapacity() const noexcept { return m_mask + 1; }
+
+  ///Moves the value into the queue, returns false if the queue is full,
+  ///in which case value is left untouched
+  bool TryPush(T& value)
+  {
+    std::size_t pos{m_enqueue_pos.load(std::memory_order_relaxed)};
+    Cell * cell{nullptr};
+    while (1)
+    {
+      cell = &m_cells[pos & m_mask];
+      const std::size_t sequence{cell->m_sequence.load(std::memory_order_acquire)};
+      const std::ptrdiff_t diff{
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos)
+      };
+      if (diff == 0)
+      {
+        if (m_enqueue_pos.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed)) break;
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->m_value = std::move(value);
+    cell->m_sequence.store(pos + 1,std::memory_order_release);
+    return true;
+  }
+
+  ///Moves the first value out of the queue, returns false if the queue is empty
+  bool TryPop(T& value)
+  {
+    std::size_t pos{m_dequeue_pos.load(std::memory_order_relaxed)};
+    Cell * cell{nullptr};
+    while (1)
+    {
+      cell = &m_cells[pos & m_mask];
+      const std::size_t sequence{cell->m_sequence.load(std::memory_order_acquire)};
+      const std::ptrdiff_t diff{
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1)
+      };
+      if (diff == 0)
+      {
+        if (m_dequeue_pos.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed)) break;
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->m_value);
+    cell->m_sequence.store(pos + m_mask + 1,std::memory_order_release);
+    return true;
+  }
+
+  private:
+
+  struct Cell
+  {
+    std::atomic<std::size_t> m_sequence;
+    T m_value;
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+
+  const std::size_t m_mask;
+
+  ///Producers and consumers each have their own cache line
+  alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+  alignas(64) std::atomic<std::size_t> m_dequeue_pos;
+};
+
+} //~namespace ribi
+
+#endif // RIBI_PLANEQUEUE_H
@@ -0,0 +1,74 @@
+#include "planequeue.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace ribi;
+
+BOOST_AUTO_TEST_CASE(ribi_planequeue_fifo)
+{
+  PlaneQueue<std::vector<int>> q(4);
+  BOOST_CHECK_EQUAL(q.GetCapacity(),4);
+  std::vector<int> v;
+  BOOST_CHECK(!q.TryPop(v));
+  for (int i=0; i!=4; ++i)
+  {
+    v = std::vector<int>(1,i);
+    BOOST_CHECK(q.TryPush(v));
+  }
+  //A full queue leaves the value untouched
+  v = std::vector<int>(1,4);
+  BOOST_CHECK(!q.TryPush(v));
+  BOOST_CHECK(v == std::vector<int>(1,4));
+  for (int i=0; i!=4; ++i)
+  {
+    BOOST_CHECK(q.TryPop(v));
+    BOOST_CHECK(v == std::vector<int>(1,i));
+  }
+  BOOST_CHECK(!q.TryPop(v));
+  BOOST_CHECK_THROW(PlaneQueue<int>(0),std::invalid_argument);
+  BOOST_CHECK_THROW(PlaneQueue<int>(6),std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planequeue_threads)
+{
+  //Every value pushed by two producers is popped exactly once by two consumers
+  PlaneQueue<int> q(8);
+  const int n{100000};
+  std::vector<std::int64_t> sums(2,0);
+  std::vector<std::thread> threads;
+  for (int t=0; t!=2; ++t)
+  {
+    threads.push_back(
+      std::thread(
+        [&q,t]()
+        {
+          for (int i=t; i < n; i += 2)
+          {
+            int value{i};
+            while (!q.TryPush(value)) std::this_thread::yield();
+          }
+        }
+      )
+    );
+    threads.push_back(
+      std::thread(
+        [&q,&sums,t]()
+        {
+          for (int i=0; i != n / 2; ++i)
+          {
+            int value{0};
+            while (!q.TryPop(value)) std::this_thread::yield();
+            sums[t] += value;
+          }
+        }
+      )
+    );
+  }
+  for (auto& thread: threads) thread.join();
+  BOOST_CHECK_EQUAL(sums[0] + sums[1],static_cast<std::int64_t>(n) * (n - 1) / 2);
+}
@@ -0,0 +1,212 @@
+#include "planeresultfile.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ribi {
+
+static const char plane_result_magic[8] = { 'r','i','b','i','p','l','n','r' };
+
+///The number of bytes a block is rounded up to
+static const std::uint64_t plane_result_alignment{64};
+
+///Is this machine little endian?
+static bool IsLittleEndian() noexcept
+{
+  const std::uint16_t one{1};
+  char first_byte{0};
+  std::memcpy(&first_byte,&one,1);
+  return first_byte == 1;
+}
+
+static std::uint64_t RoundUp(const std::uint64_t n) noexcept
+{
+  return ((n + plane_result_alignment - 1) / plane_result_alignment) * plane_result_alignment;
+}
+
+///The most rows a result file can have, so that its size, of at most
+///64 + (25 * n_rows) + (4 * 63) bytes, does not wrap around
+static const std::uint64_t plane_result_max_rows{
+  (std::numeric_limits<std::uint64_t>::max() - sizeof(PlaneResultHeader)) / 32
+};
+
+///Calculate the offsets of the columns u, v, inlier and residual,
+///returns the size of the file. n_rows must be at most plane_result_max_rows
+static std::uint64_t CalcPlaneResultOffsets(
+  const std::uint64_t n_rows,
+  std::uint64_t offsets[4]
+) noexcept
+{
+  assert(n_rows <= plane_result_max_rows);
+  offsets[0] = sizeof(PlaneResultHeader);
+  offsets[1] = offsets[0] + RoundUp(n_rows * sizeof(double));
+  offsets[2] = offsets[1] + RoundUp(n_rows * sizeof(double));
+  offsets[3] = offsets[2] + RoundUp(n_rows * sizeof(std::uint8_t));
+  return offsets[3] + RoundUp(n_rows * sizeof(double));
+}
+
+///The size of a result file.
+///Throws std::runtime_error if there are too many rows
+static std::uint64_t CalcPlaneResultSize(const std::uint64_t n_rows)
+{
+  if (n_rows > plane_result_max_rows)
+  {
+    throw std::runtime_error("PlaneResultWriter: too many rows");
+  }
+  std::uint64_t offsets[4];
+  return CalcPlaneResultOffsets(n_rows,offsets);
+}
+
+///Store an unsigned integer little endian
+template <class T>
+static void StoreLittleEndian(char * const p, T x) noexcept
+{
+  for (std::size_t i=0; i!=sizeof(T); ++i)
+  {
+    p[i] = static_cast<char>(x & 0xff);
+    x = static_cast<T>(x >> 8);
+  }
+}
+
+///Store a double little endian
+static void StoreLittleEndian(char * const p, const double x) noexcept
+{
+  std::uint64_t bits{0};
+  std::memcpy(&bits,&x,sizeof(x));
+  StoreLittleEndian<std::uint64_t>(p,bits);
+}
+
+} //~namespace ribi
+
+ribi::PlaneResultWriter::PlaneResultWriter(
+  const std::string& filename,
+  const std::uint64_t n_rows
+) : m_file(filename,CalcPlaneResultSize(n_rows)),
+    m_n_rows{n_rows}
+{
+  PlaneResultHeader header;
+  std::memset(&header,0,sizeof(header));
+  const std::uint64_t size{CalcPlaneResultOffsets(n_rows,header.m_offsets)};
+  assert(size == m_file.GetSize());
+  (void)size;
+  char * const p{m_file.GetWritableData()};
+  std::memcpy(p,plane_result_magic,sizeof(plane_result_magic));
+  StoreLittleEndian<std::uint32_t>(p + offsetof(PlaneResultHeader,m_version),PlaneResultFile::m_version);
+  StoreLittleEndian<std::uint32_t>(p + offsetof(PlaneResultHeader,m_n_columns),4);
+  StoreLittleEndian<std::uint64_t>(p + offsetof(PlaneResultHeader,m_n_rows),n_rows);
+  for (int i=0; i!=4; ++i)
+  {
+    StoreLittleEndian<std::uint64_t>(
+      p + offsetof(PlaneResultHeader,m_offsets) + (i * sizeof(std::uint64_t)),
+      header.m_offsets[i]
+    );
+  }
+}
+
+void ribi::PlaneResultWriter::CheckRows(const std::uint64_t first_row, const std::size_t n) const
+{
+  if (first_row > m_n_rows || n > m_n_rows - first_row)
+  {
+    throw std::out_of_range("PlaneResultWriter: rows beyond the end of the file");
+  }
+}
+
+char * ribi::PlaneResultWriter::GetColumn(const int column) noexcept
+{
+  assert(column >= 0 && column < 4);
+  std::uint64_t offsets[4];
+  CalcPlaneResultOffsets(m_n_rows,offsets);
+  return m_file.GetWritableData() + offsets[column];
+}
+
+void ribi::PlaneResultWriter::WriteErrors(
+  const std::uint64_t first_row,
+  const std::vector<double>& errors
+)
+{
+  CheckRows(first_row,errors.size());
+  char * p{GetColumn(3) + (first_row * sizeof(double))};
+  for (const double error: errors)
+  {
+    StoreLittleEndian(p,error);
+    p += sizeof(double);
+  }
+}
+
+void ribi::PlaneResultWriter::WriteIsInPlane(
+  const std::uint64_t first_row,
+  const std::vector<bool>& is_in_plane
+)
+{
+  CheckRows(first_row,is_in_plane.size());
+  char * p{GetColumn(2) + first_row};
+  for (const bool b: is_in_plane)
+  {
+    *p++ = b ? 1 : 0;
+  }
+}
+
+void ribi::PlaneResultWriter::WriteProjection(
+  const std::uint64_t first_row,
+  const Coordinats2D& projection
+)
+{
+  CheckRows(first_row,projection.size());
+  char * u{GetColumn(0) + (first_row * sizeof(double))};
+  char * v{GetColumn(1) + (first_row * sizeof(double))};
+  for (const auto& point: projection)
+  {
+    StoreLittleEndian(u,boost::geometry::get<0>(point));
+    StoreLittleEndian(v,boost::geometry::get<1>(point));
+    u += sizeof(double);
+    v += sizeof(double);
+  }
+}
+
+ribi::PlaneResultFile::PlaneResultFile(const std::string& filename)
+  : m_file(filename),
+    m_n_rows{0},
+    m_u{nullptr},
+    m_v{nullptr},
+    m_inlier{nullptr},
+    m_residual{nullptr}
+{
+  if (!IsLittleEndian())
+  {
+    throw std::runtime_error("PlaneResultFile: can only be used on a little endian machine");
+  }
+  if (m_file.GetSize() < sizeof(PlaneResultHeader))
+  {
+    throw std::runtime_error("PlaneResultFile: file '" + filename + "' is too short to be a result file");
+  }
+  PlaneResultHeader header;
+  std::memcpy(&header,m_file.GetData(),sizeof(header));
+  if (std::memcmp(header.m_magic,plane_result_magic,sizeof(plane_result_magic)) != 0)
+  {
+    throw std::runtime_error("PlaneResultFile: file '" + filename + "' is not a result file");
+  }
+  if (header.m_version != m_version || header.m_n_columns != 4)
+  {
+    throw std::runtime_error("PlaneResultFile: file '" + filename + "' has an unsupported version");
+  }
+  if (header.m_n_rows > plane_result_max_rows)
+  {
+    throw std::runtime_error("PlaneResultFile: file '" + filename + "' has an incorrect number of rows");
+  }
+  std::uint64_t offsets[4];
+  const std::uint64_t size{CalcPlaneResultOffsets(header.m_n_rows,offsets)};
+  if (size != m_file.GetSize() || std::memcmp(offsets,header.m_offsets,sizeof(offsets)) != 0)
+  {
+    throw std::runtime_error("PlaneResultFile: file '" + filename + "' has an incorrect size");
+  }
+  //The mapping starts at a page boundary, so all columns are aligned
+  const char * const data{m_file.GetData()};
+  m_n_rows = header.m_n_rows;
+  m_u = reinterpret_cast<const double*>(data + offsets[0]);
+  m_v = reinterpret_cast<const double*>(data + offsets[1]);
+  m_inlier = reinterpret_cast<const std::uint8_t*>(data + offsets[2]);
+  m_residual = reinterpret_cast<const double*>(data + offsets[3]);
+}
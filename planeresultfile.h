@@ -0,0 +1,118 @@
+#ifndef RIBI_PLANERESULTFILE_H
+#define RIBI_PLANERESULTFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include "planemappedfile.h"
+
+namespace ribi {
+
+///The start of a result file. It is followed by the columns, each a
+///contiguous block of one value per row, starting at a multiple of 64 bytes:
+/// - u: double, the X of the 2D projection of the point
+/// - v: double, the Y of the 2D projection of the point
+/// - inlier: std::uint8_t, 1 if the point is in the plane, 0 otherwise
+/// - residual: double, the error between plane and point
+///All values are little endian, so a file can be memory-mapped as is
+///on a little endian machine
+struct PlaneResultHeader
+{
+  ///Always 'ribiplnr'
+  char m_magic[8];
+
+  ///The version of the file format
+  std::uint32_t m_version;
+
+  ///The number of columns, which is four
+  std::uint32_t m_n_columns;
+
+  ///The number of rows of each column
+  std::uint64_t m_n_rows;
+
+  ///The byte offsets from the start of the file of the columns
+  ///u, v, inlier and residual
+  std::uint64_t m_offsets[4];
+
+  ///Unused, keeps the size a multiple of 64
+  std::uint64_t m_padding;
+};
+
+static_assert(sizeof(PlaneResultHeader) == 64,"PlaneResultHeader must have no compiler dependent padding");
+
+///Writes the results of a known number of points to a result file, in any order.
+///The file is created with its final size and memory-mapped, so each
+///Write copies the values straight to their place in their column
+struct PlaneResultWriter
+{
+  typedef boost::geometry::model::d2::point_xy<double> Coordinat2D;
+  typedef std::vector<Coordinat2D> Coordinats2D;
+
+  ///Creates the file, with all values zero.
+  ///Throws std::runtime_error if the file cannot be created or there are too many rows
+  explicit PlaneResultWriter(const std::string& filename, const std::uint64_t n_rows);
+
+  ///The number of rows of each column
+  std::uint64_t GetNumberOfRows() const noexcept { return m_n_rows; }
+
+  ///Write the residuals, as obtained by CalcError, to the rows starting at first_row
+  void WriteErrors(const std::uint64_t first_row, const std::vector<double>& errors);
+
+  ///Write the inliers, as obtained by IsInPlane, to the rows starting at first_row
+  void WriteIsInPlane(const std::uint64_t first_row, const std::vector<bool>& is_in_plane);
+
+  ///Write the u and v, as obtained by CalcProjection, to the rows starting at first_row
+  void WriteProjection(const std::uint64_t first_row, const Coordinats2D& projection);
+
+  private:
+
+  PlaneMappedFile m_file;
+
+  const std::uint64_t m_n_rows;
+
+  ///Throws std::out_of_range if the rows do not fit
+  void CheckRows(const std::uint64_t first_row, const std::size_t n) const;
+
+  ///The start of a column
+  char * GetColumn(const int column) noexcept;
+};
+
+///A result file, memory-mapped for as long as the PlaneResultFile exists.
+///The columns are used as is, without copying or parsing.
+///Only works on a little endian machine
+struct PlaneResultFile
+{
+  ///Memory-maps the file.
+  ///Throws std::runtime_error if the file cannot be opened, is not a
+  ///result file of this version, or this machine is not little endian
+  explicit PlaneResultFile(const std::string& filename);
+
+  ///The number of rows of each column
+  std::uint64_t GetNumberOfRows() const noexcept { return m_n_rows; }
+
+  const double * GetU() const noexcept { return m_u; }
+  const double * GetV() const noexcept { return m_v; }
+  const std::uint8_t * GetInlier() const noexcept { return m_inlier; }
+  const double * GetResidual() const noexcept { return m_residual; }
+
+  ///The version of the file format
+  static constexpr std::uint32_t m_version{1};
+
+  private:
+
+  PlaneMappedFile m_file;
+  std::uint64_t m_n_rows;
+  const double * m_u;
+  const double * m_v;
+  const std::uint8_t * m_inlier;
+  const double * m_residual;
+};
+
+} //~namespace ribi
+
+#endif // RIBI_PLANERESULTFILE_H
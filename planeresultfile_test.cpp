@@ -0,0 +1,85 @@
+#include "planeresultfile.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::Plane::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planeresultfile_write_and_read)
+{
+  const std::string filename{"ribi_planeresultfile_write_and_read.bin"};
+  //z = (2*x) + (3*y) + 5
+  const Plane p(Coordinat3D(1.0,1.0,10.0),Coordinat3D(1.0,2.0,13.0),Coordinat3D(2.0,1.0,12.0));
+  const Plane::Coordinats3D points{
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(1.0,2.0,13.0),
+    Coordinat3D(2.0,1.0,12.0),
+    Coordinat3D(3.0,4.0,24.0),
+    Coordinat3D(3.0,4.0,23.0)
+  };
+  const auto projection = p.CalcProjection(points);
+  const auto is_in_plane = p.IsInPlane(points);
+  const auto errors = p.CalcError(points);
+  {
+    PlaneResultWriter w(filename,points.size());
+    BOOST_CHECK_EQUAL(w.GetNumberOfRows(),5);
+    //Write in two chunks, in any order
+    w.WriteProjection(3,Plane::Coordinats2D(projection.begin() + 3,projection.end()));
+    w.WriteProjection(0,Plane::Coordinats2D(projection.begin(),projection.begin() + 3));
+    w.WriteIsInPlane(0,is_in_plane);
+    w.WriteErrors(0,errors);
+    BOOST_CHECK_THROW(w.WriteErrors(4,errors),std::out_of_range);
+  }
+  const PlaneResultFile f(filename);
+  BOOST_REQUIRE_EQUAL(f.GetNumberOfRows(),5);
+  for (int i=0; i!=5; ++i)
+  {
+    BOOST_CHECK_EQUAL(f.GetU()[i],boost::geometry::get<0>(projection[i]));
+    BOOST_CHECK_EQUAL(f.GetV()[i],boost::geometry::get<1>(projection[i]));
+    BOOST_CHECK_EQUAL(f.GetInlier()[i] == 1,is_in_plane[i]);
+    BOOST_CHECK_EQUAL(f.GetResidual()[i],errors[i]);
+  }
+  BOOST_CHECK_EQUAL(f.GetInlier()[3],0);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(f.GetV()) % 64,0);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeresultfile_empty)
+{
+  const std::string filename{"ribi_planeresultfile_empty.bin"};
+  {
+    const PlaneResultWriter w(filename,0);
+  }
+  BOOST_CHECK_EQUAL(PlaneResultFile(filename).GetNumberOfRows(),0);
+  std::remove(filename.c_str());
+  BOOST_CHECK_THROW(PlaneResultFile("ribi_planeresultfile_does_not_exist.bin"),std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planeresultfile_too_many_rows)
+{
+  //A header of which the column sizes wrap around to zero,
+  //so that the size of the file seems to match
+  const std::string filename{"ribi_planeresultfile_too_many_rows.bin"};
+  {
+    PlaneResultHeader header;
+    std::memset(&header,0,sizeof(header));
+    std::memcpy(header.m_magic,"ribiplnr",8);
+    header.m_version = PlaneResultFile::m_version;
+    header.m_n_columns = 4;
+    header.m_n_rows = std::numeric_limits<std::uint64_t>::max() - 1;
+    for (auto& offset: header.m_offsets) offset = sizeof(header);
+    std::ofstream f(filename,std::ios::binary);
+    f.write(reinterpret_cast<const char*>(&header),sizeof(header));
+  }
+  BOOST_CHECK_THROW(PlaneResultFile{filename},std::runtime_error);
+  std::remove(filename.c_str());
+  BOOST_CHECK_THROW(PlaneResultWriter(filename,std::numeric_limits<std::uint64_t>::max() / 8),std::runtime_error);
+}
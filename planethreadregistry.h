@@ -0,0 +1,78 @@
+#ifndef RIBI_PLANETHREADREGISTRY_H
+#define RIBI_PLANETHREADREGISTRY_H
+
+#include <algorithm>
+#include <cassert>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ribi {
+
+///The thread_local objects of all running threads, for example their
+///counters, and what is kept of them after their threads have exited.
+///Each thread only writes its own object, so that needs no lock.
+///Objects that are read from other threads use relaxed atomics for that:
+///these cost the same as plain values, and make reading them well-defined.
+///The registry itself is only locked when a thread starts or exits,
+///and when all threads are read.
+///Thread is the type of the thread_local object, Exited the type of
+///what is kept of exited threads, which must be default-constructible
+template <class Thread, class Exited>
+struct PlaneThreadRegistry
+{
+  PlaneThreadRegistry(const PlaneThreadRegistry&) = delete;
+  PlaneThreadRegistry& operator=(const PlaneThreadRegistry&) = delete;
+
+  ///The registry of the objects of this type. It is never destroyed,
+  ///as threads may exit after static destruction has started
+  static PlaneThreadRegistry& Get()
+  {
+    static PlaneThreadRegistry * const registry{new PlaneThreadRegistry};
+    return *registry;
+  }
+
+  ///Register the object of a thread, from its constructor.
+  ///Returns the number of objects registered before it
+  int Add(const Thread& thread)
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.push_back(&thread);
+    return m_n_added++;
+  }
+
+  ///Unregister the object of a thread, from its destructor.
+  ///Calls on_exit with what is kept of exited threads, to add the object to it
+  template <class OnExit>
+  void Remove(const Thread& thread, const OnExit& on_exit)
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    on_exit(m_exited);
+    const auto i = std::find(m_threads.begin(),m_threads.end(),&thread);
+    assert(i != m_threads.end());
+    m_threads.erase(i);
+  }
+
+  ///Calls f with what is kept of exited threads and the objects of the
+  ///running threads, and returns what f returns.
+  ///The running threads may write their objects while f reads them
+  template <class Function>
+  auto Read(const Function& f)
+    -> decltype(f(std::declval<const Exited&>(),std::declval<const std::vector<const Thread *>&>()))
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return f(m_exited,m_threads);
+  }
+
+  private:
+  PlaneThreadRegistry() : m_exited{}, m_mutex{}, m_n_added{0}, m_threads{} {}
+
+  Exited m_exited;
+  std::mutex m_mutex;
+  int m_n_added;
+  std::vector<const Thread *> m_threads;
+};
+
+} //~namespace ribi
+
+#endif // RIBI_PLANETHREADREGISTRY_H
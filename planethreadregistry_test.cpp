@@ -0,0 +1,62 @@
+#include "planethreadregistry.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace ribi;
+
+///A thread_local object that counts, for testing PlaneThreadRegistry
+struct PlaneTestThreadCount
+{
+  typedef PlaneThreadRegistry<PlaneTestThreadCount,int> Registry;
+
+  PlaneTestThreadCount() : m_count{0}, m_id{Registry::Get().Add(*this)} {}
+  PlaneTestThreadCount(const PlaneTestThreadCount&) = delete;
+  PlaneTestThreadCount& operator=(const PlaneTestThreadCount&) = delete;
+  ~PlaneTestThreadCount()
+  {
+    Registry::Get().Remove(*this,[this](int& exited) { exited += m_count; });
+  }
+
+  int m_count;
+  const int m_id;
+};
+
+///The total count of the exited and running threads
+static int GetPlaneTestThreadTotal()
+{
+  return PlaneTestThreadCount::Registry::Get().Read(
+    [](const int exited, const std::vector<const PlaneTestThreadCount *>& threads)
+    {
+      int total{exited};
+      for (const PlaneTestThreadCount * const thread: threads) total += thread->m_count;
+      return total;
+    }
+  );
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planethreadregistry)
+{
+  BOOST_CHECK_EQUAL(GetPlaneTestThreadTotal(),0);
+  {
+    PlaneTestThreadCount running;
+    running.m_count = 3;
+    BOOST_CHECK_EQUAL(running.m_id,0);
+    BOOST_CHECK_EQUAL(GetPlaneTestThreadTotal(),3);
+    //What is kept of an exited thread is added to the running threads
+    int id{-1};
+    std::thread t(
+      [&id]()
+      {
+        thread_local PlaneTestThreadCount count;
+        count.m_count = 4;
+        id = count.m_id;
+      }
+    );
+    t.join();
+    BOOST_CHECK_EQUAL(id,1);
+    BOOST_CHECK_EQUAL(GetPlaneTestThreadTotal(),7);
+  }
+  BOOST_CHECK_EQUAL(GetPlaneTestThreadTotal(),7);
+}
@@ -0,0 +1,187 @@
+#ifndef RIBI_PLANETOLERANCE_H
+#define RIBI_PLANETOLERANCE_H
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace ribi {
+
+///Maximum allowed error per binary exponent of the magnitude
+typedef std::array<double,2048> PlaneToleranceTable;
+
+///Creates the table at compile time. For a biased exponent e, the
+///magnitude is less than 2^(e - 1022), so one epsilon of it is less than
+///2^(e - 1074): the table holds n_ulps times that value
+constexpr PlaneToleranceTable CreatePlaneToleranceTable(const double n_ulps) noexcept
+{
+  PlaneToleranceTable t{};
+  double max_error{n_ulps * std::numeric_limits<double>::denorm_min()};
+  for (std::size_t i=0; i!=t.size() - 1; ++i)
+  {
+    t[i] = max_error;
+    max_error *= 2.0;
+  }
+  //Infinity and NaN
+  t[t.size() - 1] = std::numeric_limits<double>::infinity();
+  return t;
+}
+
+///The tolerance model used by PlaneX, PlaneY and PlaneZ to determine if
+///a coordinat is in a plane.
+///
+///A PlaneZ calculates Z as
+///
+///  z = (-A.x - B.y + D) / C
+///
+///In double precision, the rounding error of this calculation (including
+///the rounding of the coefficients A, B, C and D themselves) is bounded
+///by a small number of units in the last place of the magnitude
+///
+///  (|A.x| + |B.y| + |D|) / |C|
+///
+///Instead of measuring this at runtime, the maximum allowed error is looked up
+///from a table that is built at compile time, indexed by the binary
+///exponent of that magnitude.
+struct PlaneTolerance
+{
+  typedef PlaneToleranceTable Table;
+
+  ///The number of units in the last place of the magnitude that are allowed
+  static constexpr double m_n_ulps{8.0};
+
+  ///The number of binary exponents a double can have
+  static constexpr int m_n_exponents{2048};
+
+  ///The maximum allowed error for a calculation of which the summed
+  ///absolute terms have this magnitude. Magnitude must be non-negative
+  static double CalcMaxError(const double magnitude) noexcept
+  {
+    assert(!(magnitude < 0.0));
+    return m_table[GetExponent(magnitude)];
+  }
+
+  ///The table that CalcMaxError looks up its values in
+  static const Table& GetTable() noexcept { return m_table; }
+
+  ///The biased binary exponent of a non-negative double, which is the index
+  ///in the table. Zero and denormalized values have exponent zero
+  static int GetExponent(const double magnitude) noexcept
+  {
+    static_assert(sizeof(double) == sizeof(std::uint64_t),"Assume 64-bit doubles");
+    std::uint64_t bits{0};
+    std::memcpy(&bits,&magnitude,sizeof(bits));
+    return static_cast<int>((bits >> 52) & 0x7ff);
+  }
+
+  private:
+  static constexpr Table m_table{CreatePlaneToleranceTable(m_n_ulps)};
+};
+
+static_assert(
+  CreatePlaneToleranceTable(PlaneTolerance::m_n_ulps)[1023]
+    == PlaneTolerance::m_n_ulps * 2.0 * std::numeric_limits<double>::epsilon(),
+  "A magnitude in [1,2) must have a tolerance of m_n_ulps epsilons of two"
+);
+
+//Tolerance policies, to choose the tolerance rule of IsInPlane at compile time.
+//The rule is inlined in the calculation, so choosing a cheaper rule
+//makes every IsInPlane cheaper. Each policy has a member function
+//
+//  bool IsInTolerance(error, magnitude, c, d) const noexcept
+//
+//where, for a PlaneZ with coefficients A.x + B.y + C.z = D,
+// - error: the absolute difference between the calculated and actual Z
+// - magnitude: |A.x| + |B.y| + |D|, the summed terms of calculating Z
+// - c, d: the coefficients C and D
+
+///The error may be at most a fixed value
+struct AbsoluteTolerance
+{
+  explicit AbsoluteTolerance(const double max_error = 1.0e-9) noexcept
+    : m_max_error{max_error} { assert(max_error >= 0.0); }
+
+  bool IsInTolerance(
+    const double error, const double /* magnitude */,
+    const double /* c */, const double /* d */
+  ) const noexcept
+  {
+    return error <= m_max_error;
+  }
+
+  double m_max_error;
+};
+
+///The error may be at most a fraction of the intercept D/C,
+///as used by PlaneX, PlaneY and PlaneZ up to version 1.6
+struct InterceptTolerance
+{
+  bool IsInTolerance(
+    const double error, const double /* magnitude */,
+    const double c, const double d
+  ) const noexcept
+  {
+    return error <= std::abs(m_max_error_per_intercept * (d / c));
+  }
+
+  ///About 0.000000001, increased by 0.000001%
+  static constexpr double m_max_error_per_intercept{0.000000001 * 1.00000001};
+};
+
+///The error may be at most a few units in the last place of the magnitude,
+///looked up from the PlaneTolerance table. This is the default
+struct UlpTolerance
+{
+  bool IsInTolerance(
+    const double error, const double magnitude,
+    const double c, const double /* d */
+  ) const noexcept
+  {
+    return error <= PlaneTolerance::CalcMaxError(magnitude) / std::abs(c);
+  }
+};
+
+///The calculated value must equal the actual value exactly
+struct ExactTolerance
+{
+  bool IsInTolerance(
+    const double error, const double /* magnitude */,
+    const double /* c */, const double /* d */
+  ) const noexcept
+  {
+    return error == 0.0;
+  }
+};
+
+///The kernel of PlaneX, PlaneY and PlaneZ IsInPlane: is the coordinat (x,y,z)
+///in the plane with coefficients A.x + B.y + C.z = D, which must have
+///a non-zero C. The calculation is identical to PlaneZ::CalcError
+///and PlaneZ::CalcMaxError
+template <class Tolerance>
+inline bool IsInPlaneZ(
+  const double * const coefficients,
+  const double x,
+  const double y,
+  const double z,
+  const Tolerance& tolerance
+) noexcept
+{
+  const double a{coefficients[0]};
+  const double b{coefficients[1]};
+  const double c{coefficients[2]};
+  const double d{coefficients[3]};
+  assert(c != 0.0);
+  const double term1{-a*x};
+  const double term2{-b*y};
+  const double calculated{(term1 + term2 + d) / c};
+  const double error{std::abs(calculated - z)};
+  const double magnitude{std::abs(term1) + std::abs(term2) + std::abs(d)};
+  return tolerance.IsInTolerance(error,magnitude,c,d);
+}
+
+} //~namespace ribi
+
+#endif // RIBI_PLANETOLERANCE_H
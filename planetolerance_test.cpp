@@ -0,0 +1,133 @@
+#include "planetolerance.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include "plane.h"
+
+using namespace ribi;
+using Coordinat3D = ribi::PlaneZ::Coordinat3D;
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_table_is_increasing)
+{
+  const auto& t = PlaneTolerance::GetTable();
+  BOOST_CHECK(t.front() > 0.0);
+  for (int i=1; i!=PlaneTolerance::m_n_exponents; ++i)
+  {
+    BOOST_CHECK(t[i] > t[i-1]);
+  }
+  BOOST_CHECK(std::isinf(t.back()));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_bounds_magnitude)
+{
+  //The tolerance must always be at least m_n_ulps epsilons of the magnitude
+  const double epsilon{std::numeric_limits<double>::epsilon()};
+  for (const double magnitude: { 1.0, 1.5, 1.99999, 3.0, 1.0e-8, 1.0e8, 123.456 })
+  {
+    const double max_error{PlaneTolerance::CalcMaxError(magnitude)};
+    BOOST_CHECK(max_error >= PlaneTolerance::m_n_ulps * epsilon * magnitude);
+    BOOST_CHECK(max_error <= 2.0 * PlaneTolerance::m_n_ulps * epsilon * magnitude);
+  }
+  BOOST_CHECK(PlaneTolerance::CalcMaxError(0.0) > 0.0);
+  BOOST_CHECK(PlaneTolerance::GetExponent(0.0) == 0);
+  BOOST_CHECK(PlaneTolerance::GetExponent(1.0) == 1023);
+  BOOST_CHECK(PlaneTolerance::GetExponent(2.0) == 1024);
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_is_tighter_than_stub)
+{
+  //z = (2*x) + (3*y) + 5
+  const PlaneZ p(
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(1.0,2.0,13.0),
+    Coordinat3D(2.0,1.0,12.0)
+  );
+  const Coordinat3D on(3.0,4.0,23.0);
+  const Coordinat3D near(3.0,4.0,23.0 + 1.0e-12);
+  BOOST_CHECK(p.IsInPlane(on));
+  //The previous tolerance was 1.0e-9 * GetFunctionC(), which would accept this
+  BOOST_CHECK(!p.IsInPlane(near));
+  BOOST_CHECK(p.CalcMaxError(on) < 1.0e-9 * p.GetFunctionC());
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_scales_with_coordinat)
+{
+  //z = (2*x) + (3*y) + 5
+  const PlaneZ p(
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(1.0,2.0,13.0),
+    Coordinat3D(2.0,1.0,12.0)
+  );
+  BOOST_CHECK(
+      p.CalcMaxError(Coordinat3D(1.0e8,1.0e8,5.0e8 + 5.0))
+    > p.CalcMaxError(Coordinat3D(1.0,1.0,10.0))
+  );
+  BOOST_CHECK(p.IsInPlane(Coordinat3D(1.0e8,1.0e8,5.0e8 + 5.0)));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_policies)
+{
+  //z = (2*x) + (3*y) + 5
+  const PlaneZ p(
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(1.0,2.0,13.0),
+    Coordinat3D(2.0,1.0,12.0)
+  );
+  const Coordinat3D on(3.0,4.0,23.0);
+  const Coordinat3D near(3.0,4.0,23.0 + 1.0e-12);
+  const Coordinat3D far(3.0,4.0,23.0 + 1.0e-6);
+  BOOST_CHECK(p.IsInPlane(on,ExactTolerance()));
+  BOOST_CHECK(!p.IsInPlane(near,ExactTolerance()));
+  BOOST_CHECK(p.IsInPlane(near,AbsoluteTolerance(1.0e-9)));
+  BOOST_CHECK(!p.IsInPlane(far,AbsoluteTolerance(1.0e-9)));
+  BOOST_CHECK(p.IsInPlane(far,AbsoluteTolerance(1.0e-3)));
+  BOOST_CHECK(p.IsInPlane(near,InterceptTolerance()));
+  BOOST_CHECK(!p.IsInPlane(far,InterceptTolerance()));
+  BOOST_CHECK(p.IsInPlane(near,UlpTolerance()) == p.IsInPlane(near));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_policies_in_rotated_planes)
+{
+  //The plane x = 1 can only be expressed as a PlaneX
+  const Plane p(
+    Coordinat3D(1.0,0.0,0.0),
+    Coordinat3D(1.0,1.0,0.0),
+    Coordinat3D(1.0,0.0,1.0)
+  );
+  BOOST_CHECK(p.IsInPlane(Coordinat3D(1.0,2.0,3.0),ExactTolerance()));
+  BOOST_CHECK(!p.IsInPlane(Coordinat3D(1.1,2.0,3.0),AbsoluteTolerance(1.0e-9)));
+  //The plane y = 1 can only be expressed as a PlaneY
+  const Plane q(
+    Coordinat3D(0.0,1.0,0.0),
+    Coordinat3D(1.0,1.0,0.0),
+    Coordinat3D(0.0,1.0,1.0)
+  );
+  BOOST_CHECK(q.IsInPlane(Coordinat3D(2.0,1.0,3.0),ExactTolerance()));
+  BOOST_CHECK(!q.IsInPlane(Coordinat3D(2.0,1.1,3.0),AbsoluteTolerance(1.0e-9)));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetolerance_batch_is_in_plane)
+{
+  //z = (2*x) + (3*y) + 5
+  const Plane p(
+    Coordinat3D(1.0,1.0,10.0),
+    Coordinat3D(1.0,2.0,13.0),
+    Coordinat3D(2.0,1.0,12.0)
+  );
+  const std::vector<Coordinat3D> coordinats{
+    Coordinat3D(3.0,4.0,23.0),
+    Coordinat3D(3.0,4.0,23.0 + 1.0e-12),
+    Coordinat3D(3.0,4.0,24.0)
+  };
+  const std::vector<bool> expected{true,false,false};
+  BOOST_CHECK(p.IsInPlane(coordinats) == expected);
+  for (int i=0; i!=static_cast<int>(coordinats.size()); ++i)
+  {
+    BOOST_CHECK(p.IsInPlane(coordinats[i]) == expected[i]);
+  }
+  const std::vector<bool> expected_absolute{true,true,false};
+  BOOST_CHECK(p.IsInPlane(coordinats,AbsoluteTolerance(1.0e-9)) == expected_absolute);
+}
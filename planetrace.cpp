@@ -0,0 +1,157 @@
+#include "planetrace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "planethreadregistry.h"
+
+namespace ribi {
+
+///A trace copied out of a PlaneTraceBuffer
+struct PlaneTraceRecord
+{
+  const char * m_name;
+  std::uint64_t m_start_ns;
+  std::uint64_t m_end_ns;
+  int m_thread_id;
+};
+
+///The traces of exited threads are kept, up to PlaneTraceBuffer::m_capacity
+typedef PlaneThreadRegistry<PlaneTraceBuffer,std::vector<PlaneTraceRecord>> PlaneTraceRegistry;
+
+///Append the traces still in the buffer. If the thread of the buffer may
+///be adding a trace, traces it may have overwritten while copying are
+///removed again. This includes the trace in the slot it may be writing to
+static void CopyPlaneTraces(
+  const PlaneTraceBuffer& buffer,
+  std::vector<PlaneTraceRecord>& v,
+  const bool may_be_adding
+)
+{
+  const std::size_t capacity{PlaneTraceBuffer::m_capacity};
+  const std::uint64_t n_before{buffer.m_n_added.load(std::memory_order_acquire)};
+  const std::uint64_t first{n_before > capacity ? n_before - capacity : 0};
+  const std::size_t size_before{v.size()};
+  for (std::uint64_t i=first; i!=n_before; ++i)
+  {
+    const PlaneTraceEvent& event = buffer.m_events[i % capacity];
+    v.push_back(
+      {
+        event.m_name.load(std::memory_order_relaxed),
+        event.m_start_ns.load(std::memory_order_relaxed),
+        event.m_end_ns.load(std::memory_order_relaxed),
+        buffer.m_thread_id
+      }
+    );
+  }
+  if (!may_be_adding) return;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::uint64_t n_after{buffer.m_n_added.load(std::memory_order_relaxed)};
+  //Trace n_after may be being written, over trace n_after - capacity
+  if (n_after + 1 - first > capacity)
+  {
+    //Traces [first,n_after + 1 - capacity) may have been overwritten
+    const std::uint64_t n_overwritten{std::min(n_after + 1 - capacity - first,n_before - first)};
+    v.erase(
+      v.begin() + static_cast<std::ptrdiff_t>(size_before),
+      v.begin() + static_cast<std::ptrdiff_t>(size_before + n_overwritten)
+    );
+  }
+}
+
+///Write a string as a JSON string
+static void WriteJsonString(std::ostream& os, const char * s)
+{
+  os << '"';
+  for (; *s; ++s)
+  {
+    const char c{*s};
+    if (c == '"' || c == '\\') os << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20) os << ' ';
+    else os << c;
+  }
+  os << '"';
+}
+
+} //~namespace ribi
+
+ribi::PlaneTraceBuffer::PlaneTraceBuffer()
+  : m_events(new PlaneTraceEvent[m_capacity]),
+    m_n_added{0},
+    m_thread_id{PlaneTraceRegistry::Get().Add(*this)}
+{
+}
+
+ribi::PlaneTraceBuffer::~PlaneTraceBuffer()
+{
+  PlaneTraceRegistry::Get().Remove(
+    *this,
+    [this](std::vector<PlaneTraceRecord>& exited)
+    {
+      //This thread is exiting, so it does not add traces while they are copied
+      CopyPlaneTraces(*this,exited,false);
+      //Keep only the most recent traces of exited threads, as threads may come and go
+      if (exited.size() > m_capacity)
+      {
+        exited.erase(exited.begin(),exited.end() - static_cast<std::ptrdiff_t>(m_capacity));
+      }
+    }
+  );
+}
+
+std::uint64_t ribi::GetPlaneTraceTime() noexcept
+{
+  static const auto start = std::chrono::steady_clock::now();
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()
+  );
+}
+
+void ribi::WriteChromeTrace(std::ostream& os)
+{
+  const std::vector<PlaneTraceRecord> records{
+    PlaneTraceRegistry::Get().Read(
+      [](const std::vector<PlaneTraceRecord>& exited, const std::vector<const PlaneTraceBuffer *>& buffers)
+      {
+        std::vector<PlaneTraceRecord> v = exited;
+        for (const PlaneTraceBuffer * const buffer: buffers)
+        {
+          CopyPlaneTraces(*buffer,v,true);
+        }
+        return v;
+      }
+    )
+  };
+  //Complete events, with times in microseconds
+  os << "{\"traceEvents\":[";
+  bool is_first{true};
+  for (const auto& record: records)
+  {
+    os << (is_first ? "\n" : ",\n");
+    is_first = false;
+    os << "{\"name\":";
+    WriteJsonString(os,record.m_name);
+    os
+      << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.m_thread_id
+      << ",\"ts\":" << (record.m_start_ns / 1000) << '.' << (record.m_start_ns / 100 % 10)
+      << ",\"dur\":" << ((record.m_end_ns - record.m_start_ns) / 1000)
+      << '.' << ((record.m_end_ns - record.m_start_ns) / 100 % 10)
+      << '}'
+    ;
+  }
+  os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void ribi::SaveChromeTrace(const std::string& filename)
+{
+  std::ofstream f(filename.c_str());
+  WriteChromeTrace(f);
+  f.close();
+  if (!f)
+  {
+    throw std::runtime_error("SaveChromeTrace: cannot write file '" + filename + "'");
+  }
+}
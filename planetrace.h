@@ -0,0 +1,113 @@
+#ifndef RIBI_PLANETRACE_H
+#define RIBI_PLANETRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace ribi {
+
+///A traced scope: its name and when it started and ended, in nanoseconds
+///since the first trace of the process.
+///The members are atomic, so that exporting can read a buffer while its
+///thread writes it: relaxed atomics cost the same as plain ones
+struct PlaneTraceEvent
+{
+  std::atomic<const char *> m_name;
+  std::atomic<std::uint64_t> m_start_ns;
+  std::atomic<std::uint64_t> m_end_ns;
+};
+
+///The most recent traces of one thread, in a ring buffer of fixed size:
+///when it is full, the oldest traces are overwritten. A thread only
+///writes its own buffer, so adding a trace takes no lock
+struct PlaneTraceBuffer
+{
+  ///The number of traces kept per thread
+  static constexpr std::size_t m_capacity{1 << 16};
+
+  PlaneTraceBuffer();
+  PlaneTraceBuffer(const PlaneTraceBuffer&) = delete;
+  PlaneTraceBuffer& operator=(const PlaneTraceBuffer&) = delete;
+  ///Keeps the traces for exporting after the thread has exited.
+  ///Of all exited threads together, the m_capacity most recent traces are kept
+  ~PlaneTraceBuffer();
+
+  void Add(const char * const name, const std::uint64_t start_ns, const std::uint64_t end_ns) noexcept
+  {
+    const std::uint64_t n{m_n_added.load(std::memory_order_relaxed)};
+    PlaneTraceEvent& event = m_events[n % m_capacity];
+    event.m_name.store(name,std::memory_order_relaxed);
+    event.m_start_ns.store(start_ns,std::memory_order_relaxed);
+    event.m_end_ns.store(end_ns,std::memory_order_relaxed);
+    m_n_added.store(n + 1,std::memory_order_release);
+  }
+
+  std::unique_ptr<PlaneTraceEvent[]> m_events;
+
+  ///The number of traces ever added
+  std::atomic<std::uint64_t> m_n_added;
+
+  ///The number of the thread, in the order of their first trace
+  int m_thread_id;
+};
+
+///The trace buffer of the calling thread
+inline PlaneTraceBuffer& GetPlaneTraceBuffer()
+{
+  thread_local PlaneTraceBuffer buffer;
+  return buffer;
+}
+
+///The nanoseconds since the first trace of the process
+std::uint64_t GetPlaneTraceTime() noexcept;
+
+///Traces the scope it lives in, from its construction to its destruction.
+///Use RIBI_PLANE_TRACE_SCOPE instead, so tracing can be compiled out
+struct PlaneTraceScope
+{
+  ///The name must live as long as the process, for example a string literal
+  explicit PlaneTraceScope(const char * const name) noexcept
+    : m_name{name}, m_start_ns{GetPlaneTraceTime()}
+  {
+  }
+  PlaneTraceScope(const PlaneTraceScope&) = delete;
+  PlaneTraceScope& operator=(const PlaneTraceScope&) = delete;
+  ~PlaneTraceScope() noexcept
+  {
+    GetPlaneTraceBuffer().Add(m_name,m_start_ns,GetPlaneTraceTime());
+  }
+
+  private:
+  const char * const m_name;
+  const std::uint64_t m_start_ns;
+};
+
+///Write the traces of all threads, including exited threads, as Chrome
+///trace_event JSON, that can be viewed in chrome://tracing or Perfetto.
+///Traces being overwritten by a running thread while writing are skipped
+void WriteChromeTrace(std::ostream& os);
+
+///Write the traces as WriteChromeTrace does to a file.
+///Throws std::runtime_error if the file cannot be written
+void SaveChromeTrace(const std::string& filename);
+
+} //~namespace ribi
+
+#define RIBI_PLANE_TRACE_CONCAT_IMPL(a,b) a##b
+#define RIBI_PLANE_TRACE_CONCAT(a,b) RIBI_PLANE_TRACE_CONCAT_IMPL(a,b)
+
+///Trace the rest of the scope, for example RIBI_PLANE_TRACE_SCOPE("CalcPlaneZ").
+///Only done if RIBI_PLANE_TRACE is defined
+#ifdef RIBI_PLANE_TRACE
+#define RIBI_PLANE_TRACE_SCOPE(name) \
+  const ::ribi::PlaneTraceScope RIBI_PLANE_TRACE_CONCAT(ribi_plane_trace_scope_,__LINE__)(name)
+#else
+#define RIBI_PLANE_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // RIBI_PLANETRACE_H
@@ -0,0 +1,62 @@
+#include "planetrace.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace ribi;
+
+///The number of times the text is in the string
+static int CountOccurrences(const std::string& s, const std::string& text)
+{
+  int n{0};
+  for (auto i = s.find(text); i != std::string::npos; i = s.find(text,i + 1)) ++n;
+  return n;
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetrace_chrome_json)
+{
+  {
+    const PlaneTraceScope scope("ribi_planetrace_test_outer");
+    const PlaneTraceScope inner("ribi_planetrace_test_\"inner\"");
+  }
+  //Traces of a thread that has exited are kept
+  std::thread t([]() { const PlaneTraceScope scope("ribi_planetrace_test_thread"); });
+  t.join();
+  std::stringstream s;
+  WriteChromeTrace(s);
+  const std::string json{s.str()};
+  BOOST_CHECK_EQUAL(json.substr(0,15),"{\"traceEvents\":");
+  BOOST_CHECK_EQUAL(CountOccurrences(json,"\"ribi_planetrace_test_outer\""),1);
+  BOOST_CHECK_EQUAL(CountOccurrences(json,"\"ribi_planetrace_test_\\\"inner\\\"\""),1);
+  BOOST_CHECK_EQUAL(CountOccurrences(json,"\"ribi_planetrace_test_thread\""),1);
+  BOOST_CHECK_EQUAL(CountOccurrences(json,"\"ph\":\"X\""),CountOccurrences(json,"\"dur\":"));
+}
+
+BOOST_AUTO_TEST_CASE(ribi_planetrace_ring_buffer)
+{
+  //Only the most recent traces are kept
+  std::thread t(
+    []()
+    {
+      for (std::size_t i=0; i!=PlaneTraceBuffer::m_capacity + 10; ++i)
+      {
+        GetPlaneTraceBuffer().Add(i < 10 ? "ribi_planetrace_test_old" : "ribi_planetrace_test_new",i,i + 1);
+      }
+      std::stringstream s;
+      WriteChromeTrace(s);
+      const std::string json{s.str()};
+      BOOST_CHECK_EQUAL(CountOccurrences(json,"ribi_planetrace_test_old"),0);
+      //The oldest one is not exported either, as the thread might
+      //have been overwriting it
+      BOOST_CHECK_EQUAL(CountOccurrences(json,"ribi_planetrace_test_new"),static_cast<int>(PlaneTraceBuffer::m_capacity) - 1);
+    }
+  );
+  t.join();
+  //Of an exited thread, all traces in its buffer are kept
+  std::stringstream s;
+  WriteChromeTrace(s);
+  BOOST_CHECK_EQUAL(CountOccurrences(s.str(),"ribi_planetrace_test_new"),static_cast<int>(PlaneTraceBuffer::m_capacity));
+}
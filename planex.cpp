@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include "geometry.h"
+#include "planeformat.h"
 #include "planez.h"
 
 ///Create plane X = 0.0
@@ -26,6 +27,12 @@ ribi::PlaneX::PlaneX(
 
 }
 
+ribi::PlaneX::PlaneX(const Doubles& coefficients)
+  : m_plane_z{CreateForPlaneX(coefficients)}
+{
+
+}
+
 double ribi::PlaneX::CalcError(const Coordinat3D& coordinat) const noexcept
 {
   const double x = boost::geometry::get<0>(coordinat);
@@ -37,68 +44,15 @@ double ribi::PlaneX::CalcError(const Coordinat3D& coordinat) const noexcept
   return error;
 }
 
-ribi::PlaneX::Double ribi::CalcMinErrorPerCinPlaneX() noexcept
+std::size_t ribi::PlaneX::CalcMemoryUse() const noexcept
 {
-  //min_error_per_c will be about 0.000000001
-  //stub_value increases this jut a little, by a 0.000001%
-  const double stub_value = 0.000000001 * 1.00000001;
-  #define USE_STUB
-  #ifdef USE_STUB
-  return stub_value;
-  #else //USE_STUB
-  //PlaneX calculates its own tolerance for errors, by measuring it
-  static Double min_error_per_c = 0.0;
-  if (min_error_per_c > 0.0) return min_error_per_c;
-
-  //const double low = std::numeric_limits<double>::denorm_min();
-  //const double high = std::numeric_limits<double>::max();
-  const double low  = 1.0e-16;
-  const double high = 1.0e+16;
-  const double min_x = low;
-  const double max_x = high;
-  const double min_y = low;
-  const double max_y = high;
-  const double min_z = low;
-  const double max_z = high;
-  const double zero(0.0);
-
-  for (double z = min_z; z < max_z; z*=10.0)
-  {
-    for (double y = min_y; y < max_y; y*=10.0)
-    {
-      for (double x = min_x; x < max_x; x*=10.0)
-      //const double x = y;
-      {
-        const Coordinat3D p1(  x,0.0,0.0);
-        const Coordinat3D p2(  x,  y,0.0);
-        const Coordinat3D p3(  x,0.0,z);
-        const PlaneX p(p1,p2,p3);
-        for (const auto& p4: { p1, p2, p3 } )
-        {
-          const auto error = p.CalcError(p4);
-          const auto error_per_c = error / p.GetFunctionC();
-          assert(error_per_c >= zero);
-          if (error_per_c > min_error_per_c)
-          {
-            min_error_per_c = error_per_c;
-          }
-        }
-      }
-    }
-  }
-  assert(min_error_per_c > zero);
-  assert(min_error_per_c < stub_value);
-  assert(min_error_per_c > 0.99 * stub_value);
-  return min_error_per_c;
-  #endif //USE_STUB
+  return sizeof(*this) + (m_plane_z ? m_plane_z->CalcMemoryUse() : 0);
 }
 
-double ribi::PlaneX::CalcMaxError(const Coordinat3D& /*coordinat*/) const noexcept
+double ribi::PlaneX::CalcMaxError(const Coordinat3D& coordinat) const noexcept
 {
-  assert(CalcMinErrorPerCinPlaneX() > double(0.0));
-  const double max_error{std::abs(CalcMinErrorPerCinPlaneX() * GetFunctionC())};
-  assert(max_error >= double(0.0));
-  return max_error;
+  assert(m_plane_z);
+  return m_plane_z->CalcMaxError(RotateInPlaneX(coordinat));
 }
 
 ribi::PlaneX::Coordinats2D ribi::PlaneX::CalcProjection(
@@ -106,11 +60,32 @@ ribi::PlaneX::Coordinats2D ribi::PlaneX::CalcProjection(
 ) const
 {
   assert(m_plane_z);
-  auto v(points);
-  for(auto& i: v) { i = RotateInPlaneX(i); }
+  assert(points.size() >= 3);
+  //Rotate and project each point in turn, so that only the result is allocated
+  Coordinats2D v;
+  v.reserve(points.size());
   try
   {
-    return m_plane_z->CalcProjection(v);
+    for (const auto& point: points)
+    {
+      v.push_back(m_plane_z->CalcProjection(RotateInPlaneX(point)));
+    }
+  }
+  catch (std::logic_error&)
+  {
+    throw std::logic_error("PlaneX::CalcProjection: cannot calculate projection");
+  }
+  return v;
+}
+
+ribi::PlaneX::Coordinat2D ribi::PlaneX::CalcProjection(
+  const Coordinat3D& point
+) const
+{
+  assert(m_plane_z);
+  try
+  {
+    return m_plane_z->CalcProjection(RotateInPlaneX(point));
   }
   catch (std::logic_error&)
   {
@@ -148,6 +123,26 @@ std::unique_ptr<ribi::PlaneZ> ribi::CreateForPlaneX(
   return p;
 }
 
+std::unique_ptr<ribi::PlaneZ> ribi::CreateForPlaneX(
+  const std::vector<double>& coefficients
+)
+{
+  assert(coefficients.size() == 4);
+  //The inverse of the rotation done by GetCoefficients
+  std::unique_ptr<PlaneZ> p(
+    new PlaneZ(
+      {
+        coefficients[1],
+        coefficients[2],
+        coefficients[0],
+        coefficients[3]
+      }
+    )
+  );
+  assert(p);
+  return p;
+}
+
 std::vector<double> ribi::PlaneX::GetCoefficients() const noexcept
 {
   const auto v(m_plane_z->GetCoefficients());
@@ -175,7 +170,7 @@ double ribi::PlaneX::GetFunctionC() const
 
 std::string ribi::PlaneX::GetVersion() const noexcept
 {
-  return "1.6";
+  return "1.12";
 }
 
 std::vector<std::string> ribi::PlaneX::GetVersionHistory() const noexcept
@@ -187,23 +182,19 @@ std::vector<std::string> ribi::PlaneX::GetVersionHistory() const noexcept
     "2014-06-13: version 1.3: shortened time to compile, allow obtaining the constants in function 'x = Ay + Bz + C'",
     "2014-07-03: version 1.4: use of apfloat",
     "2014-07-09: version 1.5: use double in interface only",
-    "2014-07-10: version 1.6: use of apfloat only"
+    "2014-07-10: version 1.6: use of apfloat only",
+    "2026-10-19: version 1.7: maximum error looked up from a table keyed by magnitude",
+    "2026-10-19: version 1.8: tolerance policy of IsInPlane chosen at compile time",
+    "2026-10-19: version 1.9: construction from coefficients",
+    "2026-10-19: version 1.10: projection of a single point",
+    "2026-10-19: version 1.11: ToFunction into a caller buffer, without allocating",
+    "2026-10-19: version 1.12: memory use"
   };
 }
 
 bool ribi::PlaneX::IsInPlane(const Coordinat3D& coordinat) const noexcept
 {
-  try
-  {
-    const double error = CalcError(coordinat);
-    const double max_error = CalcMaxError(coordinat);
-    return error <= max_error;
-  }
-  catch (std::exception& e)
-  {
-    assert(!"Should not get here");
-    return false;
-  }
+  return IsInPlane(coordinat,UlpTolerance());
 }
 
 std::vector<double> ribi::RotateInPlaneX(
@@ -239,6 +230,25 @@ std::string ribi::PlaneX::ToFunction() const
   return s.str();
 }
 
+std::to_chars_result ribi::PlaneX::ToFunction(char * const first, char * const last) const
+{
+  assert(m_plane_z);
+  try
+  {
+    char * p{WriteChars(first,last,"x=(")};
+    p = WriteChars(p,last,m_plane_z->GetFunctionA());
+    p = WriteChars(p,last,"*y) + (");
+    p = WriteChars(p,last,m_plane_z->GetFunctionB());
+    p = WriteChars(p,last,"*z) + ");
+    p = WriteChars(p,last,m_plane_z->GetFunctionC());
+    return ToCharsResult(p,last);
+  }
+  catch (std::logic_error&)
+  {
+    throw std::logic_error("ribi::PlaneX::ToFunction: cannot display function of a horizontal plane");
+  }
+}
+
 std::ostream& ribi::operator<<(std::ostream& os,const PlaneX& planex)
 {
 
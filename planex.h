@@ -1,14 +1,16 @@
 #ifndef RIBI_PLANEX_H
 #define RIBI_PLANEX_H
 
+#include <cassert>
+#include <charconv>
 #include <memory>
 #include <vector>
 
 #include <boost/geometry/geometries/point_xy.hpp>
 
-namespace ribi {
+#include "planez.h"
 
-struct PlaneZ;
+namespace ribi {
 
 ///A 3D plane that can have its X expressed as a function of Y and Z.
 ///Can be constructed from its equation and at least three 3D points
@@ -40,10 +42,18 @@ struct PlaneX
     const Coordinat3D& p3
   );
 
+  ///Construct from its coefficients, as obtained by GetCoefficients.
+  ///Throws if the plane cannot be expressed as a PlaneX
+  explicit PlaneX(const Doubles& coefficients);
+
   Double CalcError(const Coordinat3D& coordinat) const noexcept;
 
   Double CalcMaxError(const Coordinat3D& coordinat) const noexcept;
 
+  ///The bytes used by the PlaneX: sizeof(PlaneX), which is its shallow size,
+  ///plus the heap memory of its PlaneZ
+  std::size_t CalcMemoryUse() const noexcept;
+
   ///Get the 2D projection of these 3D points,
   /*
 
@@ -61,6 +71,10 @@ struct PlaneX
   */
   Coordinats2D CalcProjection(const Coordinats3D& points) const;
 
+  ///Get the 2D projection of a single 3D point, as done by
+  ///CalcProjection for each of a collection of points
+  Coordinat2D CalcProjection(const Coordinat3D& point) const;
+
   ///Throws when cannot calculate X, which is when the plane is horizontal
   Double CalcX(const Double& y, const Double& z) const;
 
@@ -84,9 +98,31 @@ struct PlaneX
   ///Checks if the coordinat is in the plane
   bool IsInPlane(const Coordinat3D& coordinat) const noexcept;
 
+  ///Checks if the coordinat is in the plane, using a tolerance policy
+  ///from planetolerance.h that is chosen at compile time
+  template <class Tolerance>
+  bool IsInPlane(const Coordinat3D& coordinat, const Tolerance& tolerance) const noexcept
+  {
+    assert(m_plane_z);
+    //Rotate the coordinat, as in RotateInPlaneX
+    return IsInPlaneZ(
+      m_plane_z->GetCoefficients().data(),
+      boost::geometry::get<1>(coordinat),
+      boost::geometry::get<2>(coordinat),
+      boost::geometry::get<0>(coordinat),
+      tolerance
+    );
+  }
+
   ///Convert the PlaneX to a x(y,z), e.g 'x=(2*y) + (3*z) + 5' (spaces exactly as shown)
   std::string ToFunction() const;
 
+  ///Convert the PlaneX to a x(y,z) as ToFunction does, without allocating,
+  ///with each number in its shortest notation that reads back to the same value.
+  ///Writes to [first,last) and returns as std::to_chars does: the end of the
+  ///text, or last and std::errc::value_too_large if it does not fit
+  std::to_chars_result ToFunction(char * const first, char * const last) const;
+
   private:
 
   ///A PlaneX is actually a PlaneZ used with its coordinats rotated from (X,Y,Z) to (Z,Y,Y)
@@ -95,9 +131,6 @@ struct PlaneX
   friend std::ostream& operator<<(std::ostream& os,const PlaneX& planex);
 };
 
-///Calculates m_min_error per GetFunctionC()
-double CalcMinErrorPerCinPlaneX() noexcept;
-
 ///Will throw if plane cannot be created
 std::unique_ptr<PlaneZ> CreateForPlaneX(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p1,
@@ -105,6 +138,9 @@ std::unique_ptr<PlaneZ> CreateForPlaneX(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p3
 );
 
+///Will throw if plane cannot be created. The coefficients are
+///those obtained by PlaneX::GetCoefficients
+std::unique_ptr<PlaneZ> CreateForPlaneX(const std::vector<double>& coefficients);
 
 std::vector<double> RotateInPlaneX(const std::vector<double>& coefficients) noexcept;
 
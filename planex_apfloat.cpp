@@ -8,6 +8,7 @@
 
 #include "container.h"
 #include "geometry.h"
+#include "planeprecision_apfloat.h"
 #include "planez.h"
 // 
 
@@ -28,20 +29,27 @@ ribi::PlaneX::PlaneX(
   const Coordinat3D& p1,
   const Coordinat3D& p2,
   const Coordinat3D& p3
-) : m_plane_z{Create(p1,p2,p3)}
+) : m_plane_z{Create(p1,p2,p3)},
+    m_max_error{abs(CalcMinErrorPerC() * m_plane_z->GetFunctionC())}
 {
+  assert(m_max_error >= apfloat(0.0));
 
 }
 
 apfloat ribi::PlaneX::CalcError(const Coordinat3D& coordinat) const noexcept
 {
-  const apfloat x = boost::geometry::get<0>(coordinat);
-  const apfloat y = boost::geometry::get<1>(coordinat);
-  const apfloat z = boost::geometry::get<2>(coordinat);
-  const auto expected = x;
-  const apfloat calculated = CalcX(y,z);
-  const apfloat error = abs(calculated - expected);
-  return error;
+  //Read the coordinat by reference, instead of copying its apfloats
+  const apfloat& x = coordinat.get<0>();
+  const apfloat& y = coordinat.get<1>();
+  const apfloat& z = coordinat.get<2>();
+  if (PlanePrecision::Get() == 0)
+  {
+    return abs(CalcX(y,z) - x);
+  }
+  //Round the expected X like the Y and Z it is calculated from
+  const apfloat expected = ToPlanePrecision(x);
+  const apfloat calculated = CalcX(ToPlanePrecision(y),ToPlanePrecision(z));
+  return abs(calculated - expected);
 }
 
 ribi::PlaneX::Double ribi::PlaneX::CalcMinErrorPerC() noexcept
@@ -114,10 +122,7 @@ ribi::PlaneX::Double ribi::PlaneX::CalcMinErrorPerC() noexcept
 
 apfloat ribi::PlaneX::CalcMaxError(const Coordinat3D& /*coordinat*/) const noexcept
 {
-  assert(CalcMinErrorPerC() > apfloat(0.0));
-  const auto max_error = abs(CalcMinErrorPerC() * GetFunctionC());
-  assert(max_error >= apfloat(0.0));
-  return max_error;
+  return m_max_error;
   /*
   //const apfloat x = boost::geometry::get<0>(coordinat);
   const apfloat y = boost::geometry::get<1>(coordinat);
@@ -151,8 +156,10 @@ ribi::PlaneX::Coordinats2D ribi::PlaneX::CalcProjection(
 ) const
 {
   assert(m_plane_z);
-  auto v(points);
-  for(auto& i: v) { i = Rotate(i); }
+  PlaneScratchCoordinats scratch;
+  auto& v = scratch.Get();
+  v.reserve(points.size());
+  for(const auto& i: points) { v.push_back(Rotate(i)); }
   try
   {
     return m_plane_z->CalcProjection(v);
@@ -183,10 +190,12 @@ std::unique_ptr<ribi::PlaneZ> ribi::PlaneX::Create(
 )
 {
   std::unique_ptr<PlaneZ> p(
-    new PlaneZ(
-      Rotate(p1),
-      Rotate(p2),
-      Rotate(p3)
+    PlanePrecision::Get() == 0
+    ? new PlaneZ(Rotate(p1),Rotate(p2),Rotate(p3))
+    : new PlaneZ(
+      Rotate(ToPlanePrecision(p1)),
+      Rotate(ToPlanePrecision(p2)),
+      Rotate(ToPlanePrecision(p3))
     )
   );
   assert(p);
@@ -220,7 +229,7 @@ apfloat ribi::PlaneX::GetFunctionC() const
 
 std::string ribi::PlaneX::GetVersion() const noexcept
 {
-  return "1.6";
+  return "1.7";
 }
 
 std::vector<std::string> ribi::PlaneX::GetVersionHistory() const noexcept
@@ -232,7 +241,8 @@ std::vector<std::string> ribi::PlaneX::GetVersionHistory() const noexcept
     "2014-06-13: version 1.3: shortened time to compile, allow obtaining the constants in function 'x = Ay + Bz + C'",
     "2014-07-03: version 1.4: use of apfloat",
     "2014-07-09: version 1.5: use double in interface only",
-    "2014-07-10: version 1.6: use of apfloat only"
+    "2014-07-10: version 1.6: use of apfloat only",
+    "2026-10-19: version 1.7: scoped precision, maximum error calculated once"
   };
 }
 
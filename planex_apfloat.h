@@ -98,6 +98,10 @@ struct PlaneX
   ///A PlaneX is actually a PlaneZ used with its coordinats rotated from (X,Y,Z) to (Z,Y,Y)
   const std::unique_ptr<PlaneZ> m_plane_z;
 
+  ///The maximum allowed error does not depend on the coordinat,
+  ///so it is calculated once, at construction
+  const Double m_max_error;
+
   ///Calculates m_min_error per GetFunctionC()
   static Double CalcMinErrorPerC() noexcept;
 
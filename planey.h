@@ -1,14 +1,16 @@
 #ifndef RIBI_PLANEY_H
 #define RIBI_PLANEY_H
 
+#include <cassert>
+#include <charconv>
 #include <vector>
 #include <memory>
 
 #include <boost/geometry/geometries/point_xy.hpp>
 
-namespace ribi {
+#include "planez.h"
 
-struct PlaneZ;
+namespace ribi {
 
 ///A 3D plane that can have its X expressed as a function of Y and Z.
 ///Can be constructed from its equation and at least three 3D points
@@ -41,10 +43,18 @@ struct PlaneY
     const Coordinat3D& p3
   );
 
+  ///Construct from its coefficients, as obtained by GetCoefficients.
+  ///Throws if the plane cannot be expressed as a PlaneY
+  explicit PlaneY(const Doubles& coefficients);
+
   Double CalcError(const Coordinat3D& coordinat) const noexcept;
 
   Double CalcMaxError(const Coordinat3D& coordinat) const noexcept;
 
+  ///The bytes used by the PlaneY: sizeof(PlaneY), which is its shallow size,
+  ///plus the heap memory of its PlaneZ
+  std::size_t CalcMemoryUse() const noexcept;
+
   ///Get the 2D projection of these 3D points,
   /*
 
@@ -62,6 +72,10 @@ struct PlaneY
   */
   Coordinats2D CalcProjection(const Coordinats3D& points) const;
 
+  ///Get the 2D projection of a single 3D point, as done by
+  ///CalcProjection for each of a collection of points
+  Coordinat2D CalcProjection(const Coordinat3D& point) const;
+
   ///Throws when cannot calculate Y, which is when the plane is horizontal
   Double CalcY(const Double& y, const Double& z) const;
 
@@ -85,9 +99,31 @@ struct PlaneY
   ///Checks if the coordinat is in the plane
   bool IsInPlane(const Coordinat3D& coordinat) const noexcept;
 
+  ///Checks if the coordinat is in the plane, using a tolerance policy
+  ///from planetolerance.h that is chosen at compile time
+  template <class Tolerance>
+  bool IsInPlane(const Coordinat3D& coordinat, const Tolerance& tolerance) const noexcept
+  {
+    assert(m_plane_z);
+    //Rotate the coordinat, as in RotateInPlaneY
+    return IsInPlaneZ(
+      m_plane_z->GetCoefficients().data(),
+      boost::geometry::get<0>(coordinat),
+      boost::geometry::get<2>(coordinat),
+      boost::geometry::get<1>(coordinat),
+      tolerance
+    );
+  }
+
   ///Convert the PlaneY to a y(x,z), e.g 'y=(2*x) + (3*z) + 5' (spaces exactly as shown)
   std::string ToFunction() const;
 
+  ///Convert the PlaneY to a y(x,z) as ToFunction does, without allocating,
+  ///with each number in its shortest notation that reads back to the same value.
+  ///Writes to [first,last) and returns as std::to_chars does: the end of the
+  ///text, or last and std::errc::value_too_large if it does not fit
+  std::to_chars_result ToFunction(char * const first, char * const last) const;
+
   private:
 
   ///A PlaneY is actually a PlaneZ used with its coordinats rotated from (X,Y,Z) to (Z,Y,Y)
@@ -96,15 +132,16 @@ struct PlaneY
   friend std::ostream& operator<<(std::ostream& os,const PlaneY& planey);
 };
 
-///Calculates m_min_error per GetFunctionC()
-double CalcMinErrorPerCinPlaneY() noexcept;
-
 std::unique_ptr<PlaneZ> CreateForPlaneY(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p1,
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p2,
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p3
 );
 
+///Will throw if plane cannot be created. The coefficients are
+///those obtained by PlaneY::GetCoefficients
+std::unique_ptr<PlaneZ> CreateForPlaneY(const std::vector<double>& coefficients);
+
 std::vector<double> RotateInPlaneY(const std::vector<double>& coefficients) noexcept;
 
 boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>
@@ -8,6 +8,9 @@
 #include <stdexcept>
 
 #include "geometry.h"
+#include "planeformat.h"
+#include "planetolerance.h"
+#include "planetrace.h"
 // 
 
 
@@ -72,66 +75,24 @@ double ribi::PlaneZ::CalcError(const Coordinat3D& coordinat) const noexcept
   return error;
 }
 
-ribi::PlaneZ::Double ribi::CalcMinErrorPerCinPlaneZ() noexcept
+std::size_t ribi::PlaneZ::CalcMemoryUse() const noexcept
 {
-  //min_error_per_c will be about 0.000000001
-  //stub_value increases this jut a little, by a 0.000001%
-  const double stub_value = 0.000000001 * 1.00000001;
-  #define USE_STUB
-  #ifdef USE_STUB
-  return stub_value;
-  #else //USE_STUB
-  //PlaneZ calculates its own tolerance for errors, by measuring it
-  static Double min_error_per_c = 0.0;
-  if (min_error_per_c > 0.0) return min_error_per_c;
-
-  //const double low = std::numeric_limits<double>::denorm_min();
-  //const double high = std::numeric_limits<double>::max();
-  const double low  = 1.0e-16;
-  const double high = 1.0e+16;
-  const double min_x = low;
-  const double max_x = high;
-  const double min_y = low;
-  const double max_y = high;
-  const double min_z = low;
-  const double max_z = high;
-  const double zero(0.0);
-
-  for (double z = min_z; z < max_z; z*=10.0)
-  {
-    for (double y = min_y; y < max_y; y*=10.0)
-    {
-      for (double x = min_x; x < max_x; x*=10.0)
-      {
-        const Coordinat3D p1(0.0,0.0,z);
-        const Coordinat3D p2(0.0,  y,z);
-        const Coordinat3D p3(  x,0.0,z);
-        const PlaneZ p(p1,p2,p3);
-        for (const auto& p4: { p1,p2,p3 } )
-        {
-          const auto error = p.CalcError(p4);
-          const auto error_per_c = error / p.GetFunctionC();
-          assert(error_per_c >= zero);
-          if (error_per_c > min_error_per_c)
-          {
-            min_error_per_c = error_per_c;
-          }
-        }
-      }
-    }
-  }
-  assert(min_error_per_c > zero);
-  assert(min_error_per_c < stub_value);
-  assert(min_error_per_c > 0.99 * stub_value);
-  return min_error_per_c;
-  #endif // USE_STUB
+  return sizeof(*this) + (m_coefficients.capacity() * sizeof(Double));
 }
 
-double ribi::PlaneZ::CalcMaxError(const Coordinat3D& /*coordinat*/) const noexcept
+double ribi::PlaneZ::CalcMaxError(const Coordinat3D& coordinat) const noexcept
 {
-  assert(CalcMinErrorPerCinPlaneZ() > double(0.0));
-  const double max_error{std::abs(CalcMinErrorPerCinPlaneZ() * GetFunctionC())};
-  assert(max_error >= double(0.0));
+  //z = (-A.x - B.y + D) / C
+  const double x = boost::geometry::get<0>(coordinat);
+  const double y = boost::geometry::get<1>(coordinat);
+  const auto a = m_coefficients[0];
+  const auto b = m_coefficients[1];
+  const auto c = m_coefficients[2];
+  const auto d = m_coefficients[3];
+  assert(c != 0.0);
+  const double magnitude{std::abs(a*x) + std::abs(b*y) + std::abs(d)};
+  const double max_error{PlaneTolerance::CalcMaxError(magnitude) / std::abs(c)};
+  assert(max_error >= 0.0);
   return max_error;
 }
 
@@ -141,7 +102,7 @@ std::vector<double> ribi::CalcPlaneZ(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p3
 ) noexcept
 {
-  
+  RIBI_PLANE_TRACE_SCOPE("CalcPlaneZ");
   const auto v(
     Geometry().CalcPlane(
       p1,
@@ -158,35 +119,49 @@ ribi::PlaneZ::Coordinats2D ribi::PlaneZ::CalcProjection(
 ) const
 {
   assert(points.size() >= 3);
-  const double x_origin = 0.0;
-  const double y_origin = 0.0;
-  const double z_origin = CalcZ(x_origin,y_origin);
-
+  const double z_origin = CalcZ(0.0,0.0);
   Coordinats2D v;
+  v.reserve(points.size());
   for (const auto& point: points)
   {
-    const Double x(boost::geometry::get<0>(point));
-    const Double y(boost::geometry::get<1>(point));
-    const Double z(boost::geometry::get<2>(point));
-    const Double dx =
-      sqrt( //Apfloat does not add the std::
-          ((x - x_origin) * (x - x_origin))
-        + ((z - z_origin) * (z - z_origin))
-      ) * (x - x_origin)
-    ;
-    const Double dy =
-      sqrt( //Apfloat does not add the std::
-          ((y - y_origin) * (y - y_origin))
-        + ((z - z_origin) * (z - z_origin))
-      ) * (y - y_origin)
-    ;
-
-    Coordinat2D point_xy(dx,dy);
-    v.push_back(point_xy);
+    v.push_back(CalcProjection(point,z_origin));
   }
   return v;
 }
 
+ribi::PlaneZ::Coordinat2D ribi::PlaneZ::CalcProjection(
+  const Coordinat3D& point
+) const
+{
+  return CalcProjection(point,CalcZ(0.0,0.0));
+}
+
+ribi::PlaneZ::Coordinat2D ribi::PlaneZ::CalcProjection(
+  const Coordinat3D& point,
+  const double z_origin
+) const noexcept
+{
+  const double x_origin = 0.0;
+  const double y_origin = 0.0;
+
+  const Double x(boost::geometry::get<0>(point));
+  const Double y(boost::geometry::get<1>(point));
+  const Double z(boost::geometry::get<2>(point));
+  const Double dx =
+    sqrt( //Apfloat does not add the std::
+        ((x - x_origin) * (x - x_origin))
+      + ((z - z_origin) * (z - z_origin))
+    ) * (x - x_origin)
+  ;
+  const Double dy =
+    sqrt( //Apfloat does not add the std::
+        ((y - y_origin) * (y - y_origin))
+      + ((z - z_origin) * (z - z_origin))
+    ) * (y - y_origin)
+  ;
+  return Coordinat2D(dx,dy);
+}
+
 ribi::PlaneZ::Double ribi::PlaneZ::CalcZ(const Double& x, const Double& y) const
 {
   // z = -A/C.x - B/C.y + D/C = (-A.x - B.y + D) / C
@@ -211,8 +186,7 @@ double ribi::PlaneZ::GetFunctionA() const
   // const bool verbose{false};
   const auto coeff_a = m_coefficients[0];
   const auto coeff_c = m_coefficients[2];
-  static const double zero(0.0);
-  assert(coeff_c != zero);
+  assert(coeff_c != 0.0);
   const auto a = -coeff_a/coeff_c;
   return a;
 }
@@ -221,8 +195,7 @@ double ribi::PlaneZ::GetFunctionB() const
 {
   const auto coeff_b = m_coefficients[1];
   const auto coeff_c = m_coefficients[2];
-  static const double zero(0.0);
-  assert(coeff_c != zero);
+  assert(coeff_c != 0.0);
   const auto b = -coeff_b/coeff_c;
   return b;
 }
@@ -231,8 +204,7 @@ double ribi::PlaneZ::GetFunctionC() const
 {
   const auto coeff_c = m_coefficients[2];
   const auto coeff_d = m_coefficients[3];
-  static const double zero(0.0);
-  assert(coeff_c != zero);
+  assert(coeff_c != 0.0);
 
   try
   {
@@ -268,7 +240,7 @@ std::vector<double> ribi::GetTestSeries() noexcept
 
 std::string ribi::PlaneZ::GetVersion() const noexcept
 {
-  return "1.6";
+  return "1.11";
 }
 
 std::vector<std::string> ribi::PlaneZ::GetVersionHistory() const noexcept
@@ -280,23 +252,18 @@ std::vector<std::string> ribi::PlaneZ::GetVersionHistory() const noexcept
     "2014-04-01: version 1.3: use of std::unique_ptr",
     "2014-07-03: version 1.4: use of apfloat",
     "2014-07-09: version 1.5: use double in interface only"
-    "2014-07-10: version 1.6: use of apfloat only"
+    "2014-07-10: version 1.6: use of apfloat only",
+    "2026-10-19: version 1.7: maximum error looked up from a table keyed by magnitude",
+    "2026-10-19: version 1.8: tolerance policy of IsInPlane chosen at compile time",
+    "2026-10-19: version 1.9: projection of a single point",
+    "2026-10-19: version 1.10: ToFunction into a caller buffer, without allocating",
+    "2026-10-19: version 1.11: memory use"
   };
 }
 
 bool ribi::PlaneZ::IsInPlane(const Coordinat3D& coordinat) const noexcept
 {
-  try
-  {
-    const double error = CalcError(coordinat);
-    const double max_error = CalcMaxError(coordinat);
-    return error <= max_error;
-  }
-  catch (std::exception& e)
-  {
-    assert(!"Should not get here");
-    return false;
-  }
+  return IsInPlane(coordinat,UlpTolerance());
 }
 
 std::string ribi::PlaneZ::ToFunction() const
@@ -306,6 +273,24 @@ std::string ribi::PlaneZ::ToFunction() const
   return s.str();
 }
 
+std::to_chars_result ribi::PlaneZ::ToFunction(char * const first, char * const last) const
+{
+  try
+  {
+    char * p{WriteChars(first,last,"z=(")};
+    p = WriteChars(p,last,GetFunctionA());
+    p = WriteChars(p,last,"*x) + (");
+    p = WriteChars(p,last,GetFunctionB());
+    p = WriteChars(p,last,"*y) + ");
+    p = WriteChars(p,last,GetFunctionC());
+    return ToCharsResult(p,last);
+  }
+  catch (std::logic_error&)
+  {
+    throw std::logic_error("ribi::PlaneZ::ToFunction: cannot calculate Z of a vertical plane");
+  }
+}
+
 std::ostream& ribi::operator<<(std::ostream& os, const PlaneZ& planez)
 {
   try
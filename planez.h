@@ -1,6 +1,7 @@
 #ifndef RIBI_PLANEZ_H
 #define RIBI_PLANEZ_H
 
+#include <charconv>
 #include <vector>
 
 
@@ -12,6 +13,7 @@
 #include <boost/geometry/geometries/polygon.hpp>
 #endif
 
+#include "planetolerance.h"
 
 namespace ribi {
 
@@ -73,9 +75,17 @@ struct PlaneZ
   */
   Coordinats2D CalcProjection(const Coordinats3D& points) const;
 
+  ///Get the 2D projection of a single 3D point, as done by
+  ///CalcProjection for each of a collection of points
+  Coordinat2D CalcProjection(const Coordinat3D& point) const;
+
   ///Calculates the maximum allowed error for that coordinat for it to be in the plane
   Double CalcMaxError(const Coordinat3D& coordinat) const noexcept;
 
+  ///The bytes used by the PlaneZ: sizeof(PlaneZ), which is its shallow size,
+  ///plus the heap memory of its coefficients
+  std::size_t CalcMemoryUse() const noexcept;
+
   ///Throws when cannot calculate Z, which is when the plane is vertical
   Double CalcZ(const Double& x, const Double& y) const;
 
@@ -99,20 +109,41 @@ struct PlaneZ
   ///Checks if the coordinat is in the plane
   bool IsInPlane(const Coordinat3D& coordinat) const noexcept;
 
+  ///Checks if the coordinat is in the plane, using a tolerance policy
+  ///from planetolerance.h that is chosen at compile time
+  template <class Tolerance>
+  bool IsInPlane(const Coordinat3D& coordinat, const Tolerance& tolerance) const noexcept
+  {
+    return IsInPlaneZ(
+      m_coefficients.data(),
+      boost::geometry::get<0>(coordinat),
+      boost::geometry::get<1>(coordinat),
+      boost::geometry::get<2>(coordinat),
+      tolerance
+    );
+  }
+
   ///Convert the Plane to function z(x,y), e.g
   ///'z=(2*x) + (3*y) + 5' (spaces exactly as shown)
   ///Where 2,3 and 5 can be obtained with GetFunctionA,GetFunctionB and GetFunctionC
   ///respectively
   std::string ToFunction() const;
 
+  ///Convert the PlaneZ to a z(x,y) as ToFunction does, without allocating,
+  ///with each number in its shortest notation that reads back to the same value.
+  ///Writes to [first,last) and returns as std::to_chars does: the end of the
+  ///text, or last and std::errc::value_too_large if it does not fit
+  std::to_chars_result ToFunction(char * const first, char * const last) const;
+
   private:
 
   //m_coefficients.size == 4
   Doubles m_coefficients;
-};
 
-///Calculates m_min_error per GetFunctionC() to PlaneZ
-double CalcMinErrorPerCinPlaneZ() noexcept;
+  ///The projection of a single point, with z_origin being CalcZ(0.0,0.0),
+  ///so that CalcProjection of a collection calculates it once
+  Coordinat2D CalcProjection(const Coordinat3D& point, const double z_origin) const noexcept;
+};
 
 std::vector<double> CalcPlaneZ(
   const boost::geometry::model::point<double,3,boost::geometry::cs::cartesian>& p1,